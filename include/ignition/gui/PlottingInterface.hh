@@ -21,6 +21,8 @@
 #include <QString>
 #include <QMap>
 #include <QVariant>
+#include <QStringList>
+#include <QVector>
 #ifdef _MSC_VER
 #pragma warning(push, 0)
 #endif
@@ -34,14 +36,150 @@
 #include <string>
 #include <memory>
 #include <limits>
+#include <vector>
 
 #include "ignition/gui/Export.hh"
+#include "ignition/gui/SeriesExpression.hh"
 
 namespace ignition
 {
 namespace gui
 {
 class PlotDataPrivate;
+class PlottingClockPrivate;
+class RecordedSeries;
+class SeriesStats;
+class TimeSeries;
+
+/// \brief Time base of the plotted samples
+enum class PlottingTimeSource
+{
+  /// \brief Monotonic wall clock time since the plotting started, for all
+  /// the messages
+  WALL,
+
+  /// \brief Latest simulation time received on the sim time topic, for all
+  /// the messages
+  SIM,
+
+  /// \brief Header stamp of the messages, and wall clock time for the
+  /// messages without header
+  HEADER
+};
+
+/// \brief Clock giving the time of the plotted samples, read on demand
+/// when messages arrive. It can be read from any thread.
+class IGNITION_GUI_VISIBLE PlottingClock
+{
+  /// \brief Constructor, starts the wall clock time at 0
+  public: PlottingClock();
+
+  /// \brief Destructor
+  public: ~PlottingClock();
+
+  /// \brief Set the time source. Defaults to HEADER.
+  /// \param[in] _source Time source
+  public: void SetSource(PlottingTimeSource _source);
+
+  /// \brief Get the time source
+  /// \return Time source
+  public: PlottingTimeSource Source() const;
+
+  /// \brief Restart the wall clock time at 0
+  public: void Reset();
+
+  /// \brief Get the time elapsed since the construction or the last reset,
+  /// from a monotonic clock
+  /// \return Wall clock time in seconds
+  public: double WallTime() const;
+
+  /// \brief Set the latest simulation time
+  /// \param[in] _time Simulation time in seconds
+  public: void SetSimTime(double _time);
+
+  /// \brief Get the latest simulation time, 0 until it's set
+  /// \return Simulation time in seconds
+  public: double SimTime() const;
+
+  /// \brief Get the time of a sample which doesn't use its message header,
+  /// the wall clock time or the simulation time depending on the source
+  /// \return Time in seconds
+  public: double Now() const;
+
+  /// \brief Private data pointer
+  private: std::unique_ptr<PlottingClockPrivate> dataPtr;
+};
+
+/// \brief How the samples of a plotted field are captured
+enum class SamplingMode
+{
+  /// \brief Keep all the samples
+  ALL,
+
+  /// \brief Keep at most one sample per period
+  DECIMATE,
+
+  /// \brief Keep the sample with the min value of each period
+  MIN,
+
+  /// \brief Keep the sample with the max value of each period
+  MAX,
+
+  /// \brief Keep the mean value of each period, at the period start time
+  MEAN
+};
+
+/// \brief Sampling policy of a plotted field
+class IGNITION_GUI_VISIBLE SamplingPolicy
+{
+  /// \brief Sampling mode
+  public: SamplingMode mode = SamplingMode::ALL;
+
+  /// \brief Sampling rate in Hz, used by all the modes but ALL.
+  /// Non-positive rates keep all the samples.
+  public: double rate = 0;
+};
+
+/// \brief Condition of the trigger of a plot capture
+enum class TriggerCondition
+{
+  /// \brief The value crosses the threshold upwards
+  RISING,
+
+  /// \brief The value crosses the threshold downwards
+  FALLING,
+
+  /// \brief The value is at or above the threshold
+  LEVEL
+};
+
+/// \brief Trigger of an oscilloscope-like capture of the plotted series.
+/// When the condition is met by a sample of the trigger field, the samples
+/// of all the series from preTime before to postTime after the sample are
+/// captured and drawn, instead of scrolling the live samples.
+class IGNITION_GUI_VISIBLE CaptureTrigger
+{
+  /// \brief Field path ID of the series evaluated by the condition, e.g.
+  /// "/imu-linear_acceleration-x"
+  public: std::string fieldID;
+
+  /// \brief Trigger condition
+  public: TriggerCondition condition = TriggerCondition::RISING;
+
+  /// \brief Threshold of the condition
+  public: double threshold = 0;
+
+  /// \brief Captured duration before the trigger in seconds, limited by
+  /// the series capacity
+  public: double preTime = 1;
+
+  /// \brief Captured duration after the trigger in seconds
+  public: double postTime = 1;
+
+  /// \brief True to stop after one capture until the trigger is re-armed,
+  /// false to re-arm it after each capture
+  public: bool singleShot = false;
+};
 
 /// \brief Plot Data containter to hold value and registered charts
 /// Can be a Field or a PlotComponent
@@ -106,7 +244,12 @@ class IGNITION_GUI_VISIBLE Topic : public QObject
   /// \return Topic name
   public: std::string &Name() const;
 
-  /// \brief Register a chart to a field
+  /// \brief Register a chart to a field.
+  /// Repeated fields need an index, e.g. "pose[3]-position-x", or a
+  /// wildcard, e.g. "data[*]", to plot each element as a series with the
+  /// element index in place of the wildcard.
+  /// Should be called from the GUI thread, like all the functions but
+  /// Callback and HasHeader.
   /// \param[in] _fieldPath model path to the field as an ID
   /// \param[in] _chart Chart ID
   public: void Register(const std::string &_fieldPath, int _chart);
@@ -120,11 +263,28 @@ class IGNITION_GUI_VISIBLE Topic : public QObject
   /// \return fields size
   public: int FieldCount() const;
 
-  /// \brief Get the registered fields
+  /// \brief Get the ID of a registered field, which indexes the flat
+  /// array of the topic fields. It stays valid until the field is
+  /// unregistered, then may be reused by another field.
+  /// \param[in] _fieldPath model path to the field as an ID
+  /// \return Field ID, -1 if the field isn't registered
+  public: int FieldId(const std::string &_fieldPath) const;
+
+  /// \brief Get the plot data of a registered field
+  /// \param[in] _id Field ID
+  /// \return Plot data, null if the ID isn't registered
+  public: PlotData *FieldById(int _id);
+
+  /// \brief Get the registered fields. The map is rebuilt on each call, use
+  /// FieldId and FieldById for frequent lookups.
   /// \return Map of fields to their plots
   public: std::map<std::string, PlotData *> &Fields();
 
-  /// \brief Callback to receive messages
+  /// \brief Callback to receive messages.
+  /// Runs on a transport thread, concurrently with the GUI thread, and
+  /// doesn't block it: it reads the latest registered fields snapshot and
+  /// queues the samples without locking the GUI thread out. Concurrent
+  /// calls, from several transport threads, are serialized.
   /// \param[in] _msg the published msg from the topic
   public: void Callback(const google::protobuf::Message &_msg);
 
@@ -138,6 +298,11 @@ class IGNITION_GUI_VISIBLE Topic : public QObject
   /// \param[in] _field field path or ID
   public: void UpdateGui(const std::string &_field);
 
+  /// \brief Send the samples buffered since the last flush to the charts,
+  /// emitting one seriesPoints signal per field for all its charts.
+  /// Should be called from the GUI thread.
+  public: void Flush();
+
   /// \brief update the GUI and plot the topic's fields values
   /// \param[in] _chart chart ID
   /// \param[in] _fieldID field path ID
@@ -145,10 +310,40 @@ class IGNITION_GUI_VISIBLE Topic : public QObject
   /// \param[in] _y y coordinates of the plot point
   signals: void plot(int _chart, QString _fieldID, double _x, double _y);
 
+  /// \brief Plot the samples of a field buffered since the last flush
+  /// \param[in] _charts IDs of the charts plotting the field
+  /// \param[in] _fieldID field path ID
+  /// \param[in] _x x coordinates of the plot points
+  /// \param[in] _y y coordinates of the plot points
+  signals: void seriesPoints(QVector<int> _charts, QString _fieldID,
+                             QVector<double> _x, QVector<double> _y);
+
   /// \brief update the current time with the default time of the plotting timer
   /// \param[in] _time current time of the plotting timer
   public: void SetPlottingTimeRef(const std::shared_ptr<double> &_time);
 
+  /// \brief Set the clock giving the time of the samples, which overrides
+  /// the plotting time ref
+  /// \param[in] _clock Plotting clock
+  public: void SetClock(const std::shared_ptr<const PlottingClock> &_clock);
+
+  /// \brief Set the sampling policy of all the fields of the topic which
+  /// don't have their own policy. Defaults to keep all the samples.
+  /// \param[in] _policy Sampling policy
+  public: void SetSamplingPolicy(const SamplingPolicy &_policy);
+
+  /// \brief Set the sampling policy of a field, overriding the topic policy
+  /// \param[in] _fieldPath field path ID
+  /// \param[in] _policy Sampling policy
+  public: void SetSamplingPolicy(const std::string &_fieldPath,
+                                 const SamplingPolicy &_policy);
+
+  /// \brief Get the sampling policy of a field
+  /// \param[in] _fieldPath field path ID, empty for the topic policy
+  /// \return The field policy if set, otherwise the topic policy
+  public: SamplingPolicy FieldSamplingPolicy(
+              const std::string &_fieldPath) const;
+
   /// \brief Private data member.
   private: std::unique_ptr<TopicPrivate> dataPtr;
 };
@@ -186,10 +381,40 @@ class IGNITION_GUI_VISIBLE Transport : public QObject
   /// \brief Unsubscribe from non-exist topics in the transport
   public slots: void UnsubscribeOutdatedTopics();
 
-  /// \brief Get the registered topics
+  /// \brief Get the ID of a subscribed topic, which indexes the flat array
+  /// of the subscribed topics. It stays valid until the topic is
+  /// unsubscribed, then may be reused by another topic.
+  /// \param[in] _topic topic name
+  /// \return Topic ID, -1 if the topic isn't subscribed
+  public: int TopicId(const std::string &_topic) const;
+
+  /// \brief Get a subscribed topic
+  /// \param[in] _id Topic ID
+  /// \return Topic, null if the ID isn't subscribed
+  public: Topic *TopicById(int _id);
+
+  /// \brief Get the registered topics. The map is rebuilt on each call, use
+  /// TopicId and TopicById for frequent lookups.
   /// \return Topics list
   public: const std::map<std::string, Topic*> &Topics();
 
+  /// \brief Flush the buffered samples of all the subscribed topics
+  public: void Flush();
+
+  /// \brief Set the clock giving the time of the samples of the topics
+  /// subscribed from now on, which overrides their plotting time ref
+  /// \param[in] _clock Plotting clock
+  public: void SetClock(const std::shared_ptr<const PlottingClock> &_clock);
+
+  /// \brief Set the sampling policy of a topic or one of its fields. The
+  /// policy is kept for topics which are subscribed later.
+  /// \param[in] _topic topic name
+  /// \param[in] _fieldPath field path ID, empty for the topic policy
+  /// \param[in] _policy Sampling policy
+  public: void SetSamplingPolicy(const std::string &_topic,
+                                 const std::string &_fieldPath,
+                                 const SamplingPolicy &_policy);
+
   /// \brief Slot for receiving topics signal at each topic callback to plot
   /// \param[in] _chart chart ID
   /// \param[in] _fieldID field path ID
@@ -204,6 +429,22 @@ class IGNITION_GUI_VISIBLE Transport : public QObject
   /// \param[in] _y y coordinates of the plot point
   signals: void plot(int _chart, QString _fieldID, double _x, double _y);
 
+  /// \brief Slot for receiving the batched samples of the topics
+  /// \param[in] _charts IDs of the charts plotting the field
+  /// \param[in] _fieldID field path ID
+  /// \param[in] _x x coordinates of the plot points
+  /// \param[in] _y y coordinates of the plot points
+  public slots: void onSeriesPoints(QVector<int> _charts, QString _fieldID,
+                                    QVector<double> _x, QVector<double> _y);
+
+  /// \brief notify the Plotting Interface to plot a batch of samples
+  /// \param[in] _charts IDs of the charts plotting the field
+  /// \param[in] _fieldID field path ID
+  /// \param[in] _x x coordinates of the plot points
+  /// \param[in] _y y coordinates of the plot points
+  signals: void seriesPoints(QVector<int> _charts, QString _fieldID,
+                             QVector<double> _x, QVector<double> _y);
+
   /// \brief Private data member.
   private: std::unique_ptr<TransportPrivate> dataPtr;
 };
@@ -241,10 +482,34 @@ class IGNITION_GUI_VISIBLE PlottingInterface : public QObject
                                  QString _topic);
 
   /// \brief Get the timeout of updating the plot
-  /// \return updating plot timeout
+  /// \return updating plot timeout, the refresh period in ms
   public: float Timeout() const;
 
+  /// \brief Set the time base of the plotted samples
+  /// \param[in] _source Time source
+  public: void SetTimeSource(PlottingTimeSource _source);
+
+  /// \brief Get the time base of the plotted samples
+  /// \return Time source
+  public: PlottingTimeSource TimeSource() const;
+
+  /// \brief Set the topic to get the simulation time from, publishing
+  /// ignition.msgs.WorldStatistics or ignition.msgs.Clock, e.g.
+  /// "/world/default/stats" or "/clock"
+  /// \param[in] _topic Topic name, empty to stop receiving the sim time
+  /// \return True if subscribed
+  public: bool SetSimTimeTopic(const std::string &_topic);
+
+  /// \brief Get the clock giving the time of the samples
+  /// \return Plotting clock
+  public: const PlottingClock &Clock() const;
+
+  /// \brief Set the time base of the plotted samples
+  /// \param[in] _source "wall", "sim" or "header"
+  public slots: void setTimeSource(QString _source);
+
   /// \brief slot to get triggered to plot a point and send its data to the UI
+  /// The point is buffered and sent to the UI with the next flush.
   /// \param[in] _chart chart ID
   /// \param[in] _fieldID field path ID
   /// \param[in] _x x coordinates of the plot point
@@ -258,6 +523,277 @@ class IGNITION_GUI_VISIBLE PlottingInterface : public QObject
   /// \param[in] _y y coordinates of the plot point
   signals: void plot(int _chart, QString _fieldID, double _x, double _y);
 
+  /// \brief slot to store a batch of samples of a field plotted on a
+  /// chart. The same samples sent for each chart plotting the field are
+  /// only stored once.
+  /// \param[in] _chart chart ID
+  /// \param[in] _fieldID field path ID
+  /// \param[in] _x x coordinates of the plot points
+  /// \param[in] _y y coordinates of the plot points
+  public slots: void onPlotPoints(int _chart, QString _fieldID,
+                                  QVector<double> _x, QVector<double> _y);
+
+  /// \brief slot to get triggered by the topics to store a batch of samples
+  /// of a field, once for all the charts plotting it
+  /// \param[in] _charts IDs of the charts plotting the field
+  /// \param[in] _fieldID field path ID
+  /// \param[in] _x x coordinates of the plot points
+  /// \param[in] _y y coordinates of the plot points
+  public slots: void onSeriesPoints(QVector<int> _charts, QString _fieldID,
+                                    QVector<double> _x, QVector<double> _y);
+
+  /// \brief plot a batch of points to a chart, emitted at most once per
+  /// chart per field on each flush
+  /// \param[in] _chart chart ID
+  /// \param[in] _fieldID field path ID
+  /// \param[in] _x x coordinates of the plot points
+  /// \param[in] _y y coordinates of the plot points
+  signals: void plotPoints(int _chart, QString _fieldID,
+                           QVector<double> _x, QVector<double> _y);
+
+  /// \brief Notify a chart that new samples of a series were stored,
+  /// emitted at most once per chart per field on each flush
+  /// \param[in] _chart chart ID
+  /// \param[in] _fieldID field path ID
+  /// \param[in] _minX min x coordinate of the new samples
+  /// \param[in] _maxX max x coordinate of the new samples
+  /// \param[in] _minY min y coordinate of the new samples
+  /// \param[in] _maxY max y coordinate of the new samples
+  signals: void seriesUpdated(int _chart, QString _fieldID,
+                              double _minX, double _maxX,
+                              double _minY, double _maxY);
+
+  /// \brief Store all the samples buffered since the last flush and notify
+  /// the UI. Triggered by the refresh timer once per frame.
+  public slots: void Flush();
+
+  /// \brief Fill a chart series with the stored samples within a range,
+  /// decimated to the first, last, min and max samples of each pixel column
+  /// \param[in] _series QtCharts XY series to fill
+  /// \param[in] _chart chart ID
+  /// \param[in] _fieldID field path ID
+  /// \param[in] _minX min x coordinate of the visible range
+  /// \param[in] _maxX max x coordinate of the visible range
+  /// \param[in] _width width of the visible range in pixels
+  /// \return Number of points in the chart series
+  public slots: int updateSeries(QObject *_series, int _chart,
+                                 QString _fieldID, double _minX, double _maxX,
+                                 int _width);
+
+  /// \brief Set the sampling policy of a topic or one of its fields
+  /// \param[in] _topic topic name
+  /// \param[in] _fieldPath field path ID, empty for the topic policy
+  /// \param[in] _mode SamplingMode as int
+  /// \param[in] _rate Sampling rate in Hz
+  public slots: void setSamplingPolicy(QString _topic, QString _fieldPath,
+                                       int _mode, double _rate);
+
+  /// \brief Set the rate of refreshing the charts with the captured samples.
+  /// It only limits how often the UI is updated, all the captured samples
+  /// are stored regardless.
+  /// \param[in] _rate Refresh rate in Hz
+  public: void SetRefreshRate(double _rate);
+
+  /// \brief Get the rate of refreshing the charts
+  /// \return Refresh rate in Hz
+  public: double RefreshRate() const;
+
+  /// \brief Get the stored samples of a series. The samples of a field are
+  /// stored once and shared by all the charts plotting it, each chart only
+  /// keeps its own view of them.
+  /// \param[in] _chart chart ID
+  /// \param[in] _fieldID field path ID
+  /// \return Stored samples, null if the chart doesn't plot the series
+  public: const TimeSeries *Series(int _chart, const QString &_fieldID) const;
+
+  /// \brief Set the max number of samples stored per series. Applies to the
+  /// existing series too, keeping their most recent samples.
+  /// \param[in] _capacity Max number of samples
+  public: void SetSeriesCapacity(std::size_t _capacity);
+
+  /// \brief Get the max number of samples stored per series
+  /// \return Max number of samples
+  public: std::size_t SeriesCapacity() const;
+
+  /// \brief Add a series derived from other series of a chart by an
+  /// expression, see SeriesExpression. It is evaluated on each refresh over
+  /// the samples stored since the previous one, and stored as a series of
+  /// the chart like the fields.
+  /// \param[in] _chart chart ID
+  /// \param[in] _name Derived series ID, replaces a derived series with the
+  /// same ID
+  /// \param[in] _expression Expression, referencing field path IDs of the
+  /// chart, e.g. "{/odom-twist-linear-x} - {/cmd_vel-linear-x}"
+  /// \param[in] _alignment How the other inputs are aligned to the first
+  /// \return True on success, false if the expression is invalid or the ID
+  /// is taken by a field
+  public: bool AddDerivedSeries(int _chart, const QString &_name,
+              const std::string &_expression,
+              SeriesAlignment _alignment = SeriesAlignment::INTERPOLATE);
+
+  /// \brief Add a derived series, see AddDerivedSeries
+  /// \param[in] _chart chart ID
+  /// \param[in] _name Derived series ID
+  /// \param[in] _expression Expression
+  /// \return True on success
+  public slots: bool addDerivedSeries(int _chart, QString _name,
+                                      QString _expression);
+
+  /// \brief Remove a derived series and its stored samples
+  /// \param[in] _chart chart ID
+  /// \param[in] _name Derived series ID
+  public slots: void removeDerivedSeries(int _chart, QString _name);
+
+  /// \brief Add a series plotting a field against another one of the chart,
+  /// e.g. a trajectory from the x and y of a pose, or the correlation of
+  /// fields of different topics. The samples of the fields are paired by
+  /// time with a SeriesJoin, so the time source should be the message
+  /// headers to pair fields of different topics.
+  /// \param[in] _chart chart ID
+  /// \param[in] _name XY series ID
+  /// \param[in] _xFieldID ID of the field of the x coordinates
+  /// \param[in] _yFieldID ID of the field of the y coordinates
+  /// \param[in] _tolerance Max time difference of paired samples
+  /// \return True on success, false if the ID is taken by another series
+  public: bool AddXYSeries(int _chart, const QString &_name,
+                           const QString &_xFieldID,
+                           const QString &_yFieldID, double _tolerance = 0);
+
+  /// \brief Get the stored points of an XY series
+  /// \param[in] _chart chart ID
+  /// \param[in] _name XY series ID
+  /// \param[out] _x x coordinates of the points, in time order
+  /// \param[out] _y y coordinates of the points, in time order
+  /// \return False if there is no such XY series
+  public: bool XYPoints(int _chart, const QString &_name,
+                        std::vector<double> &_x,
+                        std::vector<double> &_y) const;
+
+  /// \brief Add an XY series, see AddXYSeries
+  /// \param[in] _chart chart ID
+  /// \param[in] _name XY series ID
+  /// \param[in] _xFieldID ID of the field of the x coordinates
+  /// \param[in] _yFieldID ID of the field of the y coordinates
+  /// \param[in] _tolerance Max time difference of paired samples
+  /// \return True on success
+  public slots: bool addXYSeries(int _chart, QString _name,
+                                 QString _xFieldID, QString _yFieldID,
+                                 double _tolerance);
+
+  /// \brief Remove an XY series and its stored points
+  /// \param[in] _chart chart ID
+  /// \param[in] _name XY series ID
+  public slots: void removeXYSeries(int _chart, QString _name);
+
+  /// \brief Fill a chart series with the stored points of an XY series,
+  /// decimated to the pixels of the visible area
+  /// \param[in] _series QXYSeries to fill, e.g. a LineSeries
+  /// \param[in] _chart chart ID
+  /// \param[in] _name XY series ID
+  /// \param[in] _minX Min visible x coordinate
+  /// \param[in] _maxX Max visible x coordinate
+  /// \param[in] _minY Min visible y coordinate
+  /// \param[in] _maxY Max visible y coordinate
+  /// \param[in] _width Width of the visible area in pixels
+  /// \param[in] _height Height of the visible area in pixels
+  /// \return Number of points set in the series
+  public slots: int updateXYSeries(QObject *_series, int _chart,
+                                   QString _name, double _minX, double _maxX,
+                                   double _minY, double _maxY, int _width,
+                                   int _height);
+
+  /// \brief Notify that new points of an XY series are stored
+  /// \param[in] _chart chart ID
+  /// \param[in] _name XY series ID
+  /// \param[in] _minX Min x coordinate of the new points
+  /// \param[in] _maxX Max x coordinate of the new points
+  /// \param[in] _minY Min y coordinate of the new points
+  /// \param[in] _maxY Max y coordinate of the new points
+  signals: void xySeriesUpdated(int _chart, QString _name, double _minX,
+                                double _maxX, double _minY, double _maxY);
+
+  /// \brief Switch to the triggered capture mode. The live samples keep
+  /// being stored, but the charts only redraw when a capture completes.
+  /// \param[in] _trigger Capture trigger
+  /// \return True on success, false if the trigger is invalid
+  public: bool SetTrigger(const CaptureTrigger &_trigger);
+
+  /// \brief Switch back to the continuous mode, dropping the captures
+  public: void ClearTrigger();
+
+  /// \brief Check if the triggered capture mode is on
+  /// \return True in the triggered capture mode
+  public: bool TriggerEnabled() const;
+
+  /// \brief Check if the trigger waits for its condition, it isn't after a
+  /// single shot capture
+  /// \return True if armed
+  public: bool TriggerArmed() const;
+
+  /// \brief Get the samples of the last capture of a series
+  /// \param[in] _chart chart ID
+  /// \param[in] _fieldID field path ID
+  /// \return Captured samples, null if there is no capture of the series
+  public: const TimeSeries *Capture(int _chart, const QString &_fieldID) const;
+
+  /// \brief Switch to the triggered capture mode, see SetTrigger
+  /// \param[in] _fieldID Field path ID of the trigger series
+  /// \param[in] _condition "rising", "falling" or "level"
+  /// \param[in] _threshold Threshold of the condition
+  /// \param[in] _preTime Captured duration before the trigger in seconds
+  /// \param[in] _postTime Captured duration after the trigger in seconds
+  /// \param[in] _singleShot True to stop after one capture
+  /// \return True on success
+  public slots: bool setTrigger(QString _fieldID, QString _condition,
+                                double _threshold, double _preTime,
+                                double _postTime, bool _singleShot);
+
+  /// \brief Switch back to the continuous mode
+  public slots: void clearTrigger();
+
+  /// \brief Arm the trigger again after a single shot capture, or restart
+  /// waiting for the condition
+  public slots: void armTrigger();
+
+  /// \brief Notify that a capture completed and the charts were updated
+  /// with it
+  /// \param[in] _time Time of the trigger sample
+  /// \param[in] _start Start time of the captured window
+  /// \param[in] _end End time of the captured window
+  signals: void captureCompleted(double _time, double _start, double _end);
+
+  /// \brief Get the statistics of all the samples of a series received
+  /// since subscribing, including the ones no longer stored
+  /// \param[in] _chart chart ID
+  /// \param[in] _fieldID field path ID
+  /// \return Statistics, null if the chart doesn't plot the series
+  public: const SeriesStats *Stats(int _chart, const QString &_fieldID) const;
+
+  /// \brief Get the statistics of the samples of a series in the sliding
+  /// window ending at its most recent sample
+  /// \param[in] _chart chart ID
+  /// \param[in] _fieldID field path ID
+  /// \return Statistics, null if the chart doesn't plot the series
+  public: const SeriesStats *WindowStats(int _chart,
+                                         const QString &_fieldID) const;
+
+  /// \brief Set the duration of the statistics sliding window. Restarts
+  /// the window statistics of the existing series.
+  /// \param[in] _window Window duration in seconds
+  public: void SetStatsWindow(double _window);
+
+  /// \brief Get the duration of the statistics sliding window
+  /// \return Window duration in seconds
+  public: double StatsWindow() const;
+
+  /// \brief Get the statistics of a series for the chart readout
+  /// \param[in] _chart chart ID
+  /// \param[in] _fieldID field path ID
+  /// \return Map with the "count", "min", "max", "mean", "std" and "rms" of
+  /// the full history, and the same for the window in a "window" map.
+  /// Empty if the series has no samples yet.
+  public slots: QVariantMap seriesStats(int _chart, QString _fieldID) const;
+
   /// \brief called by Qml to register a chart to a component attribute
   /// \param[in] _entity entity id which has the component
   /// \param[in] _typeId component type id
@@ -307,7 +843,7 @@ class IGNITION_GUI_VISIBLE PlottingInterface : public QObject
   /// \brief Create suitable file path with unique name and extention
   /// \param[in] _path path selected from the UI
   /// \param[in] _name file name
-  /// \param[in] _extention file extention (csv or pdf)
+  /// \param[in] _extention file extention (csv, bin or pdf)
   public slots: std::string FilePath(QString _path, std::string _name,
                                      std::string _extention);
 
@@ -319,17 +855,76 @@ class IGNITION_GUI_VISIBLE PlottingInterface : public QObject
   public slots: bool exportCSV(QString _path, int _chart,
                                QMap< QString, QVariant> _serieses);
 
+  /// \brief Export the stored samples of series to files in the background.
+  /// The samples are copied on the calling thread and written by a worker
+  /// thread, one file per series. Exports are queued if another one is
+  /// running.
+  /// \param[in] _path path of folder to save the files
+  /// \param[in] _chart plot id to make the file names unique
+  /// \param[in] _fieldIDs field path IDs of the series to export
+  /// \param[in] _format "CSV" or "Binary", see SeriesFormat
+  /// \return Number of queued files
+  public slots: int exportSeries(QString _path, int _chart,
+                                 QStringList _fieldIDs, QString _format);
+
+  /// \brief Cancel the running and queued exports
+  public slots: void cancelExport();
+
+  /// \brief Notify the progress of exporting a file
+  /// \param[in] _file path of the exported file
+  /// \param[in] _progress exported fraction, from 0 to 1
+  signals: void exportProgress(QString _file, double _progress);
+
+  /// \brief Notify that exporting a file is done
+  /// \param[in] _file path of the exported file
+  /// \param[in] _success True if the file is exported, false if writing
+  /// failed or the export is cancelled
+  signals: void exportFinished(QString _file, bool _success);
+
+  /// \brief Open a series file written by an export, CSV or binary, to plot
+  /// it on a chart. The file is memory mapped and summarized once in a
+  /// min/max pyramid, see RecordedSeries. The chart is notified of the
+  /// series bounds on the next flush.
+  /// \param[in] _chart chart ID
+  /// \param[in] _path file path, or file URL
+  /// \return ID of the recorded series, its name in the file, empty on
+  /// failure
+  public slots: QString openRecording(int _chart, QString _path);
+
+  /// \brief Close a recorded series file
+  /// \param[in] _chart chart ID
+  /// \param[in] _name recorded series ID
+  public slots: void closeRecording(int _chart, QString _name);
+
+  /// \brief Get a recorded series
+  /// \param[in] _chart chart ID
+  /// \param[in] _name recorded series ID
+  /// \return Recorded series, null if not open
+  public: const RecordedSeries *Recording(int _chart,
+                                          const QString &_name) const;
+
   /// \brief Get Component Name based on its type Id
   /// \param[in] _typeId type Id of the component
   /// \return Component name
   signals: std::string ComponentName(uint64_t _typeId);
 
-  /// \brief configration of the timer
+  /// \brief configration of the timer. Restarts the plotting clock, the
+  /// time is read from it on demand rather than ticked by a timer.
   public: void InitTimer();
 
-  /// \brief update the plotting tool time
+  /// \brief update the plotting tool time ref with the plotting clock time
   public slots: void UpdateTime();
 
+  /// \brief Get the key of a series used in its exported file name and
+  /// header, with the component type names resolved
+  /// \param[in] _fieldID field path ID
+  /// \return Series key
+  private: std::string SeriesKey(const QString &_fieldID);
+
+  /// \brief Copy the captured window of every series once the trigger fired
+  /// and its post-trigger duration elapsed, and redraw the charts with it
+  private: void CompleteCapture();
+
   /// \brief Private data member.
   private: std::unique_ptr<PlottingIfacePrivate> dataPtr;
 };
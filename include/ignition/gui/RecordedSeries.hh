@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_GUI_RECORDEDSERIES_HH_
+#define IGNITION_GUI_RECORDEDSERIES_HH_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ignition/gui/Export.hh"
+
+namespace ignition
+{
+namespace gui
+{
+class RecordedSeriesPrivate;
+
+/// \brief Read-only series loaded from a file written by WriteSeriesBinary
+/// or WriteSeriesCSV, to plot earlier recordings without replaying them.
+///
+/// Binary files are memory mapped and their samples are read in place, so
+/// opening a file of 100M samples doesn't copy it. CSV files are mapped and
+/// parsed into plain columns. The samples are expected in non-decreasing
+/// time order, as they are exported.
+///
+/// On opening, a min/max pyramid of the values is built once: each level
+/// holds the min and max of blocks of 32 times more samples than the level
+/// below. Points() then reads the coarsest level with blocks finer than a
+/// pixel, so any zoom level costs about the same, whatever the file size.
+class IGNITION_GUI_VISIBLE RecordedSeries
+{
+  /// \brief Constructor
+  public: RecordedSeries();
+
+  /// \brief Destructor
+  public: ~RecordedSeries();
+
+  /// \brief Open a series file, closing the previous one. The format is
+  /// detected from the content.
+  /// \param[in] _path File path
+  /// \return True on success, false if the file can't be read or isn't a
+  /// valid series file
+  public: bool Open(const std::string &_path);
+
+  /// \brief Close the file and drop the pyramid
+  public: void Close();
+
+  /// \brief Get the series name stored in the file
+  /// \return Series name
+  public: const std::string &Name() const;
+
+  /// \brief Get the number of samples
+  /// \return Number of samples, 0 if no file is open
+  public: std::size_t Size() const;
+
+  /// \brief Get the time of a sample
+  /// \param[in] _index Sample index
+  /// \return Sample time
+  public: double Time(std::size_t _index) const;
+
+  /// \brief Get the value of a sample
+  /// \param[in] _index Sample index
+  /// \return Sample value
+  public: double Value(std::size_t _index) const;
+
+  /// \brief Index of the first sample with time not less than a given time
+  /// \param[in] _time Time to search for
+  /// \return Sample index, Size() if all the samples are older
+  public: std::size_t LowerBound(double _time) const;
+
+  /// \brief Get the min value of all the samples, ignoring NaN
+  /// \return Min value
+  public: double MinValue() const;
+
+  /// \brief Get the max value of all the samples, ignoring NaN
+  /// \return Max value
+  public: double MaxValue() const;
+
+  /// \brief Get the number of levels of the pyramid above the samples
+  /// \return Number of levels
+  public: std::size_t Levels() const;
+
+  /// \brief Get the points to draw a time range on a given number of
+  /// horizontal pixels: all the samples if there are few, otherwise the min
+  /// and max of the samples of each pixel column. Includes the closest
+  /// sample at each side of the range, so lines reach the edges.
+  /// \param[in] _minX Start of the time range
+  /// \param[in] _maxX End of the time range
+  /// \param[in] _pixels Width of the range in pixels
+  /// \param[out] _x x coordinates of the points
+  /// \param[out] _y y coordinates of the points
+  public: void Points(double _minX, double _maxX, unsigned int _pixels,
+                      std::vector<double> &_x,
+                      std::vector<double> &_y) const;
+
+  /// \brief Private data pointer
+  private: std::unique_ptr<RecordedSeriesPrivate> dataPtr;
+};
+}
+}
+
+#endif
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GUI_SERIESDECIMATOR_HH_
+#define IGNITION_GUI_SERIESDECIMATOR_HH_
+
+#include <memory>
+#include <vector>
+
+#include "ignition/gui/Export.hh"
+
+namespace ignition
+{
+namespace gui
+{
+class SeriesDecimatorPrivate;
+class TimeSeries;
+
+/// \brief Reduces a time series to the points needed to draw it on a given
+/// number of horizontal pixels (M4 decimation).
+/// The visible x range is split into buckets about one pixel wide, and only
+/// the first, last, min and max samples of each bucket are kept, so the
+/// drawn line looks the same as with all the samples, spikes included,
+/// while the number of points is bounded by 4 times the pixel width.
+///
+/// The bucket width is rounded up to a power of two and the buckets are
+/// aligned to x = 0, so panning and extending the range keep the existing
+/// buckets. Each update only aggregates the samples appended since the
+/// previous one and the samples of the newly visible buckets.
+class IGNITION_GUI_VISIBLE SeriesDecimator
+{
+  /// \brief Constructor
+  public: SeriesDecimator();
+
+  /// \brief Destructor
+  public: ~SeriesDecimator();
+
+  /// \brief Set the visible range. If the bucket width changes, the
+  /// buckets are recomputed on the next update.
+  /// \param[in] _minX Min visible x coordinate
+  /// \param[in] _maxX Max visible x coordinate
+  /// \param[in] _pixels Width of the visible range in pixels
+  public: void SetView(double _minX, double _maxX, unsigned int _pixels);
+
+  /// \brief Get the width of the buckets
+  /// \return Bucket width in x units, zero if there is no valid view
+  public: double BucketWidth() const;
+
+  /// \brief Update the buckets with the samples of a series. The same series
+  /// should be passed on every update.
+  /// \param[in] _series Series to decimate
+  public: void Update(const TimeSeries &_series);
+
+  /// \brief Get the decimated points in x order. Includes the closest sample
+  /// at each side of the visible range, so lines reach the edges.
+  /// \param[out] _x x coordinates of the points
+  /// \param[out] _y y coordinates of the points
+  public: void Points(std::vector<double> &_x, std::vector<double> &_y) const;
+
+  /// \brief Drop all the buckets, so the next update recomputes them
+  public: void Reset();
+
+  /// \brief Private data pointer
+  private: std::unique_ptr<SeriesDecimatorPrivate> dataPtr;
+};
+}
+}
+
+#endif
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_GUI_SERIESEXPORT_HH_
+#define IGNITION_GUI_SERIESEXPORT_HH_
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "ignition/gui/Export.hh"
+
+namespace ignition
+{
+namespace gui
+{
+class TimeSeries;
+
+/// \brief File formats of exported series
+enum class SeriesFormat
+{
+  /// \brief Text file with a "time, value" line per sample
+  CSV,
+
+  /// \brief Binary columnar file, see WriteSeriesBinary
+  BINARY
+};
+
+/// \brief Samples of a series copied out of their store, so they can be
+/// exported by another thread while the store keeps being appended to.
+class IGNITION_GUI_VISIBLE SeriesSnapshot
+{
+  /// \brief Default constructor
+  public: SeriesSnapshot() = default;
+
+  /// \brief Copy the samples of a series
+  /// \param[in] _name Series name
+  /// \param[in] _series Series to copy
+  public: SeriesSnapshot(const std::string &_name, const TimeSeries &_series);
+
+  /// \brief Series name
+  public: std::string name;
+
+  /// \brief Sample times
+  public: std::vector<double> times;
+
+  /// \brief Sample values
+  public: std::vector<double> values;
+};
+
+/// \brief Called while writing a series with the number of samples written
+/// so far. Returning false cancels the writing.
+using SeriesProgressCallback = std::function<bool(std::size_t)>;
+
+/// \brief Write a series to a CSV file, with a "time, <name>" header line.
+/// The file is written in large blocks, without flushing per line.
+/// \param[in] _path File path
+/// \param[in] _series Series to write
+/// \param[in] _progress Optional progress callback
+/// \return True on success, false if the file can't be written or the
+/// writing is cancelled
+IGNITION_GUI_VISIBLE
+bool WriteSeriesCSV(const std::string &_path, const SeriesSnapshot &_series,
+                    const SeriesProgressCallback &_progress = nullptr);
+
+/// \brief Write a series to a binary columnar file, made of:
+///   * 8 bytes magic "IGNSERIE"
+///   * uint32 format version, currently 1
+///   * uint32 length of the name in bytes
+///   * uint64 number of samples N
+///   * the name, not null terminated
+///   * N float64 sample times
+///   * N float64 sample values
+/// Numbers are in the host byte order, which is checked by the reader
+/// through the version field.
+/// \param[in] _path File path
+/// \param[in] _series Series to write
+/// \param[in] _progress Optional progress callback
+/// \return True on success, false if the file can't be written or the
+/// writing is cancelled
+IGNITION_GUI_VISIBLE
+bool WriteSeriesBinary(const std::string &_path,
+                       const SeriesSnapshot &_series,
+                       const SeriesProgressCallback &_progress = nullptr);
+
+/// \brief Write a series to a file
+/// \param[in] _path File path
+/// \param[in] _series Series to write
+/// \param[in] _format File format
+/// \param[in] _progress Optional progress callback
+/// \return True on success
+IGNITION_GUI_VISIBLE
+bool WriteSeries(const std::string &_path, const SeriesSnapshot &_series,
+                 SeriesFormat _format,
+                 const SeriesProgressCallback &_progress = nullptr);
+
+/// \brief Read a series written by WriteSeriesBinary
+/// \param[in] _path File path
+/// \param[out] _series Read series
+/// \return True on success, false if the file can't be read or isn't a
+/// valid series file
+IGNITION_GUI_VISIBLE
+bool ReadSeriesBinary(const std::string &_path, SeriesSnapshot &_series);
+}
+}
+
+#endif
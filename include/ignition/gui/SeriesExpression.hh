@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_GUI_SERIESEXPRESSION_HH_
+#define IGNITION_GUI_SERIESEXPRESSION_HH_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ignition/gui/Export.hh"
+
+namespace ignition
+{
+namespace gui
+{
+class SeriesExpressionPrivate;
+class TimeSeries;
+
+/// \brief How the inputs of an expression are aligned to the sample times
+/// of its first input
+enum class SeriesAlignment
+{
+  /// \brief Linear interpolation between the input samples around the
+  /// time. A sample waits until all the inputs have samples after it.
+  INTERPOLATE,
+
+  /// \brief Most recent input sample at or before the time
+  HOLD
+};
+
+/// \brief Series derived from other series by an expression, e.g.
+/// "sqrt({/odom-twist-linear-x}^2 + {/odom-twist-linear-y}^2)".
+///
+/// The syntax supports:
+///   * numbers, and the constants pi and e
+///   * input series between braces, e.g. {/topic-data}
+///   * t, the sample time
+///   * the operators + - * / ^ and parentheses
+///   * the functions abs, sqrt, exp, log, sin, cos, tan, asin, acos, atan,
+///     floor, ceil, atan2(y, x), hypot(x, y), min(a, b), max(a, b),
+///     pow(x, y)
+///   * deriv(x), the time derivative of x between consecutive samples, and
+///     integral(x), its trapezoidal time integral
+///
+/// The expression is compiled once into a stack program, which is run on
+/// whole columns of samples at a time. The output samples are at the times
+/// of the first input, which the other inputs are aligned to.
+class IGNITION_GUI_VISIBLE SeriesExpression
+{
+  /// \brief Constructor
+  public: SeriesExpression();
+
+  /// \brief Destructor
+  public: ~SeriesExpression();
+
+  /// \brief Parse and compile an expression, resetting the evaluation
+  /// \param[in] _expression Expression text
+  /// \return True on success, see Error otherwise
+  public: bool Compile(const std::string &_expression);
+
+  /// \brief Check if an expression has been successfully compiled
+  /// \return True if the expression can be evaluated
+  public: bool Valid() const;
+
+  /// \brief Get the error of the last compilation
+  /// \return Error message with its position, empty on success
+  public: const std::string &Error() const;
+
+  /// \brief Get the series referenced by the expression
+  /// \return Input series names, in order of first appearance
+  public: const std::vector<std::string> &Inputs() const;
+
+  /// \brief Set how the inputs are aligned to the first input. Defaults to
+  /// INTERPOLATE.
+  /// \param[in] _alignment Alignment
+  public: void SetAlignment(SeriesAlignment _alignment);
+
+  /// \brief Get how the inputs are aligned to the first input
+  /// \return Alignment
+  public: SeriesAlignment Alignment() const;
+
+  /// \brief Evaluate the expression on a batch of samples, carrying the
+  /// state of deriv and integral over from the previous batch
+  /// \param[in] _times Sample times
+  /// \param[in] _inputs Values of each input at the sample times, in the
+  /// order of Inputs()
+  /// \param[in] _count Number of samples
+  /// \param[out] _values Values of the expression, _count of them
+  public: void Evaluate(const double *_times,
+                        const std::vector<const double *> &_inputs,
+                        std::size_t _count, double *_values);
+
+  /// \brief Evaluate the expression on the samples of the first input
+  /// appended since the previous update, with the other inputs aligned to
+  /// them. Samples which can't be aligned yet are left for the next update.
+  /// \param[in] _inputs Series of each input in the order of Inputs(), null
+  /// if it has no samples yet. The same series should be passed on every
+  /// update.
+  /// \param[out] _times Times of the new output samples
+  /// \param[out] _values Values of the new output samples
+  /// \return Number of new output samples
+  public: std::size_t Update(const std::vector<const TimeSeries *> &_inputs,
+                             std::vector<double> &_times,
+                             std::vector<double> &_values);
+
+  /// \brief Restart the evaluation: reset the state of deriv and integral,
+  /// and the next update starts from the oldest stored input sample
+  public: void Reset();
+
+  /// \brief Private data pointer
+  private: std::unique_ptr<SeriesExpressionPrivate> dataPtr;
+};
+}
+}
+
+#endif
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_GUI_SERIESJOIN_HH_
+#define IGNITION_GUI_SERIESJOIN_HH_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "ignition/gui/Export.hh"
+
+namespace ignition
+{
+namespace gui
+{
+class SeriesJoinPrivate;
+class TimeSeries;
+
+/// \brief Pairs the samples of two series by time, to plot one against the
+/// other, e.g. a trajectory from the x and y of a pose, or the correlation
+/// of fields of different topics.
+///
+/// The series are merge-joined: both are walked once in time order, and
+/// each sample is paired with the closest sample of the other series if
+/// they are at most a tolerance apart. Samples without a match are dropped.
+/// Each update only joins the samples appended since the previous one.
+class IGNITION_GUI_VISIBLE SeriesJoin
+{
+  /// \brief Constructor
+  /// \param[in] _tolerance Max time difference of paired samples
+  public: explicit SeriesJoin(double _tolerance = 0);
+
+  /// \brief Destructor
+  public: ~SeriesJoin();
+
+  /// \brief Set the max time difference of paired samples
+  /// \param[in] _tolerance Tolerance in seconds, negative values are
+  /// treated as zero
+  public: void SetTolerance(double _tolerance);
+
+  /// \brief Get the max time difference of paired samples
+  /// \return Tolerance in seconds
+  public: double Tolerance() const;
+
+  /// \brief Join the samples appended to the series since the previous
+  /// update. The same series should be passed on every update. The last
+  /// samples may wait for the next sample of the other series, in case it
+  /// is a closer match.
+  /// \param[in] _x Series of the x coordinates
+  /// \param[in] _y Series of the y coordinates
+  /// \param[out] _times Time of each pair, the later of its two samples
+  /// \param[out] _xs x coordinate of each pair
+  /// \param[out] _ys y coordinate of each pair
+  /// \return Number of new pairs
+  public: std::size_t Update(const TimeSeries &_x, const TimeSeries &_y,
+                             std::vector<double> &_times,
+                             std::vector<double> &_xs,
+                             std::vector<double> &_ys);
+
+  /// \brief Restart joining from the oldest stored samples
+  public: void Reset();
+
+  /// \brief Private data pointer
+  private: std::unique_ptr<SeriesJoinPrivate> dataPtr;
+};
+
+/// \brief Reduce the points of an XY line to the ones needed to draw it on
+/// a grid of pixels. Consecutive points falling in the same pixel are
+/// merged, keeping the first and the last one of each run, so the line
+/// keeps its shape. Points outside the view are clamped to a cell beyond
+/// its border, so long excursions out of view collapse to a few points.
+/// \param[in] _xs x coordinates of the points, in line order
+/// \param[in] _ys y coordinates of the points, in line order
+/// \param[in] _count Number of points
+/// \param[in] _minX Min visible x coordinate
+/// \param[in] _maxX Max visible x coordinate
+/// \param[in] _minY Min visible y coordinate
+/// \param[in] _maxY Max visible y coordinate
+/// \param[in] _width Width of the view in pixels
+/// \param[in] _height Height of the view in pixels
+/// \param[out] _indices Indices of the kept points
+IGNITION_GUI_VISIBLE
+void DecimateXY(const double *_xs, const double *_ys, std::size_t _count,
+                double _minX, double _maxX, double _minY, double _maxY,
+                unsigned int _width, unsigned int _height,
+                std::vector<std::size_t> &_indices);
+}
+}
+
+#endif
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_GUI_SERIESSPECTRUM_HH_
+#define IGNITION_GUI_SERIESSPECTRUM_HH_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "ignition/gui/Export.hh"
+
+namespace ignition
+{
+namespace gui
+{
+class SeriesSpectrumPrivate;
+
+/// \brief Window functions applied to the segments of a spectrum
+enum class SpectrumWindow
+{
+  /// \brief No windowing
+  RECTANGULAR,
+
+  /// \brief Hann window, the default
+  HANN
+};
+
+/// \brief Power spectral density of evenly sampled values, estimated with
+/// Welch's method: the values are split into segments overlapping by half,
+/// each segment has its mean removed and is windowed, and the power spectra
+/// of the segments are averaged.
+///
+/// The spectra are computed with a radix-2 FFT, whose twiddle factors and
+/// window are cached for the segment size, so computing repeatedly with the
+/// same settings doesn't allocate. An instance isn't thread safe, but
+/// separate instances can compute on separate threads.
+class IGNITION_GUI_VISIBLE SeriesSpectrum
+{
+  /// \brief Constructor
+  /// \param[in] _segmentSize Number of values per segment, see
+  /// SetSegmentSize
+  public: explicit SeriesSpectrum(std::size_t _segmentSize = 1024);
+
+  /// \brief Destructor
+  public: ~SeriesSpectrum();
+
+  /// \brief Set the number of values per segment, which sets the frequency
+  /// resolution to the sample rate divided by it
+  /// \param[in] _segmentSize Number of values, rounded up to a power of two
+  /// of at least 8
+  public: void SetSegmentSize(std::size_t _segmentSize);
+
+  /// \brief Get the number of values per segment
+  /// \return Number of values, a power of two
+  public: std::size_t SegmentSize() const;
+
+  /// \brief Set the window function of the segments
+  /// \param[in] _window Window function
+  public: void SetWindow(SpectrumWindow _window);
+
+  /// \brief Get the window function of the segments
+  /// \return Window function
+  public: SpectrumWindow Window() const;
+
+  /// \brief Compute the one-sided power spectral density of values. With
+  /// fewer values than the segment size, a single segment of the largest
+  /// power of two of values is used.
+  /// \param[in] _values Evenly sampled values
+  /// \param[in] _count Number of values
+  /// \param[in] _sampleRate Sample rate in Hz
+  /// \param[out] _frequencies Frequency of each bin in Hz, from 0 to the
+  /// Nyquist frequency
+  /// \param[out] _power Power density of each bin, in squared value units
+  /// per Hz
+  /// \return Number of bins, 0 if there are fewer than 8 values or the
+  /// sample rate isn't positive
+  public: std::size_t Compute(const double *_values, std::size_t _count,
+                              double _sampleRate,
+                              std::vector<double> &_frequencies,
+                              std::vector<double> &_power);
+
+  /// \brief Private data pointer
+  private: std::unique_ptr<SeriesSpectrumPrivate> dataPtr;
+};
+}
+}
+
+#endif
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_GUI_SERIESSTATS_HH_
+#define IGNITION_GUI_SERIESSTATS_HH_
+
+#include <cstdint>
+#include <memory>
+
+#include "ignition/gui/Export.hh"
+
+namespace ignition
+{
+namespace gui
+{
+class SeriesStatsPrivate;
+
+/// \brief Summary statistics of a series of samples, updated in constant
+/// time per appended sample, so they can be kept live while plotting.
+///
+/// With no window, the statistics cover all the samples appended since the
+/// construction or the last reset. With a window, they only cover the
+/// samples at most the window duration older than the most recent one; the
+/// window samples are kept to remove them as they expire, and the min and
+/// max use monotonic queues, so each sample is added and removed once.
+///
+/// The mean and variance are computed with Welford's method. Samples are
+/// expected to be appended in non-decreasing time order, and non-finite
+/// values are ignored.
+class IGNITION_GUI_VISIBLE SeriesStats
+{
+  /// \brief Constructor
+  /// \param[in] _window Window duration in time units, zero or negative for
+  /// the full history
+  public: explicit SeriesStats(double _window = 0);
+
+  /// \brief Destructor
+  public: ~SeriesStats();
+
+  /// \brief Set the window duration. Resets the statistics.
+  /// \param[in] _window Window duration in time units, zero or negative for
+  /// the full history
+  public: void SetWindow(double _window);
+
+  /// \brief Get the window duration
+  /// \return Window duration, zero for the full history
+  public: double Window() const;
+
+  /// \brief Add a sample, and remove the samples which left the window
+  /// \param[in] _time Sample time
+  /// \param[in] _value Sample value
+  public: void Append(double _time, double _value);
+
+  /// \brief Remove all the samples
+  public: void Reset();
+
+  /// \brief Get the number of samples covered by the statistics
+  /// \return Sample count
+  public: std::uint64_t Count() const;
+
+  /// \brief Get the min value
+  /// \return Min value, NaN if there are no samples
+  public: double Min() const;
+
+  /// \brief Get the max value
+  /// \return Max value, NaN if there are no samples
+  public: double Max() const;
+
+  /// \brief Get the mean value
+  /// \return Mean value, NaN if there are no samples
+  public: double Mean() const;
+
+  /// \brief Get the population variance
+  /// \return Variance, NaN if there are no samples
+  public: double Variance() const;
+
+  /// \brief Get the population standard deviation
+  /// \return Standard deviation, NaN if there are no samples
+  public: double StdDev() const;
+
+  /// \brief Get the root mean square of the values
+  /// \return RMS value, NaN if there are no samples
+  public: double Rms() const;
+
+  /// \brief Private data pointer
+  private: std::unique_ptr<SeriesStatsPrivate> dataPtr;
+};
+}
+}
+
+#endif
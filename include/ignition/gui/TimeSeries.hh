@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GUI_TIMESERIES_HH_
+#define IGNITION_GUI_TIMESERIES_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "ignition/gui/Export.hh"
+
+namespace ignition
+{
+namespace gui
+{
+class TimeSeriesPrivate;
+
+/// \brief Contiguous range of samples of a time series
+class IGNITION_GUI_VISIBLE TimeSeriesSpan
+{
+  /// \brief Sample times, null if the span is empty
+  public: const double *times = nullptr;
+
+  /// \brief Sample values, null if the span is empty
+  public: const double *values = nullptr;
+
+  /// \brief Number of samples in the span
+  public: std::size_t size = 0;
+};
+
+/// \brief Fixed capacity store of (time, value) samples.
+/// Samples are kept in two ring buffers, one for the times and one for the
+/// values. The buffers grow as samples are appended, doubling in size up to
+/// the capacity, so a series only uses memory for the samples it holds. Once
+/// the capacity is reached, the oldest samples are overwritten without
+/// moving any data. Samples are expected to be appended in non-decreasing
+/// time order.
+class IGNITION_GUI_VISIBLE TimeSeries
+{
+  /// \brief Constructor
+  /// \param[in] _capacity Max number of samples kept in the series
+  public: explicit TimeSeries(std::size_t _capacity = 1 << 20);
+
+  /// \brief Destructor
+  public: ~TimeSeries();
+
+  /// \brief Set the max number of samples, keeping the most recent ones.
+  /// Reallocates the buffers if they are bigger than the new capacity.
+  /// \param[in] _capacity Max number of samples
+  public: void SetCapacity(std::size_t _capacity);
+
+  /// \brief Get the max number of samples
+  /// \return Max number of samples kept in the series
+  public: std::size_t Capacity() const;
+
+  /// \brief Get the number of samples
+  /// \return Number of samples currently stored
+  public: std::size_t Size() const;
+
+  /// \brief Check if the series has no samples
+  /// \return True if there are no samples
+  public: bool Empty() const;
+
+  /// \brief Get the number of samples appended since the construction or
+  /// the last Clear, including the overwritten ones. The sample with index
+  /// i has been the (TotalCount() - Size() + i)th appended sample, which
+  /// lets consumers process only the samples appended since a given point.
+  /// \return Number of appended samples
+  public: std::uint64_t TotalCount() const;
+
+  /// \brief Remove all the samples, keeping the buffers allocated
+  public: void Clear();
+
+  /// \brief Append a sample, overwriting the oldest one if full
+  /// \param[in] _time Sample time
+  /// \param[in] _value Sample value
+  public: void Append(double _time, double _value);
+
+  /// \brief Append a batch of samples
+  /// \param[in] _times Sample times
+  /// \param[in] _values Sample values
+  /// \param[in] _count Number of samples
+  public: void Append(const double *_times, const double *_values,
+                      std::size_t _count);
+
+  /// \brief Get the time of a sample
+  /// \param[in] _index Sample index, 0 is the oldest sample
+  /// \return Sample time
+  public: double Time(std::size_t _index) const;
+
+  /// \brief Get the value of a sample
+  /// \param[in] _index Sample index, 0 is the oldest sample
+  /// \return Sample value
+  public: double Value(std::size_t _index) const;
+
+  /// \brief Index of the first sample with time not less than a given time
+  /// \param[in] _time Time to search for
+  /// \return Sample index, Size() if all the samples are older
+  public: std::size_t LowerBound(double _time) const;
+
+  /// \brief Get the samples as at most two contiguous spans in
+  /// chronological order, the second one is empty unless the ring buffer
+  /// wraps around.
+  /// \param[out] _first Oldest samples
+  /// \param[out] _second Most recent samples
+  public: void Spans(TimeSeriesSpan &_first, TimeSeriesSpan &_second) const;
+
+  /// \brief Private data pointer
+  private: std::unique_ptr<TimeSeriesPrivate> dataPtr;
+};
+}
+}
+
+#endif
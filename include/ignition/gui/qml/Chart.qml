@@ -48,8 +48,9 @@ Rectangle {
   signal clicked(real Id);
 
   /**
-    Points Limitation: max points of each series
+    Points Limitation: max points of each series appended with appendPoint
     When points exceed that limit, some points from begining are deleted
+    Points stored in the PlottingInterface are decimated instead
   */
   property int maxPoints: 10000
   /**
@@ -71,6 +72,42 @@ Rectangle {
   {
     chart.appendPoint(_fieldID, _x, _y);
   }
+  /**
+    new points of a field graph are stored
+    _fieldID field key or path
+    _minX, _maxX, _minY, _maxY bounds of the new points
+  */
+  function seriesUpdated(_fieldID, _minX, _maxX, _minY, _maxY)
+  {
+    chart.seriesUpdated(_fieldID, _minX, _maxX, _minY, _maxY);
+  }
+  /**
+    plot a series opened from a file
+    _name recorded series ID
+  */
+  function addRecording(_name)
+  {
+    infoRect.addRecording(_name);
+  }
+  /**
+    new points of an XY series are stored
+    _name XY series ID
+    _minX, _maxX, _minY, _maxY bounds of the new points
+  */
+  function xySeriesUpdated(_name, _minX, _maxX, _minY, _maxY)
+  {
+    chart.xySeriesUpdated(_name, _minX, _maxX, _minY, _maxY);
+  }
+  /**
+    a triggered capture completed, show its window
+    _start, _end time range of the captured window
+  */
+  function captureCompleted(_start, _end)
+  {
+    xAxis.min = _start;
+    xAxis.max = _end;
+    chart.requestRefresh();
+  }
   /**
     set the chart opacity
     _opacity opacity value
@@ -179,11 +216,16 @@ Rectangle {
         subscribe(chartID, topic, path);
 
         // if the field is already attached
-        if (ID in chart.serieses)
+        if (ID in chart.serieses || ID in chart.wildcards)
           return;
 
+        // the series of the elements of a wildcard field are added when
+        // their first points arrive
+        if (path.indexOf("[*]") !== -1)
+          chart.addWildcard(ID);
         // add axis series to plot the field
-        chart.addSeries(ID, "");
+        else
+          chart.addSeries(ID, "");
 
         // add field info component
         infoRect.addField(ID, topic, path);
@@ -216,6 +258,114 @@ Rectangle {
       field.path = path;
       field.type = "Field"
     }
+    /**
+      add a series derived from the chart fields by an expression
+      name derived series ID
+      expression expression of the chart fields, e.g. {/topic-data} * 2
+      return: true if added
+    */
+    function addDerived(name, expression)
+    {
+      if (!name || (name in chart.serieses && !(name in chart.derived)))
+        return false;
+
+      if (!PlottingIface.addDerivedSeries(chartID, name, expression))
+        return false;
+
+      // redefined series
+      if (name in chart.derived)
+      {
+        chart.derived[name].expression = expression;
+        return true;
+      }
+
+      chart.addSeries(name, "");
+
+      var field = fieldInfo.createObject(row);
+      field.width = 150;
+      field.height = Qt.binding( function() {return infoRect.height * 0.8} );
+      field.y = Qt.binding( function()
+        {
+          if (infoRect.height)
+            return (infoRect.height - field.height)/2;
+          else
+            return 0;
+        }
+      );
+
+      field.path = name;
+      field.expression = expression;
+      field.type = "Derived";
+      chart.derived[name] = field;
+
+      guideText.visible = false;
+      return true;
+    }
+
+    /**
+      add a series plotting a field of the chart against another one
+      name XY series ID
+      xField ID of the field of the x coordinates
+      yField ID of the field of the y coordinates
+      tolerance max time difference of the paired samples
+      return: true if added
+    */
+    function addXY(name, xField, yField, tolerance)
+    {
+      if (!name || name in chart.serieses || name in chart.xySerieses)
+        return false;
+
+      if (!PlottingIface.addXYSeries(chartID, name, xField, yField, tolerance))
+        return false;
+
+      chart.addXYSeries(name);
+
+      var field = fieldInfo.createObject(row);
+      field.width = 150;
+      field.height = Qt.binding( function() {return infoRect.height * 0.8} );
+      field.y = Qt.binding( function()
+        {
+          if (infoRect.height)
+            return (infoRect.height - field.height)/2;
+          else
+            return 0;
+        }
+      );
+
+      field.path = name;
+      field.expression = "xy({" + xField + "}, {" + yField + "}, " + tolerance + ")";
+      field.type = "XY";
+
+      guideText.visible = false;
+      return true;
+    }
+
+    /**
+      add a series opened from a file to the chart
+      name recorded series ID
+    */
+    function addRecording(name)
+    {
+      chart.addSeries(name, "");
+
+      var field = fieldInfo.createObject(row);
+      field.width = 150;
+      field.height = Qt.binding( function() {return infoRect.height * 0.8} );
+      field.y = Qt.binding( function()
+        {
+          if (infoRect.height)
+            return (infoRect.height - field.height)/2;
+          else
+            return 0;
+        }
+      );
+
+      field.path = name;
+      field.type = "Recording";
+
+      guideText.visible = false;
+    }
+
     /**
       add component to the chart
       entity entity ID
@@ -318,6 +468,13 @@ Rectangle {
       property string topic: ""
       property string path: ""
 
+      /**
+        derived series data:
+        path is the series ID
+        expression expression of the series
+      */
+      property string expression: ""
+
       /**
         component data:
         entity entity ID
@@ -361,7 +518,9 @@ Rectangle {
           id: fieldname
           text: (component.type === "Field") ? component.topic + "/"+ component.path :
                 (component.type === "Component") ? component.entity + "," + component.typeName
-                                                   + "," + component.attribute : ""
+                                                   + "," + component.attribute :
+                (component.type === "Derived" || component.type === "XY" ||
+                 component.type === "Recording") ? component.path : ""
           color: "white"
           elide: Text.ElideRight
           width: parent.width * 0.9
@@ -377,7 +536,10 @@ Rectangle {
                                                     "typeId: " + component.typeId + "\n" +
                                                     "typeName: " + component.typeName + "\n" +
                                                     "dataType: " + component.componentType + "\n" +
-                                                    "attribute: " + component.attribute : ""
+                                                    "attribute: " + component.attribute :
+                (component.type === "Derived" || component.type === "XY") ?
+                    component.path + " = " + component.expression :
+                (component.type === "Recording") ? "recorded: " + component.path : ""
           visible: fieldInfoMouse.containsMouse
           y: fieldInfoMouse.mouseY
           x: fieldInfoMouse.mouseX
@@ -411,6 +573,18 @@ Rectangle {
               main.componentUnSubscribe(component.entity, component.typeId,
                                           component.attribute, main.chartID)
 
+            else if (component.type === "Derived")
+            {
+              PlottingIface.removeDerivedSeries(main.chartID, component.path);
+              delete chart.derived[component.path];
+            }
+
+            else if (component.type === "XY")
+              PlottingIface.removeXYSeries(main.chartID, component.path);
+
+            else if (component.type === "Recording")
+              PlottingIface.closeRecording(main.chartID, component.path);
+
 
             // delete the series points and deattache it from the chart
             if (component.type === "Field")
@@ -419,6 +593,12 @@ Rectangle {
             else if (component.type === "Component")
               chart.deleteSeries(component.componentId);
 
+            else if (component.type === "Derived" || component.type === "Recording")
+              chart.deleteSeries(component.path);
+
+            else if (component.type === "XY")
+              chart.deleteXYSeries(component.path);
+
             // delete the field info component
             component.destroy();
           }
@@ -444,6 +624,22 @@ Rectangle {
       all serieses, field path is the key, series is the value
     */
     property var serieses: ({})
+
+    /**
+      wildcard fields of the chart, <field id, regexp of its elements ids>
+    */
+    property var wildcards: ({})
+
+    /**
+      derived series of the chart, <series id, field info component>
+    */
+    property var derived: ({})
+
+    /**
+      XY serieses, plotting a field against another one, series id is the
+      key, series is the value
+    */
+    property var xySerieses: ({})
     /**
       colors to give the fields different colors
     */
@@ -496,11 +692,70 @@ Rectangle {
       chart.indexColor = (chart.indexColor + 1)  % chart.colors.length;
     }
 
+    /**
+      add a new XY series
+      ID key of the XY series
+    */
+    function addXYSeries(ID) {
+      var newSeries = createSeries(ChartView.SeriesTypeLine, ID, xAxis, yAxis);
+      newSeries.useOpenGL = true;
+      newSeries.width = 2;
+      newSeries.color = chart.colors[chart.indexColor % chart.colors.length]
+      xySerieses[ID] = newSeries;
+
+      chart.indexColor = (chart.indexColor + 1)  % chart.colors.length;
+    }
+
+    /**
+      delete an XY series by its ID
+      ID key of the XY series
+    */
+    function deleteXYSeries(ID) {
+      removeSeries(xySerieses[ID]);
+      delete xySerieses[ID];
+    }
+
+    /**
+      add a wildcard field, which has a series per element
+      ID key of the field, with "[*]" in its path
+    */
+    function addWildcard(ID) {
+      var pattern = ID.replace(/[.*+?^${}()|[\]\\]/g, "\\$&")
+                      .replace("\\[\\*\\]", "\\[\\d+\\]");
+      wildcards[ID] = new RegExp("^" + pattern + "$");
+    }
+
+    /**
+      get the wildcard field of an element series
+      ID key of the element series
+      return: key of the wildcard field, or empty if none
+    */
+    function wildcardOf(ID) {
+      var keys = Object.keys(wildcards);
+      for (var i = 0; i < keys.length; i++)
+      {
+        if (wildcards[keys[i]].test(ID))
+          return keys[i];
+      }
+      return "";
+    }
+
     /**
       delete a field series by its ID
       ID field path
     */
     function deleteSeries(ID) {
+      // remove the series of all the elements of a wildcard field
+      if (ID in wildcards)
+      {
+        Object.keys(serieses).forEach(function(key) {
+          if (wildcards[ID].test(key))
+            deleteSeries(key);
+        });
+        delete wildcards[ID];
+        return;
+      }
+
       // remove the points of the series from the chart
       removeSeries(serieses[ID]);
       // remove the series key from the serieses map
@@ -553,6 +808,153 @@ Rectangle {
       chart.updateHoverText();
     }
 
+    /**
+      new points of a specific field are stored in the PlottingInterface,
+      expand the axes to show them and refresh the chart
+      _fieldID field ID or Path
+      _minX, _maxX, _minY, _maxY bounds of the new points
+    */
+    function seriesUpdated(_fieldID, _minX, _maxX, _minY, _maxY)
+    {
+      var series = chart.serieses[_fieldID];
+      if (!series)
+      {
+        // first points of an element of a wildcard field
+        if (!chart.wildcardOf(_fieldID))
+          return;
+
+        chart.addSeries(_fieldID, "");
+        series = chart.serieses[_fieldID];
+      }
+
+      // if these are the first points (if the chart is empty):
+      // set the min/max according to the points coordinates
+      // note: count == 2: because chart has 1 series by default to show plotting grid
+      if (chart.count === 2 && series.count === 0)
+      {
+        xAxis.min = _minX;
+        xAxis.max = _minX + 10;
+      }
+
+      // expand the chart boundries if needed
+      if (xAxis.max < _maxX)
+      {
+        xAxis.max = _maxX;
+        chart.scrollRight(chart.width * 0.0012);
+      }
+      if (xAxis.min > _minX)
+        xAxis.min = _minX;
+      if (yAxis.max < _maxY)
+        yAxis.max = _maxY;
+      if (yAxis.min > _minY)
+        yAxis.min = _minY;
+
+      chart.requestRefresh();
+      chart.updateHoverText();
+    }
+
+    /**
+      new points of an XY series are stored in the PlottingInterface,
+      expand the axes to show them and refresh the chart
+      _name XY series ID
+      _minX, _maxX, _minY, _maxY bounds of the new points
+    */
+    function xySeriesUpdated(_name, _minX, _maxX, _minY, _maxY)
+    {
+      var series = chart.xySerieses[_name];
+      if (!series)
+        return;
+
+      // first points of a chart without time serieses: fit the axes to them
+      if (series.count === 0 && Object.keys(chart.serieses).length === 0)
+      {
+        xAxis.min = _minX;
+        xAxis.max = _maxX;
+        yAxis.min = _minY;
+        yAxis.max = _maxY;
+      }
+
+      // expand the chart boundries if needed
+      if (xAxis.max < _maxX)
+        xAxis.max = _maxX;
+      if (xAxis.min > _minX)
+        xAxis.min = _minX;
+      if (yAxis.max < _maxY)
+        yAxis.max = _maxY;
+      if (yAxis.min > _minY)
+        yAxis.min = _minY;
+
+      chart.requestRefresh();
+      chart.updateHoverText();
+    }
+
+    /**
+      refresh all the serieses with the stored points of the visible range,
+      coalesced to once per frame
+    */
+    function requestRefresh()
+    {
+      Qt.callLater(chart.refresh);
+    }
+
+    /**
+      fill all the serieses with the stored points of the visible range,
+      decimated to a few points per pixel column
+    */
+    function refresh()
+    {
+      Object.keys(serieses).forEach(function(key) {
+        PlottingIface.updateSeries(serieses[key], chartID, key,
+                                   xAxis.min, xAxis.max, chart.plotArea.width);
+      });
+      Object.keys(xySerieses).forEach(function(key) {
+        PlottingIface.updateXYSeries(xySerieses[key], chartID, key,
+                                     xAxis.min, xAxis.max, yAxis.min, yAxis.max,
+                                     chart.plotArea.width, chart.plotArea.height);
+      });
+      chart.updateStats();
+    }
+
+    /**
+      format the statistics of a series
+      _stats map of the statistics values
+      return: one line text
+    */
+    function formatStats(_stats)
+    {
+      if (!_stats.count)
+        return "no samples";
+
+      return "min " + _stats.min.toPrecision(4) +
+             "  max " + _stats.max.toPrecision(4) +
+             "  mean " + _stats.mean.toPrecision(4) +
+             "  std " + _stats.std.toPrecision(4) +
+             "  rms " + _stats.rms.toPrecision(4) +
+             "  (" + _stats.count + ")";
+    }
+
+    /**
+      update the live readout of the statistics of all the serieses,
+      for all the samples and for the sliding window
+    */
+    function updateStats()
+    {
+      if (!statsText.visible)
+        return;
+
+      var lines = [];
+      Object.keys(serieses).forEach(function(key) {
+        var stats = PlottingIface.seriesStats(chartID, key);
+        if (stats.count === undefined)
+          return;
+
+        lines.push(serieses[key].name);
+        lines.push("  all:    " + chart.formatStats(stats));
+        lines.push("  window: " + chart.formatStats(stats.window));
+      });
+      statsText.text = lines.join("\n");
+    }
+
     width: parent.width
     anchors.bottom: parent.bottom
     anchors.top: infoRect.bottom
@@ -565,6 +967,9 @@ Rectangle {
 
     theme: (Material.theme == Material.Light) ? ChartView.ChartThemeLight: ChartView.ChartThemeDark
 
+    // the decimation depends on the plot width
+    onPlotAreaChanged: chart.requestRefresh()
+
     Text {
       id:hoverText
       visible: (chartMouse.flag && !multiChartsMode && chartMouse.containsMouse) ? true : false
@@ -618,6 +1023,8 @@ Rectangle {
 
           xHold = mouseX
           yHold = mouseY
+
+          chart.requestRefresh();
         }
         else
           chart.updateHoverText();
@@ -672,6 +1079,7 @@ Rectangle {
                           );
 
         chart.zoomIn(rect);
+        chart.requestRefresh();
       }
     }
 
@@ -718,6 +1126,19 @@ Rectangle {
       visible: (multiChartsMode) ? false : true
     }
 
+    Text {
+      id: statsText
+      visible: (statsCheckBox.checkState === Qt.Checked && !multiChartsMode)
+      anchors.left: chart.left
+      anchors.top: plotName.bottom
+      anchors.leftMargin: chart.plotArea.x + 10
+      anchors.topMargin: 10
+      textFormat: Text.PlainText
+      font.family: "Monospace"
+      color: (Material.theme == Material.Light) ? "black" : Material.color(Material.Grey,Material.Shade200)
+      onVisibleChanged: chart.updateStats()
+    }
+
     Text {
       id: hoverName
       anchors.centerIn: parent
@@ -737,4 +1158,49 @@ Rectangle {
     anchors.margins: 20
     text: "hover"
   }
+
+  TextField {
+    id: derivedInput
+    visible: (main.multiChartsMode) ? false : true
+    anchors.left: chart.left
+    anchors.bottom: chart.bottom
+    anchors.leftMargin: 20
+    anchors.bottomMargin: 10
+    width: Math.min(400, chart.width * 0.5)
+    selectByMouse: true
+    placeholderText: "name = expression of {fields}"
+    ToolTip.visible: hovered
+    ToolTip.delay: 1000
+    ToolTip.text: "Derived series, e.g. speed = hypot({/odom-twist-linear-x}, {/odom-twist-linear-y})\n" +
+                  "or XY series, e.g. path = xy({/pose-position-x}, {/pose-position-y}, 0.01)"
+
+    onAccepted: {
+      var separator = text.indexOf("=");
+      var name = (separator > 0) ? text.substring(0, separator).trim() : text.trim();
+      var expression = (separator > 0) ? text.substring(separator + 1).trim() : text.trim();
+
+      // xy({x field}, {y field}[, tolerance])
+      var xy = expression.match(/^xy\(\s*\{([^}]+)\}\s*,\s*\{([^}]+)\}\s*(?:,\s*([^)\s]+)\s*)?\)$/);
+      if (xy)
+      {
+        var tolerance = (xy[3] !== undefined) ? parseFloat(xy[3]) : 0;
+        if (!isNaN(tolerance) && infoRect.addXY(name, xy[1], xy[2], tolerance))
+          text = "";
+        return;
+      }
+
+      if (infoRect.addDerived(name, expression))
+        text = "";
+    }
+  }
+
+  CheckBox {
+    id: statsCheckBox;
+    visible: (main.multiChartsMode) ? false : true
+    checkState: Qt.Unchecked
+    anchors.right: chart.right
+    anchors.top: hoverCheckBox.bottom
+    anchors.rightMargin: 20
+    text: "stats"
+  }
 }
@@ -184,9 +184,50 @@ Rectangle
     charts[_chart].appendPoint(_fieldID, _x, _y);
   }
 
+  /**
+  notify a chart that new points of a series are stored
+  _chart: chart id
+  _fieldID: field path or id
+  _minX, _maxX, _minY, _maxY: bounds of the new points
+  */
+  function handleSeriesUpdated(_chart, _fieldID, _minX, _maxX, _minY, _maxY)
+  {
+    if (!charts[_chart])
+      return;
+
+    charts[_chart].seriesUpdated(_fieldID, _minX, _maxX, _minY, _maxY);
+  }
+
+  /**
+  handle the new points of an XY series
+  _chart: chart ID
+  _name: XY series ID
+  _minX, _maxX, _minY, _maxY: bounds of the new points
+  */
+  function handleXYSeriesUpdated(_chart, _name, _minX, _maxX, _minY, _maxY)
+  {
+    if (!charts[_chart])
+      return;
+
+    charts[_chart].xySeriesUpdated(_name, _minX, _maxX, _minY, _maxY);
+  }
+
+  /**
+  show the window of a completed capture on all the charts
+  _start, _end: time range of the captured window
+  */
+  function handleCaptureCompleted(_start, _end)
+  {
+    Object.keys(charts).forEach(function(key) {
+      charts[key].captureCompleted(_start, _end);
+    });
+  }
+
   Connections {
     target: PlottingIface
-    onPlot : handlePlot(_chart, _fieldID, _x, _y);
+    onSeriesUpdated : handleSeriesUpdated(_chart, _fieldID, _minX, _maxX, _minY, _maxY);
+    onXySeriesUpdated : handleXYSeriesUpdated(_chart, _name, _minX, _maxX, _minY, _maxY);
+    onCaptureCompleted : handleCaptureCompleted(_start, _end);
   }
 
 
@@ -240,7 +281,7 @@ Rectangle
   Rectangle {
     id : addBtn
 
-    anchors.right: openExport.left
+    anchors.right: openRecording.left
     anchors.top: parent.top
     anchors.margins: 15
 
@@ -297,6 +338,54 @@ Rectangle
     addChart();
   }
 
+  ToolButton {
+    id: openRecording
+    width: 40;
+    height: 40;
+    anchors.right: openExport.left
+    anchors.top: parent.top
+    anchors.margins: 15
+    onHoveredChanged: (opacity === 1) ? opacity = 0.8 : opacity = 1;
+
+    background: Rectangle{
+      anchors.fill: parent
+      radius: width/2 // circle
+
+      color: "transparent"
+      border.width: 1
+      border.color: Material.color(Material.Grey, Material.Shade500)
+    }
+
+    Text {
+      text: "\u21A5"
+      font.pixelSize: parent.width/2
+      color: Material.color(Material.Grey, Material.Shade500)
+      anchors.centerIn: parent
+    }
+
+    ToolTip.text: "Open recorded series (.csv, .bin)";
+    ToolTip.visible: openRecording.hovered
+    ToolTip.delay: 500
+    ToolTip.timeout: 1000
+
+    onClicked: recordingDialog.open();
+  }
+
+  FileDialog {
+    id: recordingDialog
+    title: "Open a recorded series"
+    nameFilters: ["Series files (*.csv *.bin)", "All files (*)"]
+
+    onAccepted: {
+      if (!charts[mainChartID])
+        return;
+
+      var name = PlottingIface.openRecording(mainChartID, file.toString());
+      if (name)
+        charts[mainChartID].addRecording(name);
+    }
+  }
+
   ToolButton {
     id: openExport
     width: 40;
@@ -414,43 +503,53 @@ Rectangle
       }
 
       /**
-      export all selected charts in the export window to that path
+      number of files which are still being exported
       */
-      function exportCSV(path)
-      {
-      for (var i = 0; i < chartImages.length; i++)
-      {
-        if (!chartImages[i].isSelected())
-          continue;
-
-        var chart = charts[chartImages[i].chartIndex];
-        var serieses = chart.getChart().getAllSerieses();
-        var chart_id = chart.chartID;
-
-        if (Object.keys(serieses).length === 0)
-          continue;
+      property int pendingExports: 0
 
+      /**
+      export all selected charts in the export window to that path in the
+      background, the window is closed once all the files are written
+      */
+      function exportSeries(path, format)
+      {
+        for (var i = 0; i < chartImages.length; i++)
+        {
+          if (!chartImages[i].isSelected())
+            continue;
 
-        // convert Serieses to Map of {series_name : points list}
-        // slots in cpp accepts QMap<QString, QVariant>
-        // QVariant could be a list instead of series object
+          var chart = charts[chartImages[i].chartIndex];
+          var serieses = chart.getChart().getAllSerieses();
 
-        var chartSerieses = {};
-        var seriesArray = [];
-        Object.keys(serieses).forEach(function(key) {
+          // the points are stored in cpp, only the series keys are sent
+          pendingExports += PlottingIface.exportSeries(path, chart.chartID,
+              Object.keys(serieses), format);
+        }
 
-          seriesArray = []
+        if (pendingExports > 0)
+          exportProgress.value = 0;
 
-          // convert Series to QList<QPointF>
-          for (var j =0; j < serieses[key].count; j++)
-            seriesArray.push(serieses[key].at(j));
+        return pendingExports > 0;
+      }
 
-          // add series
-          chartSerieses[key] = seriesArray;
-        });
+      Connections {
+        target: PlottingIface
+        onExportProgress: {
+          exportProgress.value = _progress;
+        }
+        onExportFinished: {
+          if (exportApp.pendingExports <= 0)
+            return;
 
-        return PlottingIface.exportCSV(path, chart_id, chartSerieses);
+          exportApp.pendingExports--;
+          if (exportApp.pendingExports == 0)
+            exportApp.close();
+        }
       }
+
+      onClosing: {
+        if (pendingExports > 0)
+          PlottingIface.cancelExport();
       }
 
       /**
@@ -500,7 +599,7 @@ Rectangle
           property string color: Material.primaryColor
 
           displayText: "Export to"
-          model: ["CSV"]
+          model: ["CSV", "Binary"]
 
           background: Rectangle {
             implicitWidth: 120
@@ -516,6 +615,14 @@ Rectangle
             fileDialog.open();
           }
         }
+        ProgressBar {
+          id: exportProgress
+          visible: exportApp.pendingExports > 0
+          anchors.verticalCenter: exportBtn.verticalCenter
+          anchors.left: cancelBtn.right
+          anchors.right: exportBtn.left
+          anchors.margins: 20
+        }
         Rectangle {
           id: cancelBtn
           color: Material.color(Material.Grey, Material.Shade600);
@@ -547,12 +654,7 @@ Rectangle
         options: FolderDialog.ShowDirsOnly
 
         onAccepted: {
-          if (exportBtn.currentText == "CSV")
-          {
-            var success = exportApp.exportCSV(folder);
-            if (success)
-              exportApp.close();
-          }
+          exportApp.exportSeries(folder, exportBtn.currentText);
         }
         onRejected: fileDialog.close();
       }
@@ -15,7 +15,27 @@
  *
 */
 
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <set>
 #include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <QRegularExpression>
+#include <QtCharts/QXYSeries>
+
 #include <ignition/common/Console.hh>
 #include <ignition/common/StringUtils.hh>
 #include <ignition/transport/Node.hh>
@@ -24,36 +44,387 @@
 
 #include "ignition/gui/PlottingInterface.hh"
 #include "ignition/gui/Application.hh"
+#include "ignition/gui/RecordedSeries.hh"
+#include "ignition/gui/SeriesDecimator.hh"
+#include "ignition/gui/SeriesExport.hh"
+#include "ignition/gui/SeriesExpression.hh"
+#include "ignition/gui/SeriesJoin.hh"
+#include "ignition/gui/SeriesStats.hh"
+#include "ignition/gui/TimeSeries.hh"
 
 #define DEFAULT_TIME (INT_MIN)
-// 1/60 Period like the GuiSystem frequency (60Hz)
-#define MAX_PERIOD_DIFF (0.0166666667)
+// Max number of samples of a field queued between two flushes to the UI.
+// Drained at the refresh rate, this keeps up with a field sampled at
+// ~250 kHz for 96 KB per field.
+#define QUEUE_CAPACITY (4096)
+// Rate in Hz of flushing the buffered samples to the UI
+#define REFRESH_RATE (60.0)
+// Default duration in seconds of the statistics sliding window
+#define STATS_WINDOW (10.0)
+// Owner chart of the series shared by all the charts plotting a field
+#define SHARED_SERIES (-1)
 
 namespace ignition
 {
 namespace gui
 {
+class PlottingClockPrivate
+{
+  /// \brief Time source
+  public: std::atomic<PlottingTimeSource> source{PlottingTimeSource::HEADER};
+
+  /// \brief Start of the wall clock time, in steady clock ticks
+  public: std::atomic<std::chrono::steady_clock::rep> start{0};
+
+  /// \brief Latest simulation time in seconds
+  public: std::atomic<double> simTime{0};
+};
+
 class PlotDataPrivate
 {
-  /// \brief Value of that field
-  public: double value;
+  /// \brief Value of that field, written by the transport thread
+  public: std::atomic<double> value{0};
 
-  /// \brief arrival time (header time)
-  public: double time = DEFAULT_TIME;
+  /// \brief arrival time (header time), written by the transport thread
+  public: std::atomic<double> time{DEFAULT_TIME};
 
   /// \brief Registered Charts to that field
   public: std::set<int> charts;
 };
 
 
+/// \brief Field path resolved against a message descriptor.
+/// Holds the chain of field descriptors that leads from the root message
+/// to a plottable scalar, so values can be read with no string parsing or
+/// name lookups in the message callback.
+/// Repeated fields are reached with an index, e.g. "pose[3]-position-x", or
+/// with a wildcard which reads all the elements, e.g. "data[*]". A path has
+/// at most one wildcard, and no repeated field after it.
+class FieldAccessor
+{
+  /// \brief Index of a step through a singular field
+  public: static const int kSingular = -1;
+
+  /// \brief Index of a step through all the elements of a repeated field
+  public: static const int kWildcard = -2;
+
+  /// \brief Step of a field path
+  public: class Step
+  {
+    /// \brief Field to step through
+    public: const google::protobuf::FieldDescriptor *field = nullptr;
+
+    /// \brief Element index of a repeated field, kSingular or kWildcard
+    public: int index = kSingular;
+  };
+
+  /// \brief Resolve a field path against a message descriptor
+  /// \param[in] _descriptor Descriptor of the root message
+  /// \param[in] _path Field path separated by '-', e.g. "pose-position-x"
+  /// \return True if the path leads to a plottable field
+  public: bool Compile(const google::protobuf::Descriptor *_descriptor,
+                       const std::string &_path);
+
+  /// \brief Read the value of the field from a message, for paths without
+  /// wildcard
+  /// \param[in] _msg Message with the descriptor used to compile
+  /// \param[out] _value Plottable value as double
+  /// \return False if an indexed element doesn't exist in the message
+  public: bool Value(const google::protobuf::Message &_msg,
+                     double &_value) const;
+
+  /// \brief Read the values of all the elements of the wildcard field from
+  /// a message. A repeated scalar field is copied in one pass from its
+  /// contiguous storage.
+  /// \param[in] _msg Message with the descriptor used to compile
+  /// \param[out] _values Plottable values as double, indexed by element
+  /// \return False if an indexed element doesn't exist in the message
+  public: bool Values(const google::protobuf::Message &_msg,
+                      std::vector<double> &_values) const;
+
+  /// \brief Descriptor that the accessor has been compiled against
+  public: const google::protobuf::Descriptor *descriptor = nullptr;
+
+  /// \brief Message fields to walk through to reach the leaf message
+  public: std::vector<Step> path;
+
+  /// \brief Plottable field within the leaf message
+  public: Step leaf;
+
+  /// \brief Position of the wildcard step in the path, path.size() for the
+  /// leaf, -1 if there's no wildcard
+  public: int wildcard = -1;
+
+  /// \brief True if the path is resolved to a plottable field
+  public: bool valid = false;
+};
+
+/// \brief Samples of a field buffered until the next flush to the UI
+class PlotBuffer
+{
+  /// \brief Sample times
+  public: QVector<double> x;
+
+  /// \brief Sample values
+  public: QVector<double> y;
+};
+
+/// \brief Applies the sampling policy of a field to its incoming samples
+class FieldSampler
+{
+  /// \brief Feed a sample to the sampler
+  /// \param[in] _time Sample time
+  /// \param[in] _value Sample value
+  /// \param[out] _outTime Time of the captured sample
+  /// \param[out] _outValue Value of the captured sample
+  /// \return True if a sample is captured. Aggregated samples are captured
+  /// once the first sample of the next period arrives.
+  public: bool Sample(double _time, double _value,
+                      double &_outTime, double &_outValue);
+
+  /// \brief Drop the pending period
+  public: void Reset();
+
+  /// \brief Sampling policy
+  public: SamplingPolicy policy;
+
+  /// \brief True if a period is started
+  public: bool started = false;
+
+  /// \brief Start time of the current period
+  public: double periodStart = 0;
+
+  /// \brief Time of the aggregated sample of the current period
+  public: double aggTime = 0;
+
+  /// \brief Value of the aggregated sample of the current period
+  public: double aggValue = 0;
+
+  /// \brief Sum of the values of the current period
+  public: double sum = 0;
+
+  /// \brief Number of the samples of the current period
+  public: int count = 0;
+};
+
+/// \brief Sample passed from the transport thread to the GUI thread
+class Sample
+{
+  /// \brief Sample time
+  public: double x;
+
+  /// \brief Sample value
+  public: double y;
+
+  /// \brief Element index for wildcard fields, 0 otherwise
+  public: int index = 0;
+};
+
+/// \brief Fixed capacity lock-free queue of samples, with a single producer,
+/// the topic callback, and a single consumer, the GUI thread flushing the
+/// samples to the UI. The transport may run the callbacks of a topic on
+/// several threads at once, so they are serialized by the topic callback
+/// mutex to keep a single producer.
+class SampleQueue
+{
+  /// \brief Constructor
+  /// \param[in] _capacity Max number of queued samples
+  public: explicit SampleQueue(std::size_t _capacity)
+    : samples(_capacity + 1)
+  {
+  }
+
+  /// \brief Queue a sample, called by the producer only
+  /// \param[in] _sample Sample to queue
+  /// \return False if the queue is full, the sample is dropped
+  public: bool Push(const Sample &_sample);
+
+  /// \brief Move all the queued samples out, called by the consumer only
+  /// \param[out] _samples Vector to append the samples to
+  public: void PopAll(std::vector<Sample> &_samples);
+
+  /// \brief Ring buffer of the samples, with one empty slot to tell a full
+  /// queue from an empty one
+  public: std::vector<Sample> samples;
+
+  /// \brief Position of the next sample to pop, written by the consumer
+  public: alignas(64) std::atomic<std::size_t> head{0};
+
+  /// \brief Position of the next sample to push, written by the producer
+  public: alignas(64) std::atomic<std::size_t> tail{0};
+
+  /// \brief Number of samples dropped because the queue was full
+  public: std::atomic<std::uint64_t> dropped{0};
+};
+
+/// \brief Registered field, shared by the registration snapshots while it
+/// stays registered. The GUI thread owns the plot data charts and pops the
+/// queue, the topic callback owns the accessor and the sampler and pushes
+/// to the queue, under the topic callback mutex.
+class FieldChannel
+{
+  /// \brief Field path
+  public: std::string path;
+
+  /// \brief Full field ID sent to the UI: "topic-field"
+  public: QString id;
+
+  /// \brief True if the path has a wildcard, each element is then sent to
+  /// the UI as a series with the wildcard replaced by the element index
+  public: bool wildcard = false;
+
+  /// \brief Plot data of the field, the first element for wildcard paths
+  public: PlotData data;
+
+  /// \brief IDs of the charts plotting the field, kept in sync with the
+  /// plot data charts so flushing doesn't rebuild them
+  public: QVector<int> charts;
+
+  /// \brief Captured samples waiting to be flushed to the UI
+  public: SampleQueue queue{QUEUE_CAPACITY};
+
+  /// \brief Message type which the accessor is compiled against
+  public: const google::protobuf::Descriptor *descriptor = nullptr;
+
+  /// \brief Compiled accessor of the field for the current message type
+  public: std::shared_ptr<const FieldAccessor> accessor;
+
+  /// \brief Sampler of each element of the field
+  public: std::vector<FieldSampler> samplers;
+
+  /// \brief Values read from the last message
+  public: std::vector<double> values;
+
+  /// \brief Version of the policies applied to the sampler
+  public: std::uint64_t policyVersion = 0;
+};
+
+/// \brief Registered field in a registration snapshot
+class RegisteredField
+{
+  /// \brief Channel of the field
+  public: std::shared_ptr<FieldChannel> channel;
+
+  /// \brief Sampling policy of the field
+  public: SamplingPolicy policy;
+};
+
+/// \brief Immutable snapshot of the registered fields of a topic.
+/// The GUI thread publishes a new snapshot on each registration change, and
+/// the transport thread picks up the latest one on each callback, so
+/// neither blocks the other.
+class Registration
+{
+  /// \brief Registered fields
+  public: std::vector<RegisteredField> fields;
+
+  /// \brief Version of the sampling policies, increased on each change
+  public: std::uint64_t policyVersion = 0;
+};
+
+/// \brief Dense registry of items keyed by name, giving each item an integer
+/// ID which indexes a flat array. IDs stay valid while the item is
+/// registered, and the slots of removed items are reused by the next added
+/// ones, so the arrays don't grow with subscription churn.
+template <typename T>
+class IdRegistry
+{
+  /// \brief Add an item
+  /// \param[in] _key Item name, which mustn't be registered already
+  /// \param[in] _item Item
+  /// \return ID of the item
+  public: int Add(const std::string &_key, T _item)
+  {
+    int id;
+    if (!this->freeIds.empty())
+    {
+      id = this->freeIds.back();
+      this->freeIds.pop_back();
+      this->items[id] = std::move(_item);
+      this->keys[id] = _key;
+    }
+    else
+    {
+      id = static_cast<int>(this->items.size());
+      this->items.push_back(std::move(_item));
+      this->keys.push_back(_key);
+    }
+    this->ids[_key] = id;
+    return id;
+  }
+
+  /// \brief Remove an item, freeing its slot
+  /// \param[in] _id Item ID
+  public: void Remove(int _id)
+  {
+    this->ids.erase(this->keys[_id]);
+    this->keys[_id].clear();
+    this->items[_id] = T();
+    this->freeIds.push_back(_id);
+  }
+
+  /// \brief Get the ID of an item
+  /// \param[in] _key Item name
+  /// \return Item ID, -1 if not registered
+  public: int Id(const std::string &_key) const
+  {
+    auto idIt = this->ids.find(_key);
+    return idIt == this->ids.end() ? -1 : idIt->second;
+  }
+
+  /// \brief Check if an ID refers to a registered item
+  /// \param[in] _id Item ID
+  /// \return True if registered
+  public: bool Valid(int _id) const
+  {
+    return _id >= 0 && _id < static_cast<int>(this->items.size()) &&
+           this->items[_id];
+  }
+
+  /// \brief Number of registered items
+  /// \return Item count
+  public: int Count() const
+  {
+    return static_cast<int>(this->ids.size());
+  }
+
+  /// \brief Items indexed by ID, empty for the free slots
+  public: std::vector<T> items;
+
+  /// \brief Item names indexed by ID
+  public: std::vector<std::string> keys;
+
+  /// \brief Item IDs keyed by name
+  public: std::unordered_map<std::string, int> ids;
+
+  /// \brief Free slots of the items
+  public: std::vector<int> freeIds;
+};
+
 class TopicPrivate
 {
-  /// \brief Check the plotable types and get data from reflection
-  /// \param[in] _msg Message to get data from
-  /// \param[in] _field Field within the message to get
-  /// \return Plottable value as double, zero if not plottable
-  public: double FieldData(const google::protobuf::Message &_msg,
-                           const google::protobuf::FieldDescriptor *_field);
+  /// \brief Get the compiled accessor of a field path for a message type,
+  /// compiling it if it isn't cached yet. Called by the transport thread.
+  /// \param[in] _descriptor Descriptor of the message type
+  /// \param[in] _path Field path
+  /// \return Compiled accessor, which may be invalid
+  public: std::shared_ptr<const FieldAccessor> Accessor(
+              const google::protobuf::Descriptor *_descriptor,
+              const std::string &_path);
+
+  /// \brief Publish a new registration snapshot from the registered fields.
+  /// Called by the GUI thread.
+  public: void Publish();
+
+  /// \brief Get the sampling policy of a field
+  /// \param[in] _path Field path
+  /// \return The field policy if set, otherwise the topic policy
+  public: SamplingPolicy Policy(const std::string &_path) const;
+
+  /// \brief Compile the accessors of the header against a new message type.
+  /// Called by the transport thread.
+  /// \param[in] _descriptor Descriptor of the message type
+  public: void Compile(const google::protobuf::Descriptor *_descriptor);
 
   /// \brief Topic name
   public: std::string name;
@@ -61,11 +432,51 @@ class TopicPrivate
   /// \brief Default Plotting time
   public: std::shared_ptr<double> plottingTime;
 
-  /// \brief Previous header time to limit the frequency of publishing
-  public: double lastHeaderTime = 0;
+  /// \brief Clock giving the time of the samples, overrides plottingTime
+  public: std::shared_ptr<const PlottingClock> clock;
+
+  /// \brief Channels of the registered fields, indexed by field ID
+  public: IdRegistry<std::shared_ptr<FieldChannel>> channels;
+
+  /// \brief Plot data of the registered fields keyed by path, rebuilt by
+  /// Topic::Fields
+  public: std::map<std::string, PlotData *> fieldMap;
+
+  /// \brief Sampling policy of the fields without their own policy
+  public: SamplingPolicy policy;
+
+  /// \brief Sampling policies of specific fields, keyed by field path
+  public: std::map<std::string, SamplingPolicy> fieldPolicies;
+
+  /// \brief Version of the sampling policies
+  public: std::uint64_t policyVersion = 1;
 
-  /// \brief Plotting fields to update its values
-  public: std::map<std::string, ignition::gui::PlotData*> fields;
+  /// \brief Latest registration snapshot, only accessed with the atomic
+  /// shared_ptr functions
+  public: std::shared_ptr<const Registration> registration;
+
+  /// \brief Cache of compiled accessors keyed by message type & field path,
+  /// owned by the topic callback
+  public: std::map<std::pair<const google::protobuf::Descriptor *,
+          std::string>, std::shared_ptr<const FieldAccessor>> accessors;
+
+  /// \brief Message type which the header is compiled against.
+  /// Null until the first message is received.
+  public: const google::protobuf::Descriptor *descriptor = nullptr;
+
+  /// \brief Compiled accessors of the header stamp seconds
+  public: std::shared_ptr<const FieldAccessor> headerSec;
+
+  /// \brief Compiled accessors of the header stamp nanoseconds
+  public: std::shared_ptr<const FieldAccessor> headerNsec;
+
+  /// \brief Header field of the compiled message type, null if it has none
+  public: const google::protobuf::FieldDescriptor *header = nullptr;
+
+  /// \brief Serializes the topic callbacks, which the transport may run
+  /// concurrently on its worker threads. Only the callbacks lock it, the
+  /// GUI thread flushes the queues without it.
+  public: std::mutex callbackMutex;
 };
 
 class TransportPrivate
@@ -73,8 +484,255 @@ class TransportPrivate
   /// \brief Node for Commincation
   public: ignition::transport::Node node;
 
-  /// \brief subscribed topics
-  public: std::map<std::string, ignition::gui::Topic*> topics;
+  /// \brief Subscribe a topic handler to its topic. The subscription
+  /// shares the ownership of the handler, so a callback still running on
+  /// the transport thread after unsubscribing keeps it alive.
+  /// \param[in] _topic Topic name
+  /// \param[in] _handler Topic handler
+  public: void Subscribe(const std::string &_topic,
+                         const std::shared_ptr<ignition::gui::Topic> &_handler);
+
+  /// \brief Subscribed topics, indexed by topic ID
+  public: IdRegistry<std::shared_ptr<ignition::gui::Topic>> topics;
+
+  /// \brief Subscribed topics keyed by name, rebuilt by Transport::Topics
+  public: std::map<std::string, ignition::gui::Topic *> topicMap;
+
+  /// \brief Clock given to the subscribed topics
+  public: std::shared_ptr<const PlottingClock> clock;
+
+  /// \brief Sampling policies keyed by topic & field path, with an empty
+  /// field path for the topic policy. Applied to topics on subscription.
+  public: std::map<std::pair<std::string, std::string>, SamplingPolicy>
+          policies;
+};
+
+/// \brief Evaluates the condition of the capture trigger on the samples of
+/// the trigger series as they are stored
+class TriggerDetector
+{
+  /// \brief Evaluate the condition on a stored sample
+  /// \param[in] _x x coordinate of the sample
+  /// \param[in] _y y coordinate of the sample
+  public: void Sample(double _x, double _y)
+  {
+    if (this->armed && !this->fired)
+    {
+      double threshold = this->trigger.threshold;
+      bool hit = false;
+      switch (this->trigger.condition)
+      {
+        case TriggerCondition::RISING:
+          hit = this->hasPrevious && this->previous < threshold &&
+                _y >= threshold;
+          break;
+        case TriggerCondition::FALLING:
+          hit = this->hasPrevious && this->previous > threshold &&
+                _y <= threshold;
+          break;
+        case TriggerCondition::LEVEL:
+          hit = _y >= threshold;
+          break;
+      }
+
+      if (hit)
+      {
+        this->fired = true;
+        this->time = _x;
+      }
+    }
+
+    this->hasPrevious = true;
+    this->previous = _y;
+    this->lastTime = _x;
+  }
+
+  /// \brief Trigger settings
+  public: CaptureTrigger trigger;
+
+  /// \brief True while waiting for the condition
+  public: bool armed = true;
+
+  /// \brief True once the condition is met, until the capture completes
+  public: bool fired = false;
+
+  /// \brief Time of the sample which met the condition
+  public: double time = 0;
+
+  /// \brief True once a sample has been evaluated
+  public: bool hasPrevious = false;
+
+  /// \brief Value of the previous sample
+  public: double previous = 0;
+
+  /// \brief Time of the last sample
+  public: double lastTime = std::numeric_limits<double>::lowest();
+};
+
+/// \brief Stored samples of a series plotted on a chart
+class StoredSeries
+{
+  /// \brief Constructor
+  /// \param[in] _capacity Max number of stored samples
+  /// \param[in] _window Duration of the statistics sliding window
+  public: StoredSeries(std::size_t _capacity, double _window)
+    : data(_capacity), windowStats(_window)
+  {
+  }
+
+  /// \brief Store a sample and update the bounds of the unflushed samples
+  /// \param[in] _x x coordinate of the sample
+  /// \param[in] _y y coordinate of the sample
+  public: void Append(double _x, double _y)
+  {
+    this->data.Append(_x, _y);
+    this->stats.Append(_x, _y);
+    this->windowStats.Append(_x, _y);
+    if (this->trigger)
+      this->trigger->Sample(_x, _y);
+
+    this->minX = std::min(this->minX, _x);
+    this->maxX = std::max(this->maxX, _x);
+    this->minY = std::min(this->minY, _y);
+    this->maxY = std::max(this->maxY, _y);
+    this->dirty = true;
+  }
+
+  /// \brief Reset the bounds of the unflushed samples
+  public: void ResetBounds()
+  {
+    this->minX = std::numeric_limits<double>::max();
+    this->maxX = std::numeric_limits<double>::lowest();
+    this->minY = std::numeric_limits<double>::max();
+    this->maxY = std::numeric_limits<double>::lowest();
+    this->dirty = false;
+  }
+
+  /// \brief Stored samples
+  public: TimeSeries data;
+
+  /// \brief Charts plotting the series, each with the decimator of its own
+  /// visible range
+  public: std::map<int, SeriesDecimator> views;
+
+  /// \brief Trigger evaluated on the samples, if this is the trigger series
+  public: TriggerDetector *trigger = nullptr;
+
+  /// \brief Samples of the last capture, drawn instead of the stored
+  /// samples in the triggered capture mode
+  public: std::unique_ptr<TimeSeries> capture;
+
+  /// \brief Statistics of all the received samples
+  public: SeriesStats stats;
+
+  /// \brief Statistics of the samples in the sliding window
+  public: SeriesStats windowStats;
+
+  /// \brief True if samples were stored since the last flush
+  public: bool dirty = false;
+
+  /// \brief Min x coordinate of the samples stored since the last flush
+  public: double minX = std::numeric_limits<double>::max();
+
+  /// \brief Max x coordinate of the samples stored since the last flush
+  public: double maxX = std::numeric_limits<double>::lowest();
+
+  /// \brief Min y coordinate of the samples stored since the last flush
+  public: double minY = std::numeric_limits<double>::max();
+
+  /// \brief Max y coordinate of the samples stored since the last flush
+  public: double maxY = std::numeric_limits<double>::lowest();
+};
+
+/// \brief Stored points of a field plotted against another one
+class StoredXYSeries
+{
+  /// \brief Constructor
+  /// \param[in] _xFieldID ID of the field of the x coordinates
+  /// \param[in] _yFieldID ID of the field of the y coordinates
+  /// \param[in] _tolerance Max time difference of paired samples
+  /// \param[in] _capacity Max number of stored points
+  public: StoredXYSeries(const QString &_xFieldID, const QString &_yFieldID,
+                         double _tolerance, std::size_t _capacity)
+    : xFieldID(_xFieldID), yFieldID(_yFieldID), join(_tolerance),
+      x(_capacity), y(_capacity)
+  {
+  }
+
+  /// \brief Store a point and expand the bounds of the unflushed points
+  /// \param[in] _time Time of the point
+  /// \param[in] _x x coordinate
+  /// \param[in] _y y coordinate
+  public: void Append(double _time, double _x, double _y)
+  {
+    this->x.Append(_time, _x);
+    this->y.Append(_time, _y);
+
+    this->minX = std::min(this->minX, _x);
+    this->maxX = std::max(this->maxX, _x);
+    this->minY = std::min(this->minY, _y);
+    this->maxY = std::max(this->maxY, _y);
+    this->dirty = true;
+  }
+
+  /// \brief Reset the bounds of the unflushed points
+  public: void ResetBounds()
+  {
+    this->minX = std::numeric_limits<double>::max();
+    this->maxX = std::numeric_limits<double>::lowest();
+    this->minY = std::numeric_limits<double>::max();
+    this->maxY = std::numeric_limits<double>::lowest();
+    this->dirty = false;
+  }
+
+  /// \brief ID of the field of the x coordinates
+  public: QString xFieldID;
+
+  /// \brief ID of the field of the y coordinates
+  public: QString yFieldID;
+
+  /// \brief Pairs the samples of the fields
+  public: SeriesJoin join;
+
+  /// \brief Joined series, to restart joining if they are replaced
+  public: const TimeSeries *xInput = nullptr;
+
+  /// \brief Joined series, to restart joining if they are replaced
+  public: const TimeSeries *yInput = nullptr;
+
+  /// \brief x coordinates of the points, at the time of each point
+  public: TimeSeries x;
+
+  /// \brief y coordinates of the points, at the time of each point
+  public: TimeSeries y;
+
+  /// \brief True if points were stored since the last flush
+  public: bool dirty = false;
+
+  /// \brief Min x coordinate of the points stored since the last flush
+  public: double minX = std::numeric_limits<double>::max();
+
+  /// \brief Max x coordinate of the points stored since the last flush
+  public: double maxX = std::numeric_limits<double>::lowest();
+
+  /// \brief Min y coordinate of the points stored since the last flush
+  public: double minY = std::numeric_limits<double>::max();
+
+  /// \brief Max y coordinate of the points stored since the last flush
+  public: double maxY = std::numeric_limits<double>::lowest();
+};
+
+/// \brief Series to be exported to a file by the export thread
+class ExportJob
+{
+  /// \brief File path
+  public: std::string path;
+
+  /// \brief Samples to export
+  public: SeriesSnapshot series;
+
+  /// \brief File format
+  public: SeriesFormat format = SeriesFormat::CSV;
 };
 
 class PlottingIfacePrivate
@@ -85,11 +743,105 @@ class PlottingIfacePrivate
   /// \brief Plotting time pointer to give access to topics to read it
   public: std::shared_ptr<double> plottingTimeRef = std::make_shared<double>();
 
-  /// \brief timeout to update the plot with the timer
-  public: int timeout;
+  /// \brief Clock giving the time of the samples
+  public: std::shared_ptr<PlottingClock> clock =
+          std::make_shared<PlottingClock>();
+
+  /// \brief Node receiving the simulation time
+  public: ignition::transport::Node node;
+
+  /// \brief Topic of the simulation time, empty if none
+  public: std::string simTimeTopic;
+
+  /// \brief Message type which the sim time accessors are compiled against
+  public: const google::protobuf::Descriptor *simTimeDescriptor = nullptr;
+
+  /// \brief Accessor of the sim time seconds
+  public: FieldAccessor simTimeSec;
+
+  /// \brief Accessor of the sim time nanoseconds
+  public: FieldAccessor simTimeNsec;
+
+  /// \brief timer to flush the buffered samples to the UI once per frame
+  public: QTimer refreshTimer;
+
+  /// \brief Rate in Hz of flushing the buffered samples to the UI
+  public: double refreshRate = REFRESH_RATE;
+
+  /// \brief Get a stored series, creating it if it doesn't exist, and add
+  /// a chart to its views
+  /// \param[in] _owner Owner chart ID, SHARED_SERIES for the fields
+  /// \param[in] _fieldID field path ID
+  /// \param[in] _chart Chart plotting the series
+  /// \return Stored series
+  public: StoredSeries &Series(int _owner, const QString &_fieldID,
+                               int _chart);
+
+  /// \brief Remove a chart from the views of a field series, removing the
+  /// series once no chart plots it
+  /// \param[in] _chart chart ID
+  /// \param[in] _fieldID field path ID
+  public: void RemoveView(int _chart, const QString &_fieldID);
+
+  /// \brief Find a series plotted by a chart, either a derived series of
+  /// the chart or a field series
+  /// \param[in] _chart chart ID
+  /// \param[in] _fieldID field path ID
+  /// \return Stored series, null if the chart doesn't plot it
+  public: StoredSeries *Find(int _chart, const QString &_fieldID) const;
+
+  /// \brief Evaluate the derived series on the samples stored since the
+  /// last update
+  public: void UpdateDerived();
+
+  /// \brief Join the fields of the XY series on the samples stored since
+  /// the last update
+  public: void UpdateXY();
+
+  /// \brief Stored samples of each series, keyed by owner chart and field
+  /// ID. The fields are stored once, owned by SHARED_SERIES, however many
+  /// charts plot them. The derived series are owned by their chart.
+  public: std::map<std::pair<int, QString>, std::unique_ptr<StoredSeries>>
+          series;
+
+  /// \brief Max number of samples stored per series
+  public: std::size_t seriesCapacity = 1 << 20;
+
+  /// \brief Trigger of the captures, null in the continuous mode
+  public: std::unique_ptr<TriggerDetector> trigger;
 
-  /// \brief timer to update the plotting each time step
-  public: QTimer timer;
+  /// \brief Expressions of the derived series, keyed by chart and series ID
+  public: std::map<std::pair<int, QString>, std::unique_ptr<SeriesExpression>>
+          derived;
+
+  /// \brief Points of the XY series, keyed by chart and series ID
+  public: std::map<std::pair<int, QString>, std::unique_ptr<StoredXYSeries>>
+          xySeries;
+
+  /// \brief Series opened from files, keyed by chart and series ID
+  public: std::map<std::pair<int, QString>, std::unique_ptr<RecordedSeries>>
+          recordings;
+
+  /// \brief Recorded series whose charts are notified on the next flush
+  public: std::set<std::pair<int, QString>> openedRecordings;
+
+  /// \brief Duration of the statistics sliding window in seconds
+  public: double statsWindow = STATS_WINDOW;
+
+  /// \brief Thread writing the queued exports
+  public: std::thread exportThread;
+
+  /// \brief Protects the export queue and flag
+  public: std::mutex exportMutex;
+
+  /// \brief Exports waiting to be written
+  public: std::deque<ExportJob> exportJobs;
+
+  /// \brief True while the export thread is running
+  public: bool exporting = false;
+
+  /// \brief Set to cancel the running and queued exports
+  public: std::atomic<bool> exportCancel{false};
 };
 
 }
@@ -98,6 +850,67 @@ class PlottingIfacePrivate
 using namespace ignition;
 using namespace gui;
 
+//////////////////////////////////////////////////////
+PlottingClock::PlottingClock() :
+    dataPtr(std::make_unique<PlottingClockPrivate>())
+{
+  this->Reset();
+}
+
+//////////////////////////////////////////////////////
+PlottingClock::~PlottingClock()
+{
+}
+
+//////////////////////////////////////////////////////
+void PlottingClock::SetSource(PlottingTimeSource _source)
+{
+  this->dataPtr->source = _source;
+}
+
+//////////////////////////////////////////////////////
+PlottingTimeSource PlottingClock::Source() const
+{
+  return this->dataPtr->source;
+}
+
+//////////////////////////////////////////////////////
+void PlottingClock::Reset()
+{
+  this->dataPtr->start =
+      std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+//////////////////////////////////////////////////////
+double PlottingClock::WallTime() const
+{
+  std::chrono::steady_clock::duration elapsed(
+      std::chrono::steady_clock::now().time_since_epoch().count() -
+      this->dataPtr->start);
+  return std::chrono::duration<double>(elapsed).count();
+}
+
+//////////////////////////////////////////////////////
+void PlottingClock::SetSimTime(double _time)
+{
+  this->dataPtr->simTime = _time;
+}
+
+//////////////////////////////////////////////////////
+double PlottingClock::SimTime() const
+{
+  return this->dataPtr->simTime;
+}
+
+//////////////////////////////////////////////////////
+double PlottingClock::Now() const
+{
+  if (this->dataPtr->source == PlottingTimeSource::SIM)
+    return this->SimTime();
+
+  return this->WallTime();
+}
+
 //////////////////////////////////////////////////////
 PlotData::PlotData() :
     dataPtr(std::make_unique<PlotDataPrivate>())
@@ -170,8 +983,6 @@ Topic::Topic(const std::string &_name) : QObject(),
 //////////////////////////////////////////////////////
 Topic::~Topic()
 {
-  for (auto field : this->dataPtr->fields)
-    delete field.second;
 }
 
 //////////////////////////////////////////////////////
@@ -183,126 +994,199 @@ std::string &Topic::Name() const
 //////////////////////////////////////////////////////
 void Topic::Register(const std::string &_fieldPath, int _chart)
 {
-  // if a new field create a new field and register the chart
-  if (this->dataPtr->fields.count(_fieldPath) == 0)
-    this->dataPtr->fields[_fieldPath] = new PlotData();
+  auto &channels = this->dataPtr->channels;
+
+  // if a new field create a new channel and register the chart
+  int id = channels.Id(_fieldPath);
+  if (id < 0)
+  {
+    auto channel = std::make_shared<FieldChannel>();
+    channel->path = _fieldPath;
+    channel->id = QString::fromStdString(this->dataPtr->name + "-" +
+        _fieldPath);
+    channel->wildcard = _fieldPath.find("[*]") != std::string::npos;
+    channel->data.AddChart(_chart);
+    channel->charts.append(_chart);
+    channels.Add(_fieldPath, std::move(channel));
+    this->dataPtr->Publish();
+    return;
+  }
+
+  auto &channel = *channels.items[id];
+  if (channel.data.Charts().count(_chart))
+    return;
 
-  this->dataPtr->fields[_fieldPath]->AddChart(_chart);
+  channel.data.AddChart(_chart);
+  channel.charts.append(_chart);
 }
 
 //////////////////////////////////////////////////////
 void Topic::UnRegister(const std::string &_fieldPath, int _chart)
 {
-  this->dataPtr->fields[_fieldPath]->RemoveChart(_chart);
+  auto &channels = this->dataPtr->channels;
+
+  int id = channels.Id(_fieldPath);
+  if (id < 0)
+    return;
+
+  auto &channel = *channels.items[id];
+  channel.data.RemoveChart(_chart);
+  channel.charts.removeAll(_chart);
 
-  // if no one registers to the field, remove it
-  if (!this->dataPtr->fields[_fieldPath]->ChartCount())
-    this->dataPtr->fields.erase(_fieldPath);
+  // if no one registers to the field, remove it. The transport thread may
+  // still be using the channel through the previous snapshot, which keeps
+  // it alive until the callback returns.
+  if (!channel.data.ChartCount())
+  {
+    channels.Remove(id);
+    this->dataPtr->Publish();
+  }
 }
 
 //////////////////////////////////////////////////////
 int Topic::FieldCount() const
 {
-  return this->dataPtr->fields.size();
+  return this->dataPtr->channels.Count();
 }
 
 //////////////////////////////////////////////////////
-std::map<std::string, PlotData*> &Topic::Fields()
+int Topic::FieldId(const std::string &_fieldPath) const
 {
-  return this->dataPtr->fields;
+  return this->dataPtr->channels.Id(_fieldPath);
 }
 
 //////////////////////////////////////////////////////
-void Topic::Callback(const google::protobuf::Message &_msg)
+PlotData *Topic::FieldById(int _id)
 {
-  // check for header time
-  double headerTime;
-  if (!this->HasHeader(_msg, headerTime))
-  {
-    if (!this->dataPtr->plottingTime)
-        return;
+  if (!this->dataPtr->channels.Valid(_id))
+    return nullptr;
 
-    headerTime = DEFAULT_TIME;
-
-    if (*this->dataPtr->plottingTime - this->dataPtr->lastHeaderTime
-          < MAX_PERIOD_DIFF)
-      return;
+  return &this->dataPtr->channels.items[_id]->data;
+}
 
-    this->dataPtr->lastHeaderTime = *this->dataPtr->plottingTime;
+//////////////////////////////////////////////////////
+std::map<std::string, PlotData*> &Topic::Fields()
+{
+  auto &fields = this->dataPtr->fieldMap;
+  fields.clear();
+  for (auto const &channel : this->dataPtr->channels.items)
+  {
+    if (channel)
+      fields[channel->path] = &channel->data;
   }
-  else
-  {
-    if (headerTime - this->dataPtr->lastHeaderTime < MAX_PERIOD_DIFF)
-        return;
-
-    this->dataPtr->lastHeaderTime = headerTime;
-  }
-
-  // loop over the registered fields and update them
-  for (auto fieldIt : this->dataPtr->fields)
-  {
-    auto msgDescriptor = _msg.GetDescriptor();
-    auto ref = _msg.GetReflection();
+  return fields;
+}
 
-    google::protobuf::Message *valueMsg = nullptr;
+//////////////////////////////////////////////////////
+void Topic::Callback(const google::protobuf::Message &_msg)
+{
+  // the callback works on the latest registration snapshot, so the GUI
+  // thread never waits for it
+  auto registration = std::atomic_load(&this->dataPtr->registration);
+  if (!registration)
+    return;
 
-    auto fieldFullPath = ignition::common::Split(fieldIt.first, '-');
-    int pathSize = fieldFullPath.size();
+  // the accessors, samplers and queues have a single producer at a time
+  std::lock_guard<std::mutex> lock(this->dataPtr->callbackMutex);
 
-    // loop until you reach the last field in the path
-    for (int i = 0; i < pathSize-1 ; i++)
-    {
-      std::string fieldName = fieldFullPath[i];
+  // the header is compiled against the first received message type, and
+  // recompiled if the publisher's message type changes
+  if (_msg.GetDescriptor() != this->dataPtr->descriptor)
+    this->dataPtr->Compile(_msg.GetDescriptor());
 
-      auto field = msgDescriptor->FindFieldByName(fieldName);
+  // check for header time
+  double headerTime = DEFAULT_TIME;
+  bool hasHeader = this->HasHeader(_msg, headerTime);
+
+  // msgs without header, or all msgs if the clock isn't header based, are
+  // plotted at the current plotting time
+  auto const &clock = this->dataPtr->clock;
+  bool useHeader = hasHeader &&
+      (!clock || clock->Source() == PlottingTimeSource::HEADER);
+
+  double plotTime;
+  if (useHeader)
+    plotTime = headerTime;
+  else if (clock)
+    plotTime = clock->Now();
+  else if (this->dataPtr->plottingTime)
+    plotTime = *this->dataPtr->plottingTime;
+  else
+    return;
 
-      msgDescriptor = field->message_type();
+  // loop over the registered fields and update them with the samples
+  // captured by their sampling policies
+  for (auto const &field : registration->fields)
+  {
+    auto &channel = *field.channel;
 
-      if (valueMsg)
-      {
-        valueMsg = ref->MutableMessage
-                (const_cast<google::protobuf::Message *>(valueMsg), field);
-      }
-      else
+    if (channel.policyVersion != registration->policyVersion)
+    {
+      for (auto &sampler : channel.samplers)
       {
-        valueMsg = ref->MutableMessage
-                (const_cast<google::protobuf::Message *>(&_msg), field);
+        sampler.policy = field.policy;
+        sampler.Reset();
       }
+      channel.policyVersion = registration->policyVersion;
+    }
 
-      if (valueMsg)
-        ref = valueMsg->GetReflection();
-      else
+    if (channel.descriptor != _msg.GetDescriptor())
+    {
+      channel.descriptor = _msg.GetDescriptor();
+      channel.accessor = this->dataPtr->Accessor(channel.descriptor,
+                                                 channel.path);
+      if (!channel.accessor->valid)
       {
-        ignwarn << "Invalid topic msg" << std::endl;
-        return;
+        ignwarn << "Field [" << channel.path << "] of topic ["
+                << this->dataPtr->name
+                << "] is not plottable in message type ["
+                << channel.descriptor->full_name() << "]" << std::endl;
       }
     }
 
-    std::string fieldName = fieldFullPath[pathSize-1];
-    double data;
+    if (!channel.accessor->valid)
+      continue;
 
-    if (valueMsg)
+    // read the field, or all the elements of a wildcard field
+    auto &values = channel.values;
+    if (channel.accessor->wildcard >= 0)
     {
-      auto field = valueMsg->GetDescriptor()->FindFieldByName(fieldName);
-      data = this->dataPtr->FieldData(*valueMsg, field);
+      if (!channel.accessor->Values(_msg, values))
+        continue;
     }
     else
     {
-      auto field = msgDescriptor->FindFieldByName(fieldName);
-      data = this->dataPtr->FieldData(_msg, field);
+      values.resize(1);
+      if (!channel.accessor->Value(_msg, values[0]))
+        continue;
     }
 
-    if (!fieldIt.second)
-      continue;
+    // new elements start with the field policy
+    while (channel.samplers.size() < values.size())
+    {
+      channel.samplers.emplace_back();
+      channel.samplers.back().policy = field.policy;
+    }
+
+    for (std::size_t e = 0; e < values.size(); ++e)
+    {
+      double time;
+      double value;
+      if (!channel.samplers[e].Sample(plotTime, values[e], time, value))
+        continue;
 
-    // Field Arrival Time
-    fieldIt.second->SetTime(headerTime);
+      if (e == 0)
+      {
+        // Field Arrival Time
+        channel.data.SetTime(useHeader ? time : DEFAULT_TIME);
 
-    // Field Value
-    fieldIt.second->SetValue(data);
+        // Field Value
+        channel.data.SetValue(value);
+      }
 
-    // Update Field Charts UI
-    this->UpdateGui(fieldIt.first);
+      // Queue the sample until the next flush to the UI
+      channel.queue.Push({time, value, static_cast<int>(e)});
+    }
   }
 }
 
@@ -310,37 +1194,25 @@ void Topic::Callback(const google::protobuf::Message &_msg)
 bool Topic::HasHeader(const google::protobuf::Message &_msg,
                       double &_headerTime)
 {
-  auto ref = _msg.GetReflection();
-  auto header = _msg.GetDescriptor()->FindFieldByName("header");
-  auto found = ref->HasField(_msg, header);
-
-  if (!found)
-    return false;
-
-  auto stamp = header->message_type()->FindFieldByName("stamp");
+  if (_msg.GetDescriptor() != this->dataPtr->descriptor)
+    this->dataPtr->Compile(_msg.GetDescriptor());
 
-  if (!stamp)
+  if (!this->dataPtr->header || !this->dataPtr->headerSec->valid ||
+      !this->dataPtr->headerNsec->valid)
+  {
     return false;
+  }
 
-  auto headerMsg = ref->MutableMessage
-          (const_cast<google::protobuf::Message *>(&_msg), header);
-
-  if (!headerMsg)
+  if (!_msg.GetReflection()->HasField(_msg, this->dataPtr->header))
     return false;
 
-  ref = headerMsg->GetReflection();
-
-  auto stampMsg = ref->MutableMessage
-          (const_cast<google::protobuf::Message *>(headerMsg), stamp);
-
-  if (!stampMsg)
+  double sec = 0;
+  double nsec = 0;
+  if (!this->dataPtr->headerSec->Value(_msg, sec) ||
+      !this->dataPtr->headerNsec->Value(_msg, nsec))
+  {
     return false;
-
-  auto secField = stamp->message_type()->FindFieldByName("sec");
-  auto nsecField = stamp->message_type()->FindFieldByName("nsec");
-
-  auto sec = this->dataPtr->FieldData(*stampMsg, secField);
-  auto nsec = this->dataPtr->FieldData(*stampMsg, nsecField);
+  }
 
   _headerTime = sec + nsec * std::pow(10, -9);
 
@@ -350,7 +1222,9 @@ bool Topic::HasHeader(const google::protobuf::Message &_msg,
 //////////////////////////////////////////////////////
 void Topic::UpdateGui(const std::string &_field)
 {
-  auto field = this->dataPtr->fields[_field];
+  auto field = this->FieldById(this->FieldId(_field));
+  if (!field)
+    return;
 
   auto x = field->Time();
   auto y = field->Value();
@@ -364,6 +1238,59 @@ void Topic::UpdateGui(const std::string &_field)
     emit plot(chart, fieldFullPath, x, y);
 }
 
+//////////////////////////////////////////////////////
+void Topic::Flush()
+{
+  for (auto const &channelPtr : this->dataPtr->channels.items)
+  {
+    if (!channelPtr)
+      continue;
+
+    auto &channel = *channelPtr;
+
+    auto dropped = channel.queue.dropped.exchange(0);
+    if (dropped > 0)
+    {
+      ignwarn << "Dropped [" << dropped << "] samples of field ["
+              << channel.path << "] of topic [" << this->dataPtr->name
+              << "], they arrive faster than they are flushed" << std::endl;
+    }
+
+    std::vector<Sample> samples;
+    channel.queue.PopAll(samples);
+    if (samples.empty())
+      continue;
+
+    // split the samples per element
+    std::map<int, PlotBuffer> buffers;
+    PlotBuffer *buffer = nullptr;
+    int index = -1;
+    for (auto const &sample : samples)
+    {
+      if (sample.index != index)
+      {
+        index = sample.index;
+        buffer = &buffers[index];
+      }
+      buffer->x.append(sample.x);
+      buffer->y.append(sample.y);
+    }
+
+    for (auto const &element : buffers)
+    {
+      QString id = channel.id;
+      if (channel.wildcard)
+      {
+        id.replace(QStringLiteral("[*]"),
+                   QString("[%1]").arg(element.first));
+      }
+
+      emit this->seriesPoints(channel.charts, id, element.second.x,
+                              element.second.y);
+    }
+  }
+}
+
 //////////////////////////////////////////////////////
 void Topic::SetPlottingTimeRef(const std::shared_ptr<double> &_timeRef)
 {
@@ -372,308 +1299,1962 @@ void Topic::SetPlottingTimeRef(const std::shared_ptr<double> &_timeRef)
 }
 
 //////////////////////////////////////////////////////
-double TopicPrivate::FieldData(const google::protobuf::Message &_msg,
-                               const google::protobuf::FieldDescriptor *_field)
+void Topic::SetClock(const std::shared_ptr<const PlottingClock> &_clock)
 {
-  using namespace google::protobuf;
-  auto ref = _msg.GetReflection();
-  auto type = _field->type();
-
-  if (type == FieldDescriptor::Type::TYPE_DOUBLE)
-    return ref->GetDouble(_msg, _field);
-  else if (type == FieldDescriptor::Type::TYPE_FLOAT)
-    return ref->GetFloat(_msg, _field);
-  else if (type == FieldDescriptor::Type::TYPE_INT32)
-    return ref->GetInt32(_msg, _field);
-  else if (type == FieldDescriptor::Type::TYPE_INT64)
-    return ref->GetInt64(_msg, _field);
-  else if (type == FieldDescriptor::Type::TYPE_BOOL)
-    return ref->GetBool(_msg, _field);
-  else if (type == FieldDescriptor::Type::TYPE_UINT32)
-    return ref->GetUInt32(_msg, _field);
-  else if (type == FieldDescriptor::Type::TYPE_UINT64)
-    return ref->GetUInt64(_msg, _field);
-  else
-  {
-    ignwarn << "Non Plotting Type" << std::endl;
-    return 0;
-  }
+  this->dataPtr->clock = _clock;
 }
 
-////////////////////////////////////////////
-Transport::Transport() : dataPtr(std::make_unique<TransportPrivate>())
+//////////////////////////////////////////////////////
+void Topic::SetSamplingPolicy(const SamplingPolicy &_policy)
 {
+  this->dataPtr->policy = _policy;
+  this->dataPtr->policyVersion++;
+  this->dataPtr->Publish();
 }
 
-////////////////////////////////////////////
-Transport::~Transport()
+//////////////////////////////////////////////////////
+void Topic::SetSamplingPolicy(const std::string &_fieldPath,
+                              const SamplingPolicy &_policy)
 {
-  // unsubscribe from all topics in the transport
-  for (auto topic : this->dataPtr->topics)
-    this->dataPtr->node.Unsubscribe(topic.first);
+  this->dataPtr->fieldPolicies[_fieldPath] = _policy;
+  this->dataPtr->policyVersion++;
+  this->dataPtr->Publish();
 }
 
-////////////////////////////////////////////
-void Transport::Unsubscribe(const std::string &_topic,
-                            const std::string &_fieldPath,
-                            int _chart)
+//////////////////////////////////////////////////////
+SamplingPolicy Topic::FieldSamplingPolicy(const std::string &_fieldPath) const
 {
-  if (this->dataPtr->topics.count(_topic))
-  {
-    this->dataPtr->topics[_topic]->UnRegister(_fieldPath, _chart);
-
-    // if there is no registered fields, unsubscribe from the topic
-    if (this->dataPtr->topics[_topic]->FieldCount() == 0)
-    {
-      this->dataPtr->node.Unsubscribe(_topic);
-      this->dataPtr->topics.erase(_topic);
-    }
-  }
+  return this->dataPtr->Policy(_fieldPath);
 }
 
-////////////////////////////////////////////
-void Transport::Subscribe(const std::string &_topic,
-                          const std::string &_fieldPath,
-                          int _chart, const std::shared_ptr<double> &_time)
+//////////////////////////////////////////////////////
+SamplingPolicy TopicPrivate::Policy(const std::string &_path) const
 {
-  // new topic
-  if (this->dataPtr->topics.count(_topic) == 0)
-  {
-    auto topicHandler = new Topic(_topic);
-    this->dataPtr->topics[_topic] = topicHandler;
+  auto policyIt = this->fieldPolicies.find(_path);
+  if (policyIt != this->fieldPolicies.end())
+    return policyIt->second;
 
-    topicHandler->Register(_fieldPath, _chart);
-    this->dataPtr->node.Subscribe(_topic, &Topic::Callback, topicHandler);
+  return this->policy;
+}
 
-    topicHandler->SetPlottingTimeRef(_time);
+//////////////////////////////////////////////////////
+void TopicPrivate::Publish()
+{
+  auto snapshot = std::make_shared<Registration>();
+  snapshot->policyVersion = this->policyVersion;
+  snapshot->fields.reserve(this->channels.Count());
 
-    connect(topicHandler, SIGNAL(plot(int, QString, double, double)),
-            this, SLOT(onPlot(int, QString, double, double)));
-  }
-  // already exist topic
-  else
+  for (auto const &channel : this->channels.items)
   {
-    this->dataPtr->topics[_topic]->Register(_fieldPath, _chart);
-    this->dataPtr->node.Subscribe(_topic, &Topic::Callback,
-                                  this->dataPtr->topics[_topic]);
+    if (channel)
+      snapshot->fields.push_back({channel, this->Policy(channel->path)});
   }
+
+  std::atomic_store(&this->registration,
+                    std::shared_ptr<const Registration>(std::move(snapshot)));
 }
 
 //////////////////////////////////////////////////////
-const std::map<std::string, Topic*> &Transport::Topics()
+bool SampleQueue::Push(const Sample &_sample)
 {
-  return this->dataPtr->topics;
+  auto tailPos = this->tail.load(std::memory_order_relaxed);
+  auto next = tailPos + 1 == this->samples.size() ? 0 : tailPos + 1;
+
+  if (next == this->head.load(std::memory_order_acquire))
+  {
+    this->dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  this->samples[tailPos] = _sample;
+  this->tail.store(next, std::memory_order_release);
+  return true;
 }
 
 //////////////////////////////////////////////////////
-void Transport::onPlot(int _chart, QString _fieldID, double _x, double _y)
+void SampleQueue::PopAll(std::vector<Sample> &_samples)
 {
-  emit this->plot(_chart, _fieldID, _x, _y);
+  auto headPos = this->head.load(std::memory_order_relaxed);
+  auto tailPos = this->tail.load(std::memory_order_acquire);
+
+  auto count = tailPos >= headPos ? tailPos - headPos :
+      this->samples.size() - headPos + tailPos;
+  _samples.reserve(_samples.size() + count);
+
+  while (headPos != tailPos)
+  {
+    _samples.push_back(this->samples[headPos]);
+    headPos = headPos + 1 == this->samples.size() ? 0 : headPos + 1;
+  }
+
+  this->head.store(headPos, std::memory_order_release);
 }
 
 //////////////////////////////////////////////////////
-void Transport::UnsubscribeOutdatedTopics()
+bool FieldSampler::Sample(double _time, double _value,
+                          double &_outTime, double &_outValue)
 {
-  // get all topics in the transport
-  std::vector<std::string> topics;
-  this->dataPtr->node.TopicList(topics);
+  if (this->policy.mode == SamplingMode::ALL || this->policy.rate <= 0)
+  {
+    _outTime = _time;
+    _outValue = _value;
+    return true;
+  }
+
+  double period = 1.0 / this->policy.rate;
+
+  // a new period starts after a full period or if the time goes back, e.g.
+  // on a simulation reset
+  bool newPeriod = !this->started || _time < this->periodStart ||
+      _time - this->periodStart >= period;
+
+  if (this->policy.mode == SamplingMode::DECIMATE)
+  {
+    if (!newPeriod)
+      return false;
+
+    this->started = true;
+    this->periodStart = _time;
+    _outTime = _time;
+    _outValue = _value;
+    return true;
+  }
 
-  for (auto topic : this->dataPtr->topics)
+  // aggregate the samples of the period, and capture the aggregated sample
+  // when the period is over
+  bool captured = false;
+  if (newPeriod)
   {
-    // check if the topic exist
-    if (std::find(topics.begin(), topics.end(), topic.first) == topics.end())
+    if (this->started)
     {
-      this->dataPtr->node.Unsubscribe(topic.first);
-      delete topic.second;
-      this->dataPtr->topics.erase(topic.first);
+      _outTime = this->aggTime;
+      _outValue = this->policy.mode == SamplingMode::MEAN ?
+          this->sum / this->count : this->aggValue;
+      captured = true;
     }
-  }
-}
 
-//////////////////////////////////////////////////////
-PlottingInterface::PlottingInterface() : QObject(),
-    dataPtr(std::make_unique<PlottingIfacePrivate>())
-{
-  connect(&this->dataPtr->transport,
-          SIGNAL(plot(int, QString, double, double)), this,
-          SLOT(onPlot(int, QString, double, double)));
+    this->started = true;
+    this->periodStart = _time;
+    this->aggTime = _time;
+    this->aggValue = _value;
+    this->sum = _value;
+    this->count = 1;
+    return captured;
+  }
 
-  this->dataPtr->timeout = 1;
-  this->InitTimer();
+  this->sum += _value;
+  this->count++;
 
-  App()->Engine()->rootContext()->setContextProperty("PlottingIface", this);
-}
+  if ((this->policy.mode == SamplingMode::MIN && _value < this->aggValue) ||
+      (this->policy.mode == SamplingMode::MAX && _value > this->aggValue))
+  {
+    this->aggTime = _time;
+    this->aggValue = _value;
+  }
 
-//////////////////////////////////////////////////////
-PlottingInterface::~PlottingInterface()
-{
+  return false;
 }
 
 //////////////////////////////////////////////////////
-void PlottingInterface::unsubscribe(int _chart,
-                                    QString _topic,
-                                    QString _fieldPath)
+void FieldSampler::Reset()
 {
-  this->dataPtr->transport.Unsubscribe(_topic.toStdString(),
-                                       _fieldPath.toStdString(),
-                                       _chart);
+  this->started = false;
+  this->sum = 0;
+  this->count = 0;
 }
 
 //////////////////////////////////////////////////////
-float PlottingInterface::Timeout() const
+std::shared_ptr<const FieldAccessor> TopicPrivate::Accessor(
+    const google::protobuf::Descriptor *_descriptor, const std::string &_path)
 {
-  return this->dataPtr->timer.interval();
+  auto key = std::make_pair(_descriptor, _path);
+  auto accessorIt = this->accessors.find(key);
+  if (accessorIt != this->accessors.end())
+    return accessorIt->second;
+
+  auto accessor = std::make_shared<FieldAccessor>();
+  accessor->Compile(_descriptor, _path);
+  this->accessors[key] = accessor;
+  return accessor;
 }
 
 //////////////////////////////////////////////////////
-void PlottingInterface::onComponentSubscribe(QString _entity, QString _typeId,
-                                             QString _type, QString _attribute,
-                                             int _chart)
+void TopicPrivate::Compile(const google::protobuf::Descriptor *_descriptor)
 {
-  // convert the strings into
-  uint64_t entity, typeId;
-  std::istringstream issEntity(_entity.toStdString());
-  issEntity >> entity;
-  std::istringstream issTypeId(_typeId.toStdString());
-  issTypeId >> typeId;
+  this->descriptor = _descriptor;
 
-  emit this->ComponentSubscribe(entity, typeId, _type.toStdString(),
-                                _attribute.toStdString(), _chart);
+  this->header = _descriptor->FindFieldByName("header");
+  if (this->header &&
+      (this->header->is_repeated() || !this->header->message_type()))
+  {
+    this->header = nullptr;
+  }
+  this->headerSec = this->Accessor(_descriptor, "header-stamp-sec");
+  this->headerNsec = this->Accessor(_descriptor, "header-stamp-nsec");
 }
 
 //////////////////////////////////////////////////////
-void PlottingInterface::onComponentUnSubscribe(QString _entity, QString _typeId,
-                                               QString _attribute, int _chart)
+/// \brief Parse a step of a field path: "name", "name[index]" or "name[*]"
+/// \param[in] _step Step of a field path
+/// \param[out] _name Field name
+/// \param[out] _index Element index, FieldAccessor::kSingular or
+/// FieldAccessor::kWildcard
+/// \return True if the step is valid
+static bool ParseStep(const std::string &_step, std::string &_name,
+                      int &_index)
 {
-  // convert the strings into
-  uint64_t entity, typeId;
-  std::istringstream issEntity(_entity.toStdString());
-  issEntity >> entity;
-  std::istringstream issTypeId(_typeId.toStdString());
-  issTypeId >> typeId;
+  auto open = _step.find('[');
+  if (open == std::string::npos)
+  {
+    _name = _step;
+    _index = FieldAccessor::kSingular;
+    return !_name.empty();
+  }
 
-  emit this->ComponentUnSubscribe(entity, typeId,
-                                  _attribute.toStdString(), _chart);
-}
+  if (open == 0 || _step.back() != ']')
+    return false;
 
-//////////////////////////////////////////////////////
-void PlottingInterface::subscribe(int _chart,
-                                  QString _topic,
-                                  QString _fieldPath)
-{
-  this->dataPtr->transport.Subscribe(_topic.toStdString(),
-                                     _fieldPath.toStdString(),
-                                     _chart, this->dataPtr->plottingTimeRef);
-}
+  _name = _step.substr(0, open);
+  auto index = _step.substr(open + 1, _step.size() - open - 2);
+  if (index == "*")
+  {
+    _index = FieldAccessor::kWildcard;
+    return true;
+  }
 
-////////////////////////////////////////////
-void PlottingInterface::InitTimer()
-{
-  this->dataPtr->timer.setInterval(this->dataPtr->timeout);
-  connect(&this->dataPtr->timer, SIGNAL(timeout()), this, SLOT(UpdateTime()));
-  this->dataPtr->timer.start();
+  if (index.empty() || index.size() > 9 ||
+      !std::all_of(index.begin(), index.end(), ::isdigit))
+  {
+    return false;
+  }
+
+  _index = std::stoi(index);
+  return true;
 }
 
 //////////////////////////////////////////////////////
-void PlottingInterface::onPlot(int _chart, QString _fieldID,
-                               double _x, double _y)
+/// \brief Get the nested message of a step
+/// \param[in] _msg Message containing the step field
+/// \param[in] _step Step to walk through
+/// \param[in] _index Element index, or FieldAccessor::kSingular
+/// \return Nested message, null if the element doesn't exist
+static const google::protobuf::Message *Nested(
+    const google::protobuf::Message &_msg, const FieldAccessor::Step &_step,
+    int _index)
 {
-  // if _x == -1, then the msg has not header time
-  // so update x with the default plotting time that is handled by a timer
-  if (static_cast<int>(_x) == DEFAULT_TIME)
-      _x = *this->dataPtr->plottingTimeRef;
+  auto ref = _msg.GetReflection();
+  if (_index == FieldAccessor::kSingular)
+    return &ref->GetMessage(_msg, _step.field);
 
-  emit this->plot(_chart, _fieldID, _x, _y);
-}
+  if (_index >= ref->FieldSize(_msg, _step.field))
+    return nullptr;
 
-//////////////////////////////////////////////////////
-void PlottingInterface::UpdateTime()
-{
-  *this->dataPtr->plottingTimeRef += this->dataPtr->timeout * 0.001;
+  return &ref->GetRepeatedMessage(_msg, _step.field, _index);
 }
 
 //////////////////////////////////////////////////////
-std::string PlottingInterface::FilePath(QString _path, std::string _name,
-                                        std::string _extention)
+/// \brief Read a plottable scalar, or an element of a repeated one
+/// \param[in] _msg Message containing the field
+/// \param[in] _field Plottable field
+/// \param[in] _index Element index, or FieldAccessor::kSingular
+/// \param[out] _value Value as double
+/// \return False if the element doesn't exist
+static bool LeafValue(const google::protobuf::Message &_msg,
+                      const google::protobuf::FieldDescriptor *_field,
+                      int _index, double &_value)
 {
-  if (_extention != "csv" && _extention != "pdf")
-    return "";
+  using namespace google::protobuf;
 
-  if (_path.toStdString().size() < 8)
+  auto ref = _msg.GetReflection();
+  if (_index == FieldAccessor::kSingular)
   {
-    ignwarn << "Couldn't parse file path" << std::endl;
-    return "";
+    switch (_field->cpp_type())
+    {
+      case FieldDescriptor::CPPTYPE_DOUBLE:
+        _value = ref->GetDouble(_msg, _field);
+        return true;
+      case FieldDescriptor::CPPTYPE_FLOAT:
+        _value = ref->GetFloat(_msg, _field);
+        return true;
+      case FieldDescriptor::CPPTYPE_INT32:
+        _value = ref->GetInt32(_msg, _field);
+        return true;
+      case FieldDescriptor::CPPTYPE_INT64:
+        _value = ref->GetInt64(_msg, _field);
+        return true;
+      case FieldDescriptor::CPPTYPE_UINT32:
+        _value = ref->GetUInt32(_msg, _field);
+        return true;
+      case FieldDescriptor::CPPTYPE_UINT64:
+        _value = ref->GetUInt64(_msg, _field);
+        return true;
+      case FieldDescriptor::CPPTYPE_BOOL:
+        _value = ref->GetBool(_msg, _field);
+        return true;
+      default:
+        return false;
+    }
   }
-  else
-    // remove "file://" at the begin of the path
-    _path.remove(0, 7);
 
-  std::replace(_name.begin(), _name.end(), '/', '_');
-  std::replace(_name.begin(), _name.end(), '-', '_');
-  std::replace(_name.begin(), _name.end(), ',', '_');
+  if (_index >= ref->FieldSize(_msg, _field))
+    return false;
 
-  return _path.toStdString() + "/" + "\'" + _name + "." + _extention + "\'";
+  switch (_field->cpp_type())
+  {
+    case FieldDescriptor::CPPTYPE_DOUBLE:
+      _value = ref->GetRepeatedDouble(_msg, _field, _index);
+      return true;
+    case FieldDescriptor::CPPTYPE_FLOAT:
+      _value = ref->GetRepeatedFloat(_msg, _field, _index);
+      return true;
+    case FieldDescriptor::CPPTYPE_INT32:
+      _value = ref->GetRepeatedInt32(_msg, _field, _index);
+      return true;
+    case FieldDescriptor::CPPTYPE_INT64:
+      _value = ref->GetRepeatedInt64(_msg, _field, _index);
+      return true;
+    case FieldDescriptor::CPPTYPE_UINT32:
+      _value = ref->GetRepeatedUInt32(_msg, _field, _index);
+      return true;
+    case FieldDescriptor::CPPTYPE_UINT64:
+      _value = ref->GetRepeatedUInt64(_msg, _field, _index);
+      return true;
+    case FieldDescriptor::CPPTYPE_BOOL:
+      _value = ref->GetRepeatedBool(_msg, _field, _index);
+      return true;
+    default:
+      return false;
+  }
 }
 
 //////////////////////////////////////////////////////
-bool PlottingInterface::exportCSV(QString _path, int _chart,
-                                  QMap< QString, QVariant> _serieses)
+/// \brief Append all the elements of a repeated scalar field, converted
+/// to double in one pass over its contiguous storage
+/// \param[in] _msg Message containing the field
+/// \param[in] _field Repeated field of type T
+/// \param[out] _values Values to append to
+template <typename T>
+static void AppendRepeated(const google::protobuf::Message &_msg,
+                           const google::protobuf::FieldDescriptor *_field,
+                           std::vector<double> &_values)
 {
-  std::string plotName = "Plot" + std::to_string(_chart);
+  // GetRepeatedField is deprecated in favor of GetRepeatedFieldRef, which
+  // reads each element through a virtual call, while this is the only
+  // reflection access to the contiguous storage
+#if defined(__GNUC__) || defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#elif defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable: 4996)
+#endif
+  auto const &field = _msg.GetReflection()->GetRepeatedField<T>(_msg, _field);
+#if defined(__GNUC__) || defined(__clang__)
+#pragma GCC diagnostic pop
+#elif defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+  _values.insert(_values.end(), field.begin(), field.end());
+}
 
-  std::ofstream file;
+//////////////////////////////////////////////////////
+bool FieldAccessor::Compile(const google::protobuf::Descriptor *_descriptor,
+                            const std::string &_path)
+{
+  using namespace google::protobuf;
 
-  QMap<QString, QVariant>::const_iterator series = _serieses.constBegin();
-  while (series != _serieses.constEnd())
-  {
-    auto key = series.key().toStdString();
+  this->descriptor = _descriptor;
+  this->path.clear();
+  this->leaf = Step();
+  this->wildcard = -1;
+  this->valid = false;
 
-    // check if it is a component
-    auto seriesKeys = ignition::common::Split(key, ',');
-    if (seriesKeys.size() == 3)
-    {
-      // convert from string to uint64_t
-      uint64_t typeId;
-      std::string typeIdString = seriesKeys[1];
-      std::istringstream issTypeId(typeIdString);
-      issTypeId >> typeId;
+  if (!_descriptor)
+    return false;
 
-      // replace the typeId num with the type name
-      auto typeName = emit ComponentName(typeId);
-      seriesKeys[1] = typeName;
+  auto fieldFullPath = ignition::common::Split(_path, '-');
+  if (fieldFullPath.empty())
+    return false;
 
-      // make the new series key
-      key = seriesKeys[0] + "_" + seriesKeys[1] + "_" + seriesKeys[2];
-    }
-    // if Field
-    else
-      std::replace(key.begin(), key.end(), '-', '/');
+  auto msgDescriptor = _descriptor;
+  for (size_t i = 0; i < fieldFullPath.size(); ++i)
+  {
+    Step step;
+    std::string name;
+    if (!ParseStep(fieldFullPath[i], name, step.index))
+      return false;
 
-    auto name = plotName +  "_" + key;
+    step.field = msgDescriptor->FindFieldByName(name);
+    if (!step.field)
+      return false;
 
-    auto filePath = this->FilePath(_path , name, "csv");
+    // repeated fields need an index, singular ones can't have one
+    if (step.field->is_repeated() != (step.index != kSingular))
+      return false;
 
-    if (!filePath.size())
+    if (step.index == kWildcard)
     {
-        ignwarn << "[Couldn't parse file: " << filePath << "]" << std::endl;
+      // one wildcard per path, so the values are indexed by element
+      if (this->wildcard >= 0)
         return false;
+      this->wildcard = static_cast<int>(this->path.size());
+    }
+    // all the elements of the wildcard have the same number of values
+    else if (this->wildcard >= 0 && step.field->is_repeated())
+    {
+      return false;
     }
 
-    file.open(filePath);
-    if (!file.is_open())
-        ignwarn << "[Couldn't open file: " << filePath << "]" << std::endl;
-
-    file << "time, " << key << std::endl;
-
-    auto points = series.value().toList();
-    for (int j = 0 ; j < points.size(); j++)
+    // the last field in the path is the plotted one
+    if (i == fieldFullPath.size() - 1)
     {
-        auto point = points.at(j).toPointF();
-        file << point.x() << ", " << point.y() << std::endl;
+      this->leaf = step;
+      break;
     }
 
-    file.close();
+    msgDescriptor = step.field->message_type();
+    if (!msgDescriptor)
+      return false;
+
+    this->path.push_back(step);
+  }
+
+  switch (this->leaf.field->cpp_type())
+  {
+    case FieldDescriptor::CPPTYPE_DOUBLE:
+    case FieldDescriptor::CPPTYPE_FLOAT:
+    case FieldDescriptor::CPPTYPE_INT32:
+    case FieldDescriptor::CPPTYPE_INT64:
+    case FieldDescriptor::CPPTYPE_UINT32:
+    case FieldDescriptor::CPPTYPE_UINT64:
+    case FieldDescriptor::CPPTYPE_BOOL:
+      this->valid = true;
+      break;
+    default:
+      this->valid = false;
+  }
+
+  return this->valid;
+}
+
+//////////////////////////////////////////////////////
+bool FieldAccessor::Value(const google::protobuf::Message &_msg,
+                          double &_value) const
+{
+  if (this->wildcard >= 0)
+    return false;
+
+  // walk through the nested messages without mutating the message
+  const google::protobuf::Message *msg = &_msg;
+  for (auto const &step : this->path)
+  {
+    msg = Nested(*msg, step, step.index);
+    if (!msg)
+      return false;
+  }
+
+  return LeafValue(*msg, this->leaf.field, this->leaf.index, _value);
+}
+
+//////////////////////////////////////////////////////
+bool FieldAccessor::Values(const google::protobuf::Message &_msg,
+                           std::vector<double> &_values) const
+{
+  using namespace google::protobuf;
+
+  _values.clear();
+  if (this->wildcard < 0)
+    return false;
+
+  // walk to the message containing the wildcard field
+  const Message *msg = &_msg;
+  for (int i = 0; i < this->wildcard; ++i)
+  {
+    msg = Nested(*msg, this->path[i], this->path[i].index);
+    if (!msg)
+      return false;
+  }
+
+  // repeated scalar, copied at once
+  if (this->wildcard == static_cast<int>(this->path.size()))
+  {
+    switch (this->leaf.field->cpp_type())
+    {
+      case FieldDescriptor::CPPTYPE_DOUBLE:
+        AppendRepeated<double>(*msg, this->leaf.field, _values);
+        return true;
+      case FieldDescriptor::CPPTYPE_FLOAT:
+        AppendRepeated<float>(*msg, this->leaf.field, _values);
+        return true;
+      case FieldDescriptor::CPPTYPE_INT32:
+        AppendRepeated<std::int32_t>(*msg, this->leaf.field, _values);
+        return true;
+      case FieldDescriptor::CPPTYPE_INT64:
+        AppendRepeated<std::int64_t>(*msg, this->leaf.field, _values);
+        return true;
+      case FieldDescriptor::CPPTYPE_UINT32:
+        AppendRepeated<std::uint32_t>(*msg, this->leaf.field, _values);
+        return true;
+      case FieldDescriptor::CPPTYPE_UINT64:
+        AppendRepeated<std::uint64_t>(*msg, this->leaf.field, _values);
+        return true;
+      case FieldDescriptor::CPPTYPE_BOOL:
+        AppendRepeated<bool>(*msg, this->leaf.field, _values);
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  // repeated message, walk through the singular fields of each element
+  auto const &step = this->path[this->wildcard];
+  int count = msg->GetReflection()->FieldSize(*msg, step.field);
+  _values.reserve(count);
+  for (int e = 0; e < count; ++e)
+  {
+    const Message *element = Nested(*msg, step, e);
+    for (std::size_t i = this->wildcard + 1; i < this->path.size(); ++i)
+      element = Nested(*element, this->path[i], kSingular);
+
+    double value = 0;
+    LeafValue(*element, this->leaf.field, kSingular, value);
+    _values.push_back(value);
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////
+Transport::Transport() : dataPtr(std::make_unique<TransportPrivate>())
+{
+}
+
+////////////////////////////////////////////
+Transport::~Transport()
+{
+  // unsubscribe from all topics in the transport
+  auto const &topics = this->dataPtr->topics;
+  for (std::size_t id = 0; id < topics.items.size(); ++id)
+  {
+    if (topics.items[id])
+      this->dataPtr->node.Unsubscribe(topics.keys[id]);
+  }
+}
+
+////////////////////////////////////////////
+void Transport::Unsubscribe(const std::string &_topic,
+                            const std::string &_fieldPath,
+                            int _chart)
+{
+  auto &topics = this->dataPtr->topics;
+
+  int id = topics.Id(_topic);
+  if (id < 0)
+    return;
+
+  auto &topic = topics.items[id];
+  topic->UnRegister(_fieldPath, _chart);
+
+  // if there is no registered fields, unsubscribe from the topic
+  if (topic->FieldCount() == 0)
+  {
+    this->dataPtr->node.Unsubscribe(_topic);
+    topics.Remove(id);
+  }
+}
+
+////////////////////////////////////////////
+void Transport::Subscribe(const std::string &_topic,
+                          const std::string &_fieldPath,
+                          int _chart, const std::shared_ptr<double> &_time)
+{
+  auto &topics = this->dataPtr->topics;
+
+  // new topic
+  int id = topics.Id(_topic);
+  if (id < 0)
+  {
+    // the last reference may be released by the transport thread, so the
+    // handler is deleted by the thread owning it
+    std::shared_ptr<Topic> topicHandler(new Topic(_topic),
+        [](Topic *_handler) { _handler->deleteLater(); });
+    topics.Add(_topic, topicHandler);
+
+    // apply the policies set before subscribing
+    for (auto const &policy : this->dataPtr->policies)
+    {
+      if (policy.first.first != _topic)
+        continue;
+
+      if (policy.first.second.empty())
+        topicHandler->SetSamplingPolicy(policy.second);
+      else
+        topicHandler->SetSamplingPolicy(policy.first.second, policy.second);
+    }
+
+    // the time is set before subscribing, as the callback reads it
+    topicHandler->SetPlottingTimeRef(_time);
+    if (this->dataPtr->clock)
+      topicHandler->SetClock(this->dataPtr->clock);
+
+    topicHandler->Register(_fieldPath, _chart);
+    this->dataPtr->Subscribe(_topic, topicHandler);
+
+    connect(topicHandler.get(), SIGNAL(plot(int, QString, double, double)),
+            this, SLOT(onPlot(int, QString, double, double)));
+    connect(topicHandler.get(),
+            SIGNAL(seriesPoints(QVector<int>, QString, QVector<double>,
+                                QVector<double>)),
+            this,
+            SLOT(onSeriesPoints(QVector<int>, QString, QVector<double>,
+                                QVector<double>)));
+  }
+  // already exist topic
+  else
+  {
+    // the topic is already subscribed, and another transport subscription
+    // would deliver each message once more
+    topics.items[id]->Register(_fieldPath, _chart);
+  }
+}
+
+//////////////////////////////////////////////////////
+void TransportPrivate::Subscribe(const std::string &_topic,
+    const std::shared_ptr<ignition::gui::Topic> &_handler)
+{
+  std::function<void(const google::protobuf::Message &)> callback =
+      [_handler](const google::protobuf::Message &_msg)
+      {
+        _handler->Callback(_msg);
+      };
+  this->node.Subscribe(_topic, callback);
+}
+
+//////////////////////////////////////////////////////
+int Transport::TopicId(const std::string &_topic) const
+{
+  return this->dataPtr->topics.Id(_topic);
+}
+
+//////////////////////////////////////////////////////
+Topic *Transport::TopicById(int _id)
+{
+  if (!this->dataPtr->topics.Valid(_id))
+    return nullptr;
+
+  return this->dataPtr->topics.items[_id].get();
+}
+
+//////////////////////////////////////////////////////
+const std::map<std::string, Topic*> &Transport::Topics()
+{
+  auto &topics = this->dataPtr->topicMap;
+  topics.clear();
+  auto const &registry = this->dataPtr->topics;
+  for (std::size_t id = 0; id < registry.items.size(); ++id)
+  {
+    if (registry.items[id])
+      topics[registry.keys[id]] = registry.items[id].get();
+  }
+  return topics;
+}
+
+//////////////////////////////////////////////////////
+void Transport::Flush()
+{
+  for (auto const &topic : this->dataPtr->topics.items)
+  {
+    if (topic)
+      topic->Flush();
+  }
+}
+
+//////////////////////////////////////////////////////
+void Transport::SetClock(const std::shared_ptr<const PlottingClock> &_clock)
+{
+  this->dataPtr->clock = _clock;
+}
+
+//////////////////////////////////////////////////////
+void Transport::SetSamplingPolicy(const std::string &_topic,
+                                  const std::string &_fieldPath,
+                                  const SamplingPolicy &_policy)
+{
+  this->dataPtr->policies[std::make_pair(_topic, _fieldPath)] = _policy;
+
+  auto topic = this->TopicById(this->TopicId(_topic));
+  if (!topic)
+    return;
+
+  if (_fieldPath.empty())
+    topic->SetSamplingPolicy(_policy);
+  else
+    topic->SetSamplingPolicy(_fieldPath, _policy);
+}
+
+//////////////////////////////////////////////////////
+void Transport::onPlot(int _chart, QString _fieldID, double _x, double _y)
+{
+  emit this->plot(_chart, _fieldID, _x, _y);
+}
+
+//////////////////////////////////////////////////////
+void Transport::onSeriesPoints(QVector<int> _charts, QString _fieldID,
+                               QVector<double> _x, QVector<double> _y)
+{
+  emit this->seriesPoints(_charts, _fieldID, _x, _y);
+}
+
+//////////////////////////////////////////////////////
+void Transport::UnsubscribeOutdatedTopics()
+{
+  // get all topics in the transport
+  std::vector<std::string> topicList;
+  this->dataPtr->node.TopicList(topicList);
+  std::unordered_set<std::string> advertised(topicList.begin(),
+                                             topicList.end());
+
+  // removing a topic only frees its slot, so the registry can be walked
+  // while removing
+  auto &topics = this->dataPtr->topics;
+  for (std::size_t id = 0; id < topics.items.size(); ++id)
+  {
+    if (!topics.items[id] || advertised.count(topics.keys[id]))
+      continue;
+
+    this->dataPtr->node.Unsubscribe(topics.keys[id]);
+    topics.Remove(static_cast<int>(id));
+  }
+}
+
+//////////////////////////////////////////////////////
+PlottingInterface::PlottingInterface() : QObject(),
+    dataPtr(std::make_unique<PlottingIfacePrivate>())
+{
+  connect(&this->dataPtr->transport,
+          SIGNAL(plot(int, QString, double, double)), this,
+          SLOT(onPlot(int, QString, double, double)));
+  connect(&this->dataPtr->transport,
+          SIGNAL(seriesPoints(QVector<int>, QString, QVector<double>,
+                              QVector<double>)),
+          this,
+          SLOT(onSeriesPoints(QVector<int>, QString, QVector<double>,
+                              QVector<double>)));
+
+  this->dataPtr->transport.SetClock(this->dataPtr->clock);
+  this->InitTimer();
+
+  this->SetRefreshRate(REFRESH_RATE);
+  connect(&this->dataPtr->refreshTimer, SIGNAL(timeout()), this,
+          SLOT(Flush()));
+  this->dataPtr->refreshTimer.start();
+
+  App()->Engine()->rootContext()->setContextProperty("PlottingIface", this);
+}
+
+//////////////////////////////////////////////////////
+PlottingInterface::~PlottingInterface()
+{
+  this->cancelExport();
+  if (this->dataPtr->exportThread.joinable())
+    this->dataPtr->exportThread.join();
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::unsubscribe(int _chart,
+                                    QString _topic,
+                                    QString _fieldPath)
+{
+  this->dataPtr->transport.Unsubscribe(_topic.toStdString(),
+                                       _fieldPath.toStdString(),
+                                       _chart);
+
+  QString fieldID = _topic + "-" + _fieldPath;
+  if (!_fieldPath.contains("[*]"))
+  {
+    this->dataPtr->RemoveView(_chart, fieldID);
+    return;
+  }
+
+  // remove the chart from the series of all the elements of a wildcard field
+  QString pattern = QRegularExpression::escape(fieldID);
+  pattern.replace("\\[\\*\\]", "\\[\\d+\\]");
+  QRegularExpression elementID("^" + pattern + "$");
+  QStringList elementIDs;
+  for (auto const &series : this->dataPtr->series)
+  {
+    if (series.first.first == SHARED_SERIES &&
+        series.second->views.count(_chart) &&
+        elementID.match(series.first.second).hasMatch())
+    {
+      elementIDs.append(series.first.second);
+    }
+  }
+  for (auto const &id : elementIDs)
+    this->dataPtr->RemoveView(_chart, id);
+}
+
+//////////////////////////////////////////////////////
+float PlottingInterface::Timeout() const
+{
+  return this->dataPtr->refreshTimer.interval();
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::onComponentSubscribe(QString _entity, QString _typeId,
+                                             QString _type, QString _attribute,
+                                             int _chart)
+{
+  // convert the strings into
+  uint64_t entity, typeId;
+  std::istringstream issEntity(_entity.toStdString());
+  issEntity >> entity;
+  std::istringstream issTypeId(_typeId.toStdString());
+  issTypeId >> typeId;
+
+  // the chart plots the series shared with the other charts
+  this->dataPtr->Series(SHARED_SERIES,
+      _entity + "," + _typeId + "," + _attribute, _chart);
+
+  emit this->ComponentSubscribe(entity, typeId, _type.toStdString(),
+                                _attribute.toStdString(), _chart);
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::onComponentUnSubscribe(QString _entity, QString _typeId,
+                                               QString _attribute, int _chart)
+{
+  // convert the strings into
+  uint64_t entity, typeId;
+  std::istringstream issEntity(_entity.toStdString());
+  issEntity >> entity;
+  std::istringstream issTypeId(_typeId.toStdString());
+  issTypeId >> typeId;
+
+  emit this->ComponentUnSubscribe(entity, typeId,
+                                  _attribute.toStdString(), _chart);
+
+  this->dataPtr->RemoveView(_chart,
+      _entity + "," + _typeId + "," + _attribute);
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::subscribe(int _chart,
+                                  QString _topic,
+                                  QString _fieldPath)
+{
+  this->dataPtr->transport.Subscribe(_topic.toStdString(),
+                                     _fieldPath.toStdString(),
+                                     _chart, this->dataPtr->plottingTimeRef);
+}
+
+////////////////////////////////////////////
+void PlottingInterface::InitTimer()
+{
+  this->dataPtr->clock->Reset();
+  this->UpdateTime();
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::onPlot(int _chart, QString _fieldID,
+                               double _x, double _y)
+{
+  // if _x == -1, then the msg has not header time
+  // so update x with the current plotting clock time
+  if (static_cast<int>(_x) == DEFAULT_TIME)
+      _x = this->dataPtr->clock->Now();
+
+  // the same point is sent for each chart plotting the field, only the
+  // first chart stores it
+  auto &series = this->dataPtr->Series(SHARED_SERIES, _fieldID, _chart);
+  if (series.views.begin()->first == _chart)
+    series.Append(_x, _y);
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::onPlotPoints(int _chart, QString _fieldID,
+                                     QVector<double> _x, QVector<double> _y)
+{
+  auto &series = this->dataPtr->Series(SHARED_SERIES, _fieldID, _chart);
+  if (series.views.begin()->first == _chart)
+  {
+    int count = std::min(_x.size(), _y.size());
+    for (int i = 0; i < count; ++i)
+      series.Append(_x[i], _y[i]);
+  }
+
+  emit this->plotPoints(_chart, _fieldID, _x, _y);
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::onSeriesPoints(QVector<int> _charts, QString _fieldID,
+                                       QVector<double> _x, QVector<double> _y)
+{
+  if (_charts.isEmpty())
+    return;
+
+  StoredSeries *series = nullptr;
+  for (auto chart : _charts)
+    series = &this->dataPtr->Series(SHARED_SERIES, _fieldID, chart);
+
+  int count = std::min(_x.size(), _y.size());
+  for (int i = 0; i < count; ++i)
+    series->Append(_x[i], _y[i]);
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::Flush()
+{
+  this->dataPtr->transport.Flush();
+  this->dataPtr->UpdateDerived();
+  this->dataPtr->UpdateXY();
+
+  for (auto &xy : this->dataPtr->xySeries)
+  {
+    auto &stored = *xy.second;
+    if (!stored.dirty)
+      continue;
+
+    emit this->xySeriesUpdated(xy.first.first, xy.first.second,
+                               stored.minX, stored.maxX,
+                               stored.minY, stored.maxY);
+    stored.ResetBounds();
+  }
+
+  for (auto const &key : this->dataPtr->openedRecordings)
+  {
+    auto it = this->dataPtr->recordings.find(key);
+    if (it == this->dataPtr->recordings.end() || it->second->Size() == 0)
+      continue;
+
+    auto const &recording = *it->second;
+    emit this->seriesUpdated(key.first, key.second, recording.Time(0),
+                             recording.Time(recording.Size() - 1),
+                             recording.MinValue(), recording.MaxValue());
+  }
+  this->dataPtr->openedRecordings.clear();
+
+  // in the triggered capture mode, the charts only redraw when a capture
+  // completes
+  if (this->dataPtr->trigger)
+  {
+    for (auto &series : this->dataPtr->series)
+      series.second->ResetBounds();
+
+    auto const &trigger = *this->dataPtr->trigger;
+    if (trigger.fired &&
+        trigger.lastTime >= trigger.time + trigger.trigger.postTime)
+    {
+      this->CompleteCapture();
+    }
+    return;
+  }
+
+  for (auto &series : this->dataPtr->series)
+  {
+    auto &stored = *series.second;
+    if (!stored.dirty)
+      continue;
+
+    for (auto const &view : stored.views)
+    {
+      emit this->seriesUpdated(view.first, series.first.second,
+                               stored.minX, stored.maxX,
+                               stored.minY, stored.maxY);
+    }
+
+    stored.ResetBounds();
+  }
+}
+
+//////////////////////////////////////////////////////
+int PlottingInterface::updateSeries(QObject *_series, int _chart,
+                                    QString _fieldID, double _minX,
+                                    double _maxX, int _width)
+{
+  auto xySeries = qobject_cast<QtCharts::QXYSeries *>(_series);
+  if (!xySeries)
+    return 0;
+
+  // recorded series are decimated by their pyramid
+  auto recording = this->dataPtr->recordings.find(
+      std::make_pair(_chart, _fieldID));
+  if (recording != this->dataPtr->recordings.end())
+  {
+    std::vector<double> x;
+    std::vector<double> y;
+    recording->second->Points(_minX, _maxX,
+        static_cast<unsigned int>(std::max(_width, 0)), x, y);
+
+    QVector<QPointF> points;
+    points.reserve(static_cast<int>(x.size()));
+    for (std::size_t i = 0; i < x.size(); ++i)
+      points.append(QPointF(x[i], y[i]));
+
+    xySeries->replace(points);
+    return points.size();
+  }
+
+  auto stored = this->dataPtr->Find(_chart, _fieldID);
+  if (!stored || _width <= 0)
+  {
+    xySeries->clear();
+    return 0;
+  }
+
+  // each chart has its own visible range of the shared samples. Only the
+  // samples appended or scrolled into view since the last update are
+  // aggregated.
+  auto &decimator = stored->views[_chart];
+  decimator.SetView(_minX, _maxX, _width);
+  decimator.Update(this->dataPtr->trigger && stored->capture ?
+      *stored->capture : stored->data);
+
+  std::vector<double> x;
+  std::vector<double> y;
+  decimator.Points(x, y);
+
+  QVector<QPointF> points;
+  points.reserve(static_cast<int>(x.size()));
+  for (std::size_t i = 0; i < x.size(); ++i)
+    points.append(QPointF(x[i], y[i]));
+
+  xySeries->replace(points);
+  return points.size();
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::setSamplingPolicy(QString _topic, QString _fieldPath,
+                                          int _mode, double _rate)
+{
+  if (_mode < static_cast<int>(SamplingMode::ALL) ||
+      _mode > static_cast<int>(SamplingMode::MEAN))
+  {
+    ignwarn << "Invalid sampling mode [" << _mode << "]" << std::endl;
+    return;
+  }
+
+  SamplingPolicy policy;
+  policy.mode = static_cast<SamplingMode>(_mode);
+  policy.rate = _rate;
+
+  this->dataPtr->transport.SetSamplingPolicy(_topic.toStdString(),
+                                             _fieldPath.toStdString(), policy);
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::SetTimeSource(PlottingTimeSource _source)
+{
+  this->dataPtr->clock->SetSource(_source);
+}
+
+//////////////////////////////////////////////////////
+PlottingTimeSource PlottingInterface::TimeSource() const
+{
+  return this->dataPtr->clock->Source();
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::setTimeSource(QString _source)
+{
+  auto source = _source.toLower();
+  if (source == "wall")
+    this->SetTimeSource(PlottingTimeSource::WALL);
+  else if (source == "sim")
+    this->SetTimeSource(PlottingTimeSource::SIM);
+  else if (source == "header")
+    this->SetTimeSource(PlottingTimeSource::HEADER);
+  else
+    ignwarn << "Invalid time source [" << _source.toStdString() << "]"
+            << std::endl;
+}
+
+//////////////////////////////////////////////////////
+bool PlottingInterface::SetSimTimeTopic(const std::string &_topic)
+{
+  auto &simTimeTopic = this->dataPtr->simTimeTopic;
+  if (!simTimeTopic.empty())
+    this->dataPtr->node.Unsubscribe(simTimeTopic);
+  simTimeTopic.clear();
+
+  if (_topic.empty())
+    return true;
+
+  // WorldStatistics has the sim time in "sim_time", Clock in "sim"
+  std::function<void(const google::protobuf::Message &)> cb =
+      [this](const google::protobuf::Message &_msg)
+      {
+        auto d = this->dataPtr.get();
+        auto descriptor = _msg.GetDescriptor();
+        if (descriptor != d->simTimeDescriptor)
+        {
+          d->simTimeDescriptor = descriptor;
+          if (!d->simTimeSec.Compile(descriptor, "sim_time-sec"))
+            d->simTimeSec.Compile(descriptor, "sim-sec");
+          if (!d->simTimeNsec.Compile(descriptor, "sim_time-nsec"))
+            d->simTimeNsec.Compile(descriptor, "sim-nsec");
+
+          if (!d->simTimeSec.valid)
+          {
+            ignwarn << "No sim time in msgs of type ["
+                    << descriptor->full_name() << "]" << std::endl;
+          }
+        }
+
+        double sec = 0;
+        double nsec = 0;
+        if (!d->simTimeSec.valid || !d->simTimeSec.Value(_msg, sec))
+          return;
+        if (d->simTimeNsec.valid)
+          d->simTimeNsec.Value(_msg, nsec);
+
+        d->clock->SetSimTime(sec + nsec * 1e-9);
+      };
+
+  if (!this->dataPtr->node.Subscribe(_topic, cb))
+  {
+    ignwarn << "Failed to subscribe to sim time topic [" << _topic << "]"
+            << std::endl;
+    return false;
+  }
+
+  simTimeTopic = _topic;
+  return true;
+}
+
+//////////////////////////////////////////////////////
+const PlottingClock &PlottingInterface::Clock() const
+{
+  return *this->dataPtr->clock;
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::SetRefreshRate(double _rate)
+{
+  if (_rate <= 0)
+  {
+    ignwarn << "Invalid refresh rate [" << _rate << "]" << std::endl;
+    return;
+  }
+
+  this->dataPtr->refreshRate = _rate;
+  this->dataPtr->refreshTimer.setInterval(
+      std::max(1, static_cast<int>(std::round(1000.0 / _rate))));
+}
+
+//////////////////////////////////////////////////////
+double PlottingInterface::RefreshRate() const
+{
+  return this->dataPtr->refreshRate;
+}
+
+//////////////////////////////////////////////////////
+const TimeSeries *PlottingInterface::Series(int _chart,
+                                            const QString &_fieldID) const
+{
+  auto stored = this->dataPtr->Find(_chart, _fieldID);
+  if (!stored)
+    return nullptr;
+
+  return &stored->data;
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::SetSeriesCapacity(std::size_t _capacity)
+{
+  this->dataPtr->seriesCapacity = _capacity;
+  for (auto &series : this->dataPtr->series)
+    series.second->data.SetCapacity(_capacity);
+  for (auto &xy : this->dataPtr->xySeries)
+  {
+    xy.second->x.SetCapacity(_capacity);
+    xy.second->y.SetCapacity(_capacity);
+  }
+}
+
+//////////////////////////////////////////////////////
+std::size_t PlottingInterface::SeriesCapacity() const
+{
+  return this->dataPtr->seriesCapacity;
+}
+
+//////////////////////////////////////////////////////
+const SeriesStats *PlottingInterface::Stats(int _chart,
+                                            const QString &_fieldID) const
+{
+  auto stored = this->dataPtr->Find(_chart, _fieldID);
+  if (!stored)
+    return nullptr;
+
+  return &stored->stats;
+}
+
+//////////////////////////////////////////////////////
+const SeriesStats *PlottingInterface::WindowStats(int _chart,
+    const QString &_fieldID) const
+{
+  auto stored = this->dataPtr->Find(_chart, _fieldID);
+  if (!stored)
+    return nullptr;
+
+  return &stored->windowStats;
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::SetStatsWindow(double _window)
+{
+  if (_window <= 0)
+  {
+    ignwarn << "Invalid stats window [" << _window << "]" << std::endl;
+    return;
+  }
+
+  this->dataPtr->statsWindow = _window;
+  for (auto &series : this->dataPtr->series)
+    series.second->windowStats.SetWindow(_window);
+}
+
+//////////////////////////////////////////////////////
+double PlottingInterface::StatsWindow() const
+{
+  return this->dataPtr->statsWindow;
+}
+
+//////////////////////////////////////////////////////
+QVariantMap PlottingInterface::seriesStats(int _chart, QString _fieldID) const
+{
+  auto toMap = [](const SeriesStats &_stats)
+  {
+    QVariantMap map;
+    map["count"] = static_cast<qulonglong>(_stats.Count());
+    map["min"] = _stats.Min();
+    map["max"] = _stats.Max();
+    map["mean"] = _stats.Mean();
+    map["std"] = _stats.StdDev();
+    map["rms"] = _stats.Rms();
+    return map;
+  };
+
+  auto stored = this->dataPtr->Find(_chart, _fieldID);
+  if (!stored)
+    return QVariantMap();
+
+  auto map = toMap(stored->stats);
+  map["window"] = toMap(stored->windowStats);
+  return map;
+}
+
+//////////////////////////////////////////////////////
+bool PlottingInterface::AddDerivedSeries(int _chart, const QString &_name,
+                                         const std::string &_expression,
+                                         SeriesAlignment _alignment)
+{
+  auto key = std::make_pair(_chart, _name);
+  if (this->dataPtr->xySeries.count(key) ||
+      (!this->dataPtr->derived.count(key) &&
+       this->dataPtr->Find(_chart, _name)))
+  {
+    ignerr << "Series [" << _name.toStdString() << "] already exists"
+           << std::endl;
+    return false;
+  }
+
+  auto expression = std::make_unique<SeriesExpression>();
+  if (!expression->Compile(_expression))
+  {
+    ignerr << "Invalid expression [" << _expression << "]: "
+           << expression->Error() << std::endl;
+    return false;
+  }
+
+  auto const &inputs = expression->Inputs();
+  if (std::find(inputs.begin(), inputs.end(), _name.toStdString()) !=
+      inputs.end())
+  {
+    ignerr << "Series [" << _name.toStdString() << "] can't reference itself"
+           << std::endl;
+    return false;
+  }
+  expression->SetAlignment(_alignment);
+
+  // a redefined series starts over
+  this->dataPtr->derived[key] = std::move(expression);
+  this->dataPtr->series.erase(key);
+  return true;
+}
+
+//////////////////////////////////////////////////////
+bool PlottingInterface::addDerivedSeries(int _chart, QString _name,
+                                         QString _expression)
+{
+  return this->AddDerivedSeries(_chart, _name, _expression.toStdString());
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::removeDerivedSeries(int _chart, QString _name)
+{
+  auto key = std::make_pair(_chart, _name);
+  if (this->dataPtr->derived.erase(key))
+    this->dataPtr->series.erase(key);
+}
+
+//////////////////////////////////////////////////////
+bool PlottingInterface::AddXYSeries(int _chart, const QString &_name,
+                                    const QString &_xFieldID,
+                                    const QString &_yFieldID,
+                                    double _tolerance)
+{
+  auto key = std::make_pair(_chart, _name);
+  if (this->dataPtr->derived.count(key) ||
+      (!this->dataPtr->xySeries.count(key) &&
+       this->dataPtr->Find(_chart, _name)))
+  {
+    ignerr << "Series [" << _name.toStdString() << "] already exists"
+           << std::endl;
+    return false;
+  }
+
+  if (_name.isEmpty() || _xFieldID.isEmpty() || _yFieldID.isEmpty())
+  {
+    ignerr << "Invalid XY series [" << _name.toStdString() << "]"
+           << std::endl;
+    return false;
+  }
+
+  // a redefined series starts over
+  this->dataPtr->xySeries[key] = std::make_unique<StoredXYSeries>(
+      _xFieldID, _yFieldID, _tolerance, this->dataPtr->seriesCapacity);
+  return true;
+}
+
+//////////////////////////////////////////////////////
+bool PlottingInterface::XYPoints(int _chart, const QString &_name,
+                                 std::vector<double> &_x,
+                                 std::vector<double> &_y) const
+{
+  _x.clear();
+  _y.clear();
+
+  auto it = this->dataPtr->xySeries.find(std::make_pair(_chart, _name));
+  if (it == this->dataPtr->xySeries.end())
+    return false;
+
+  auto const &stored = *it->second;
+  for (std::size_t i = 0; i < stored.x.Size(); ++i)
+  {
+    _x.push_back(stored.x.Value(i));
+    _y.push_back(stored.y.Value(i));
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////////
+bool PlottingInterface::addXYSeries(int _chart, QString _name,
+                                    QString _xFieldID, QString _yFieldID,
+                                    double _tolerance)
+{
+  return this->AddXYSeries(_chart, _name, _xFieldID, _yFieldID, _tolerance);
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::removeXYSeries(int _chart, QString _name)
+{
+  this->dataPtr->xySeries.erase(std::make_pair(_chart, _name));
+}
+
+//////////////////////////////////////////////////////
+int PlottingInterface::updateXYSeries(QObject *_series, int _chart,
+                                      QString _name, double _minX,
+                                      double _maxX, double _minY,
+                                      double _maxY, int _width, int _height)
+{
+  auto xySeries = qobject_cast<QtCharts::QXYSeries *>(_series);
+  if (!xySeries)
+    return 0;
+
+  auto it = this->dataPtr->xySeries.find(std::make_pair(_chart, _name));
+  if (it == this->dataPtr->xySeries.end() || _width <= 0 || _height <= 0)
+  {
+    xySeries->clear();
+    return 0;
+  }
+
+  // the coordinates are stored in two series of the same capacity, which
+  // wrap around at the same index
+  auto const &stored = *it->second;
+  TimeSeriesSpan xSpans[2];
+  TimeSeriesSpan ySpans[2];
+  stored.x.Spans(xSpans[0], xSpans[1]);
+  stored.y.Spans(ySpans[0], ySpans[1]);
+
+  QVector<QPointF> points;
+  std::vector<std::size_t> indices;
+  for (int s = 0; s < 2; ++s)
+  {
+    DecimateXY(xSpans[s].values, ySpans[s].values, xSpans[s].size,
+               _minX, _maxX, _minY, _maxY,
+               static_cast<unsigned int>(_width),
+               static_cast<unsigned int>(_height), indices);
+    for (auto i : indices)
+      points.append(QPointF(xSpans[s].values[i], ySpans[s].values[i]));
+  }
+
+  xySeries->replace(points);
+  return points.size();
+}
+
+//////////////////////////////////////////////////////
+bool PlottingInterface::SetTrigger(const CaptureTrigger &_trigger)
+{
+  if (_trigger.fieldID.empty() || _trigger.preTime < 0 ||
+      _trigger.postTime < 0)
+  {
+    ignwarn << "Invalid capture trigger of field [" << _trigger.fieldID
+            << "]" << std::endl;
+    return false;
+  }
+
+  auto trigger = std::make_unique<TriggerDetector>();
+  trigger->trigger = _trigger;
+
+  QString fieldID = QString::fromStdString(_trigger.fieldID);
+  for (auto &series : this->dataPtr->series)
+  {
+    series.second->trigger = series.first.second == fieldID ?
+        trigger.get() : nullptr;
+  }
+  this->dataPtr->trigger = std::move(trigger);
+  return true;
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::ClearTrigger()
+{
+  if (!this->dataPtr->trigger)
+    return;
+  this->dataPtr->trigger.reset();
+
+  // redraw the live samples
+  for (auto &series : this->dataPtr->series)
+  {
+    auto &stored = *series.second;
+    stored.trigger = nullptr;
+    stored.capture.reset();
+    for (auto &view : stored.views)
+      view.second.Reset();
+
+    if (stored.data.Empty())
+      continue;
+
+    for (auto const &view : stored.views)
+    {
+      emit this->seriesUpdated(view.first, series.first.second,
+                               stored.data.Time(0),
+                               stored.data.Time(stored.data.Size() - 1),
+                               stored.stats.Min(), stored.stats.Max());
+    }
+  }
+}
+
+//////////////////////////////////////////////////////
+bool PlottingInterface::TriggerEnabled() const
+{
+  return this->dataPtr->trigger != nullptr;
+}
+
+//////////////////////////////////////////////////////
+bool PlottingInterface::TriggerArmed() const
+{
+  return this->dataPtr->trigger && this->dataPtr->trigger->armed;
+}
+
+//////////////////////////////////////////////////////
+const TimeSeries *PlottingInterface::Capture(int _chart,
+                                             const QString &_fieldID) const
+{
+  auto stored = this->dataPtr->Find(_chart, _fieldID);
+  if (!stored)
+    return nullptr;
+
+  return stored->capture.get();
+}
+
+//////////////////////////////////////////////////////
+bool PlottingInterface::setTrigger(QString _fieldID, QString _condition,
+                                   double _threshold, double _preTime,
+                                   double _postTime, bool _singleShot)
+{
+  CaptureTrigger trigger;
+  auto condition = _condition.toLower();
+  if (condition == "rising")
+    trigger.condition = TriggerCondition::RISING;
+  else if (condition == "falling")
+    trigger.condition = TriggerCondition::FALLING;
+  else if (condition == "level")
+    trigger.condition = TriggerCondition::LEVEL;
+  else
+  {
+    ignwarn << "Invalid trigger condition [" << _condition.toStdString()
+            << "]" << std::endl;
+    return false;
+  }
+
+  trigger.fieldID = _fieldID.toStdString();
+  trigger.threshold = _threshold;
+  trigger.preTime = _preTime;
+  trigger.postTime = _postTime;
+  trigger.singleShot = _singleShot;
+  return this->SetTrigger(trigger);
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::clearTrigger()
+{
+  this->ClearTrigger();
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::armTrigger()
+{
+  if (!this->dataPtr->trigger)
+    return;
+
+  this->dataPtr->trigger->armed = true;
+  this->dataPtr->trigger->fired = false;
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::CompleteCapture()
+{
+  auto &trigger = *this->dataPtr->trigger;
+  double start = trigger.time - trigger.trigger.preTime;
+  double end = trigger.time + trigger.trigger.postTime;
+
+  // copy the window of each series, the samples before the trigger are
+  // still in the ring buffers of the stored series
+  for (auto &series : this->dataPtr->series)
+  {
+    auto &stored = *series.second;
+    auto const &data = stored.data;
+
+    std::size_t first = data.LowerBound(start);
+    std::size_t last = data.LowerBound(end);
+    while (last < data.Size() && data.Time(last) <= end)
+      last++;
+
+    std::size_t count = last - first;
+    stored.capture = std::make_unique<TimeSeries>(std::max<std::size_t>(
+        count, 1));
+    double minY = std::numeric_limits<double>::max();
+    double maxY = std::numeric_limits<double>::lowest();
+    for (std::size_t i = first; i < last; ++i)
+    {
+      stored.capture->Append(data.Time(i), data.Value(i));
+      minY = std::min(minY, data.Value(i));
+      maxY = std::max(maxY, data.Value(i));
+    }
+
+    // the views switch from the live samples to the capture
+    for (auto &view : stored.views)
+      view.second.Reset();
+
+    if (count == 0)
+      continue;
+
+    for (auto const &view : stored.views)
+    {
+      emit this->seriesUpdated(view.first, series.first.second,
+                               stored.capture->Time(0),
+                               stored.capture->Time(count - 1), minY, maxY);
+    }
+  }
+
+  trigger.fired = false;
+  if (trigger.trigger.singleShot)
+    trigger.armed = false;
+
+  emit this->captureCompleted(trigger.time, start, end);
+}
+
+//////////////////////////////////////////////////////
+void PlottingIfacePrivate::UpdateXY()
+{
+  std::vector<double> times;
+  std::vector<double> xs;
+  std::vector<double> ys;
+  for (auto &xy : this->xySeries)
+  {
+    int chart = xy.first.first;
+    auto &stored = *xy.second;
+
+    auto xSeries = this->Find(chart, stored.xFieldID);
+    auto ySeries = this->Find(chart, stored.yFieldID);
+    if (!xSeries || !ySeries)
+      continue;
+
+    // a field has been plotted again, join its new samples from the start
+    if (&xSeries->data != stored.xInput || &ySeries->data != stored.yInput)
+    {
+      stored.join.Reset();
+      stored.x.Clear();
+      stored.y.Clear();
+      stored.xInput = &xSeries->data;
+      stored.yInput = &ySeries->data;
+    }
+
+    std::size_t count = stored.join.Update(xSeries->data, ySeries->data,
+                                           times, xs, ys);
+    for (std::size_t i = 0; i < count; ++i)
+      stored.Append(times[i], xs[i], ys[i]);
+  }
+}
+
+//////////////////////////////////////////////////////
+void PlottingIfacePrivate::UpdateDerived()
+{
+  std::vector<const TimeSeries *> inputs;
+  std::vector<double> times;
+  std::vector<double> values;
+  for (auto &derived : this->derived)
+  {
+    int chart = derived.first.first;
+    auto &expression = *derived.second;
+
+    inputs.clear();
+    for (auto const &input : expression.Inputs())
+    {
+      auto stored = this->Find(chart, QString::fromStdString(input));
+      inputs.push_back(stored ? &stored->data : nullptr);
+    }
+
+    if (expression.Update(inputs, times, values) == 0)
+      continue;
+
+    // e.g. the first sample of a derivative, or a division by zero
+    auto &output = this->Series(chart, derived.first.second, chart);
+    for (std::size_t i = 0; i < times.size(); ++i)
+    {
+      if (std::isfinite(values[i]))
+        output.Append(times[i], values[i]);
+    }
+  }
+}
+
+//////////////////////////////////////////////////////
+StoredSeries &PlottingIfacePrivate::Series(int _owner,
+                                           const QString &_fieldID,
+                                           int _chart)
+{
+  auto &series = this->series[std::make_pair(_owner, _fieldID)];
+  if (!series)
+  {
+    series = std::make_unique<StoredSeries>(this->seriesCapacity,
+                                            this->statsWindow);
+    if (this->trigger && this->trigger->trigger.fieldID ==
+        _fieldID.toStdString())
+    {
+      series->trigger = this->trigger.get();
+    }
+  }
+  series->views[_chart];
+  return *series;
+}
+
+//////////////////////////////////////////////////////
+void PlottingIfacePrivate::RemoveView(int _chart, const QString &_fieldID)
+{
+  auto seriesIt = this->series.find(std::make_pair(SHARED_SERIES, _fieldID));
+  if (seriesIt == this->series.end())
+    return;
+
+  seriesIt->second->views.erase(_chart);
+  if (seriesIt->second->views.empty())
+    this->series.erase(seriesIt);
+}
+
+//////////////////////////////////////////////////////
+StoredSeries *PlottingIfacePrivate::Find(int _chart,
+                                         const QString &_fieldID) const
+{
+  auto seriesIt = this->series.find(std::make_pair(_chart, _fieldID));
+  if (seriesIt != this->series.end())
+    return seriesIt->second.get();
+
+  seriesIt = this->series.find(std::make_pair(SHARED_SERIES, _fieldID));
+  if (seriesIt != this->series.end() &&
+      seriesIt->second->views.count(_chart))
+  {
+    return seriesIt->second.get();
+  }
+  return nullptr;
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::UpdateTime()
+{
+  *this->dataPtr->plottingTimeRef = this->dataPtr->clock->Now();
+}
+
+//////////////////////////////////////////////////////
+std::string PlottingInterface::FilePath(QString _path, std::string _name,
+                                        std::string _extention)
+{
+  if (_extention != "csv" && _extention != "bin" && _extention != "pdf")
+    return "";
+
+  if (_path.toStdString().size() < 8)
+  {
+    ignwarn << "Couldn't parse file path" << std::endl;
+    return "";
+  }
+  else
+    // remove "file://" at the begin of the path
+    _path.remove(0, 7);
+
+  std::replace(_name.begin(), _name.end(), '/', '_');
+  std::replace(_name.begin(), _name.end(), '-', '_');
+  std::replace(_name.begin(), _name.end(), ',', '_');
+
+  return _path.toStdString() + "/" + "\'" + _name + "." + _extention + "\'";
+}
+
+//////////////////////////////////////////////////////
+QString PlottingInterface::openRecording(int _chart, QString _path)
+{
+  if (_path.startsWith("file://"))
+    _path.remove(0, 7);
+
+  auto recording = std::make_unique<RecordedSeries>();
+  if (!recording->Open(_path.toStdString()))
+  {
+    ignerr << "Couldn't open series file [" << _path.toStdString() << "]"
+           << std::endl;
+    return "";
+  }
+
+  auto name = QString::fromStdString(recording->Name());
+  auto key = std::make_pair(_chart, name);
+  if (name.isEmpty() || this->dataPtr->recordings.count(key) ||
+      this->dataPtr->Find(_chart, name) ||
+      this->dataPtr->xySeries.count(key) || this->dataPtr->derived.count(key))
+  {
+    ignerr << "Series [" << name.toStdString() << "] already exists"
+           << std::endl;
+    return "";
+  }
+
+  this->dataPtr->recordings[key] = std::move(recording);
+  this->dataPtr->openedRecordings.insert(key);
+  return name;
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::closeRecording(int _chart, QString _name)
+{
+  auto key = std::make_pair(_chart, _name);
+  this->dataPtr->recordings.erase(key);
+  this->dataPtr->openedRecordings.erase(key);
+}
+
+//////////////////////////////////////////////////////
+const RecordedSeries *PlottingInterface::Recording(int _chart,
+    const QString &_name) const
+{
+  auto it = this->dataPtr->recordings.find(std::make_pair(_chart, _name));
+  if (it == this->dataPtr->recordings.end())
+    return nullptr;
+  return it->second.get();
+}
+
+//////////////////////////////////////////////////////
+std::string PlottingInterface::SeriesKey(const QString &_fieldID)
+{
+  auto key = _fieldID.toStdString();
+
+  // check if it is a component
+  auto seriesKeys = ignition::common::Split(key, ',');
+  if (seriesKeys.size() == 3)
+  {
+    // convert from string to uint64_t
+    uint64_t typeId;
+    std::string typeIdString = seriesKeys[1];
+    std::istringstream issTypeId(typeIdString);
+    issTypeId >> typeId;
+
+    // replace the typeId num with the type name
+    auto typeName = emit ComponentName(typeId);
+    seriesKeys[1] = typeName;
+
+    // make the new series key
+    key = seriesKeys[0] + "_" + seriesKeys[1] + "_" + seriesKeys[2];
+  }
+  // if Field
+  else
+    std::replace(key.begin(), key.end(), '-', '/');
+
+  return key;
+}
+
+//////////////////////////////////////////////////////
+bool PlottingInterface::exportCSV(QString _path, int _chart,
+                                  QMap< QString, QVariant> _serieses)
+{
+  std::string plotName = "Plot" + std::to_string(_chart);
+
+  QMap<QString, QVariant>::const_iterator series = _serieses.constBegin();
+  while (series != _serieses.constEnd())
+  {
+    auto key = this->SeriesKey(series.key());
+    auto name = plotName +  "_" + key;
+
+    auto filePath = this->FilePath(_path , name, "csv");
+
+    if (!filePath.size())
+    {
+        ignwarn << "[Couldn't parse file: " << filePath << "]" << std::endl;
+        return false;
+    }
+
+    // export the stored samples, or the given points if not stored
+    SeriesSnapshot snapshot;
+    auto data = this->Series(_chart, series.key());
+    if (data)
+    {
+      snapshot = SeriesSnapshot(key, *data);
+    }
+    else
+    {
+      snapshot.name = key;
+      auto points = series.value().toList();
+      for (int j = 0 ; j < points.size(); j++)
+      {
+          auto point = points.at(j).toPointF();
+          snapshot.times.push_back(point.x());
+          snapshot.values.push_back(point.y());
+      }
+    }
+
+    if (!WriteSeriesCSV(filePath, snapshot))
+        ignwarn << "[Couldn't write file: " << filePath << "]" << std::endl;
+
     ++series;
   }
   return true;
 }
+
+//////////////////////////////////////////////////////
+int PlottingInterface::exportSeries(QString _path, int _chart,
+                                    QStringList _fieldIDs, QString _format)
+{
+  SeriesFormat format;
+  std::string extension;
+  if (_format.compare("csv", Qt::CaseInsensitive) == 0)
+  {
+    format = SeriesFormat::CSV;
+    extension = "csv";
+  }
+  else if (_format.compare("binary", Qt::CaseInsensitive) == 0)
+  {
+    format = SeriesFormat::BINARY;
+    extension = "bin";
+  }
+  else
+  {
+    ignwarn << "Unknown export format [" << _format.toStdString() << "]"
+            << std::endl;
+    return 0;
+  }
+
+  // copy the samples here, as the series keep being appended to on this
+  // thread while the export thread writes them
+  std::vector<ExportJob> jobs;
+  for (auto const &fieldID : _fieldIDs)
+  {
+    auto data = this->Series(_chart, fieldID);
+    if (!data)
+      continue;
+
+    auto key = this->SeriesKey(fieldID);
+    auto filePath = this->FilePath(_path,
+        "Plot" + std::to_string(_chart) + "_" + key, extension);
+    if (filePath.empty())
+    {
+      ignwarn << "[Couldn't parse file path: " << _path.toStdString() << "]"
+              << std::endl;
+      return 0;
+    }
+
+    ExportJob job;
+    job.path = filePath;
+    job.series = SeriesSnapshot(key, *data);
+    job.format = format;
+    jobs.push_back(std::move(job));
+  }
+
+  if (jobs.empty())
+    return 0;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->exportMutex);
+  for (auto &job : jobs)
+    this->dataPtr->exportJobs.push_back(std::move(job));
+
+  if (this->dataPtr->exporting)
+    return static_cast<int>(jobs.size());
+
+  // the previous export thread is done, or about to return
+  if (this->dataPtr->exportThread.joinable())
+    this->dataPtr->exportThread.join();
+
+  this->dataPtr->exporting = true;
+  this->dataPtr->exportThread = std::thread([this]()
+  {
+    while (true)
+    {
+      ExportJob job;
+      {
+        std::lock_guard<std::mutex> jobLock(this->dataPtr->exportMutex);
+        if (this->dataPtr->exportJobs.empty())
+        {
+          this->dataPtr->exporting = false;
+          return;
+        }
+        job = std::move(this->dataPtr->exportJobs.front());
+        this->dataPtr->exportJobs.pop_front();
+
+        // a cancel only applies to the exports queued before it
+        this->dataPtr->exportCancel = false;
+      }
+
+      auto file = QString::fromStdString(job.path);
+      double total = std::max<std::size_t>(job.series.times.size(), 1);
+
+      // signals are queued to the receivers on the GUI thread
+      bool success = WriteSeries(job.path, job.series, job.format,
+          [&](std::size_t _written)
+          {
+            emit this->exportProgress(file, _written / total);
+            return !this->dataPtr->exportCancel;
+          });
+
+      if (!success && !this->dataPtr->exportCancel)
+        ignwarn << "[Couldn't write file: " << job.path << "]" << std::endl;
+
+      emit this->exportFinished(file, success);
+    }
+  });
+
+  return static_cast<int>(jobs.size());
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::cancelExport()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->exportMutex);
+  this->dataPtr->exportCancel = true;
+
+  // report the dropped exports as failed
+  for (auto const &job : this->dataPtr->exportJobs)
+    emit this->exportFinished(QString::fromStdString(job.path), false);
+  this->dataPtr->exportJobs.clear();
+}
@@ -16,6 +16,11 @@
 */
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 #ifdef _MSC_VER
 #pragma warning(push, 0)
 #endif
@@ -26,10 +31,19 @@
 
 #include <ignition/transport.hh>
 #include <ignition/common/Console.hh>
+#include <ignition/common/Filesystem.hh>
 #include <ignition/utilities/ExtraTestMacros.hh>
 #include "test_config.h"  // NOLINT(build/include)
+#include "ignition/gui/Application.hh"
 #include "ignition/gui/Enums.hh"
 #include "ignition/gui/PlottingInterface.hh"
+#include "ignition/gui/RecordedSeries.hh"
+#include "ignition/gui/SeriesExport.hh"
+#include "ignition/gui/SeriesStats.hh"
+#include "ignition/gui/TimeSeries.hh"
+
+int g_argc = 1;
+char **g_argv = new char *[g_argc];
 
 using namespace ignition;
 using namespace gui;
@@ -60,6 +74,12 @@ TEST(PlottingInterfaceTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(Topic))
   auto topic = Topic("");
   topic.SetPlottingTimeRef(timeRef);
 
+  // limit the fields to 60Hz
+  SamplingPolicy policy;
+  policy.mode = SamplingMode::DECIMATE;
+  policy.rate = 60;
+  topic.SetSamplingPolicy(policy);
+
   topic.Register("pose-position-x", 1);
   topic.Register("pose-position-x", 2);
   topic.Register("pose-position-y", 1);
@@ -81,12 +101,24 @@ TEST(PlottingInterfaceTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(Topic))
   EXPECT_TRUE(fields["pose-position-y"]->Charts().find(1) !=
           fields["pose-position-x"]->Charts().end());
 
+  // fields are indexed by their ID
+  int yId = topic.FieldId("pose-position-y");
+  EXPECT_EQ(topic.FieldId("pose-position-x"), 0);
+  EXPECT_EQ(yId, 1);
+  EXPECT_EQ(topic.FieldById(yId), fields["pose-position-y"]);
+  EXPECT_EQ(topic.FieldId("pose-position-z"), -1);
+  EXPECT_EQ(topic.FieldById(5), nullptr);
+
   // test the removing of the field if it has not attatched charts
   topic.UnRegister("pose-position-y", 1);
   EXPECT_EQ(topic.FieldCount(), 1);
+  EXPECT_EQ(topic.FieldId("pose-position-y"), -1);
+  EXPECT_EQ(topic.FieldById(yId), nullptr);
 
   // =========== Callback Test ============
+  // the freed slot is reused
   topic.Register("pose-position-z", 1);
+  EXPECT_EQ(topic.FieldId("pose-position-z"), yId);
 
   // update the fields
   topic.Callback(msg);
@@ -125,6 +157,12 @@ TEST(PlottingInterfaceTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(HeaderTime))
 
   auto topic = Topic("");
 
+  // limit the field to 60Hz
+  SamplingPolicy policy;
+  policy.mode = SamplingMode::DECIMATE;
+  policy.rate = 60;
+  topic.SetSamplingPolicy("data", policy);
+
   topic.Register("data", 1);
 
   // set current time
@@ -159,6 +197,402 @@ TEST(PlottingInterfaceTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(HeaderTime))
   EXPECT_NE(static_cast<int>(fields["data"]->Value()), 20);
 }
 
+//////////////////////////////////////////////////
+TEST(PlottingInterfaceTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(Clock))
+{
+  PlottingClock clock;
+  EXPECT_EQ(clock.Source(), PlottingTimeSource::HEADER);
+
+  // monotonic wall time since the start
+  double first = clock.WallTime();
+  EXPECT_GE(first, 0);
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  double second = clock.WallTime();
+  EXPECT_GE(second - first, 0.01);
+  EXPECT_LE(first, clock.Now());
+
+  // the sim time is only used by the SIM source
+  clock.SetSimTime(123.5);
+  EXPECT_DOUBLE_EQ(clock.SimTime(), 123.5);
+  EXPECT_LT(clock.Now(), 100);
+  clock.SetSource(PlottingTimeSource::SIM);
+  EXPECT_DOUBLE_EQ(clock.Now(), 123.5);
+  clock.SetSource(PlottingTimeSource::WALL);
+  EXPECT_LT(clock.Now(), 100);
+
+  clock.Reset();
+  EXPECT_LT(clock.WallTime(), second);
+
+  // samples are plotted at the time given by the clock source
+  auto topicClock = std::make_shared<PlottingClock>();
+  topicClock->SetSimTime(42);
+
+  Topic topic("/clock");
+  topic.SetClock(topicClock);
+  topic.Register("data", 1);
+
+  QVector<double> xs;
+  QObject::connect(&topic, &Topic::seriesPoints,
+      [&](QVector<int>, QString, QVector<double> _x, QVector<double>)
+      {
+        xs += _x;
+      });
+
+  msgs::Int32 msg;
+  msg.set_data(1);
+  msg.mutable_header()->mutable_stamp()->set_sec(7);
+
+  // header stamp
+  topic.Callback(msg);
+
+  // sim time, even for header stamped msgs
+  topicClock->SetSource(PlottingTimeSource::SIM);
+  msg.mutable_header()->mutable_stamp()->set_sec(8);
+  topic.Callback(msg);
+
+  // wall time for msgs without header
+  topicClock->SetSource(PlottingTimeSource::HEADER);
+  msg.clear_header();
+  topic.Callback(msg);
+  topic.Flush();
+
+  ASSERT_EQ(xs.size(), 3);
+  EXPECT_DOUBLE_EQ(xs[0], 7);
+  EXPECT_DOUBLE_EQ(xs[1], 42);
+  EXPECT_LT(xs[2], 42);
+}
+
+//////////////////////////////////////////////////
+// Disable test on windows until we fix "LNK2001 unresolved external symbol"
+// error
+TEST(PlottingInterfaceTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(SamplingPolicy))
+{
+  common::Console::SetVerbosity(4);
+
+  auto timeRef = std::make_shared<double>(10);
+
+  Topic topic("/topic");
+  topic.SetPlottingTimeRef(timeRef);
+  topic.Register("data", 1);
+
+  std::map<QString, QVector<double>> xs;
+  std::map<QString, QVector<double>> ys;
+  QObject::connect(&topic, &Topic::seriesPoints,
+      [&](QVector<int>, QString _fieldID, QVector<double> _x,
+          QVector<double> _y)
+      {
+        xs[_fieldID] += _x;
+        ys[_fieldID] += _y;
+      });
+
+  // all the samples are kept by default, however close they are
+  EXPECT_EQ(topic.FieldSamplingPolicy("data").mode, SamplingMode::ALL);
+
+  msgs::Int32 msg;
+  for (int i = 0; i < 4; ++i)
+  {
+    msg.set_data(i);
+    topic.Callback(msg);
+    *timeRef += 0.0001;
+  }
+  topic.Flush();
+  ASSERT_EQ(ys["/topic-data"].size(), 4);
+  EXPECT_EQ(static_cast<int>(topic.Fields()["data"]->Value()), 3);
+
+  // aggregate per 1s period
+  SamplingPolicy policy;
+  policy.rate = 1;
+  for (auto mode : {SamplingMode::MIN, SamplingMode::MAX, SamplingMode::MEAN})
+  {
+    xs.clear();
+    ys.clear();
+    policy.mode = mode;
+    topic.SetSamplingPolicy("data", policy);
+    EXPECT_EQ(topic.FieldSamplingPolicy("data").mode, mode);
+
+    // values 2, 6, 4 in the first period, and 8 starts the next one
+    *timeRef = 100;
+    for (auto value : {2, 6, 4})
+    {
+      msg.set_data(value);
+      topic.Callback(msg);
+      *timeRef += 0.25;
+    }
+    topic.Flush();
+    EXPECT_TRUE(ys.empty());
+
+    *timeRef = 101;
+    msg.set_data(8);
+    topic.Callback(msg);
+    topic.Flush();
+
+    ASSERT_EQ(ys["/topic-data"].size(), 1);
+    if (mode == SamplingMode::MIN)
+    {
+      EXPECT_DOUBLE_EQ(xs["/topic-data"][0], 100);
+      EXPECT_DOUBLE_EQ(ys["/topic-data"][0], 2);
+    }
+    else if (mode == SamplingMode::MAX)
+    {
+      EXPECT_DOUBLE_EQ(xs["/topic-data"][0], 100.25);
+      EXPECT_DOUBLE_EQ(ys["/topic-data"][0], 6);
+    }
+    else
+    {
+      EXPECT_DOUBLE_EQ(xs["/topic-data"][0], 100);
+      EXPECT_DOUBLE_EQ(ys["/topic-data"][0], 4);
+    }
+  }
+
+  // the topic policy doesn't override the field policy
+  policy.mode = SamplingMode::DECIMATE;
+  topic.SetSamplingPolicy(policy);
+  EXPECT_EQ(topic.FieldSamplingPolicy("data").mode, SamplingMode::MEAN);
+  EXPECT_EQ(topic.FieldSamplingPolicy("").mode, SamplingMode::DECIMATE);
+}
+
+//////////////////////////////////////////////////
+// Disable test on windows until we fix "LNK2001 unresolved external symbol"
+// error
+TEST(PlottingInterfaceTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(MsgTypeChange))
+{
+  common::Console::SetVerbosity(4);
+
+  // plotting time for non-header msgs
+  auto timeRef = std::make_shared<double>(10);
+
+  auto topic = Topic("");
+  topic.SetPlottingTimeRef(timeRef);
+  topic.Register("pose-position-x", 1);
+
+  // the field is compiled against the first received msg type
+  msgs::Collision collision;
+  collision.mutable_pose()->mutable_position()->set_x(10);
+  topic.Callback(collision);
+
+  auto fields = topic.Fields();
+  EXPECT_EQ(static_cast<int>(fields["pose-position-x"]->Value()), 10);
+
+  // the field doesn't exist in the new msg type, so it is skipped
+  *timeRef += 1;
+  msgs::Vector3d vector3d;
+  vector3d.set_x(20);
+  topic.Callback(vector3d);
+
+  fields = topic.Fields();
+  EXPECT_EQ(static_cast<int>(fields["pose-position-x"]->Value()), 10);
+
+  // recompiled against another msg type that has the field
+  *timeRef += 1;
+  msgs::Visual visual;
+  visual.mutable_pose()->mutable_position()->set_x(30);
+  topic.Callback(visual);
+
+  fields = topic.Fields();
+  EXPECT_EQ(static_cast<int>(fields["pose-position-x"]->Value()), 30);
+
+  // switching back to the first msg type uses the cached accessor
+  *timeRef += 1;
+  collision.mutable_pose()->mutable_position()->set_x(40);
+  topic.Callback(collision);
+
+  fields = topic.Fields();
+  EXPECT_EQ(static_cast<int>(fields["pose-position-x"]->Value()), 40);
+}
+
+//////////////////////////////////////////////////
+// Disable test on windows until we fix "LNK2001 unresolved external symbol"
+// error
+TEST(PlottingInterfaceTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(RepeatedFields))
+{
+  common::Console::SetVerbosity(4);
+
+  auto timeRef = std::make_shared<double>(10);
+
+  std::map<QString, QVector<double>> ys;
+  auto collect = [&](QVector<int>, QString _fieldID, QVector<double>,
+                     QVector<double> _y)
+  {
+    ys[_fieldID] += _y;
+  };
+
+  // repeated scalars, by index or all of them
+  Topic scalars("/scalars");
+  scalars.SetPlottingTimeRef(timeRef);
+  scalars.Register("data[*]", 1);
+  scalars.Register("data[1]", 1);
+  scalars.Register("data[5]", 1);
+  scalars.Register("data", 1);
+  QObject::connect(&scalars, &Topic::seriesPoints, collect);
+
+  msgs::Double_V doubles;
+  doubles.add_data(1.5);
+  doubles.add_data(2.5);
+  doubles.add_data(3.5);
+  scalars.Callback(doubles);
+  scalars.Flush();
+
+  ASSERT_EQ(ys.size(), 3u);
+  EXPECT_EQ(ys["/scalars-data[0]"], QVector<double>({1.5}));
+  EXPECT_EQ(ys["/scalars-data[1]"], QVector<double>({2.5, 2.5}));
+  EXPECT_EQ(ys["/scalars-data[2]"], QVector<double>({3.5}));
+  EXPECT_DOUBLE_EQ(scalars.Fields()["data[*]"]->Value(), 1.5);
+  EXPECT_DOUBLE_EQ(scalars.Fields()["data[1]"]->Value(), 2.5);
+
+  // out of range index and repeated field without index aren't plotted
+  EXPECT_EQ(ys.count("/scalars-data[5]"), 0u);
+  EXPECT_EQ(ys.count("/scalars-data"), 0u);
+
+  // repeated messages
+  ys.clear();
+  Topic poses("/poses");
+  poses.SetPlottingTimeRef(timeRef);
+  poses.Register("pose[*]-position-x", 1);
+  poses.Register("pose[1]-position-y", 1);
+  poses.Register("pose[*]-position[0]", 1);
+  QObject::connect(&poses, &Topic::seriesPoints, collect);
+
+  msgs::Pose_V poseV;
+  for (int i = 0; i < 3; ++i)
+  {
+    auto position = poseV.add_pose()->mutable_position();
+    position->set_x(i);
+    position->set_y(10 + i);
+  }
+  poses.Callback(poseV);
+  poses.Flush();
+
+  ASSERT_EQ(ys.size(), 4u);
+  for (int i = 0; i < 3; ++i)
+  {
+    auto id = QString("/poses-pose[%1]-position-x").arg(i);
+    EXPECT_EQ(ys[id], QVector<double>({static_cast<double>(i)}));
+  }
+  EXPECT_EQ(ys["/poses-pose[1]-position-y"], QVector<double>({11}));
+}
+
+//////////////////////////////////////////////////
+// Disable test on windows until we fix "LNK2001 unresolved external symbol"
+// error
+TEST(PlottingInterfaceTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(Flush))
+{
+  common::Console::SetVerbosity(4);
+
+  auto timeRef = std::make_shared<double>(10);
+
+  Topic topic("/topic");
+  topic.SetPlottingTimeRef(timeRef);
+  topic.Register("data", 1);
+  topic.Register("data", 2);
+
+  // count the batches and points received by each chart
+  std::map<int, int> batches;
+  std::map<int, QVector<double>> xs;
+  std::map<int, QVector<double>> ys;
+  int emitted = 0;
+  QObject::connect(&topic, &Topic::seriesPoints,
+      [&](QVector<int> _charts, QString _fieldID, QVector<double> _x,
+          QVector<double> _y)
+      {
+        EXPECT_EQ(_fieldID, QString("/topic-data"));
+        emitted++;
+        for (auto chart : _charts)
+        {
+          batches[chart]++;
+          xs[chart] += _x;
+          ys[chart] += _y;
+        }
+      });
+
+  // samples are buffered until the flush
+  msgs::Int32 msg;
+  for (int i = 0; i < 5; ++i)
+  {
+    msg.set_data(i);
+    topic.Callback(msg);
+    *timeRef += 1;
+  }
+  EXPECT_TRUE(batches.empty());
+
+  // one batch for all the charts with all the samples
+  topic.Flush();
+  EXPECT_EQ(emitted, 1);
+  ASSERT_EQ(batches.size(), 2u);
+  for (auto chart : {1, 2})
+  {
+    EXPECT_EQ(batches[chart], 1);
+    ASSERT_EQ(xs[chart].size(), 5);
+    ASSERT_EQ(ys[chart].size(), 5);
+    for (int i = 0; i < 5; ++i)
+    {
+      EXPECT_DOUBLE_EQ(xs[chart][i], 10 + i);
+      EXPECT_DOUBLE_EQ(ys[chart][i], i);
+    }
+  }
+
+  // nothing to flush
+  topic.Flush();
+  EXPECT_EQ(batches[1], 1);
+  EXPECT_EQ(batches[2], 1);
+}
+
+//////////////////////////////////////////////////
+// Disable test on windows until we fix "LNK2001 unresolved external symbol"
+// error
+TEST(PlottingInterfaceTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(Concurrency))
+{
+  common::Console::SetVerbosity(4);
+
+  msgs::Vector3d msg;
+  msg.set_x(1);
+  msg.set_y(2);
+
+  Topic topic("/topic");
+  topic.Register("x", 1);
+
+  std::map<QString, int> counts;
+  QObject::connect(&topic, &Topic::seriesPoints,
+      [&](QVector<int>, QString _fieldID, QVector<double> _x,
+          QVector<double>)
+      {
+        counts[_fieldID] += _x.size();
+      });
+
+  // the callback runs on two transport threads at once while the fields
+  // are registered, unregistered and flushed on this one
+  const int count = 10000;
+  std::atomic<int> done{0};
+  auto publish = [&](int _first)
+  {
+    msgs::Vector3d threadMsg(msg);
+    auto stamp = threadMsg.mutable_header()->mutable_stamp();
+    for (int i = _first; i < _first + count; ++i)
+    {
+      stamp->set_sec(i);
+      topic.Callback(threadMsg);
+    }
+    done++;
+  };
+  std::thread publisher1(publish, 1);
+  std::thread publisher2(publish, count + 1);
+
+  while (done < 2)
+  {
+    topic.Register("y", 1);
+    topic.Flush();
+    topic.UnRegister("y", 1);
+    topic.Flush();
+  }
+  publisher1.join();
+  publisher2.join();
+  topic.Flush();
+
+  // the field registered all along has all the samples
+  EXPECT_EQ(counts["/topic-x"], 2 * count);
+  EXPECT_LE(counts["/topic-y"], 2 * count);
+  EXPECT_EQ(static_cast<int>(topic.Fields()["x"]->Value()), 1);
+}
+
 //////////////////////////////////////////////////
 // Disable test on windows until we fix "LNK2001 unresolved external symbol"
 // error
@@ -242,4 +676,459 @@ TEST(PlottingInterfaceTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(Transport))
 
   topics = transport.Topics();
   EXPECT_EQ(static_cast<int>(topics.size()), 1);
+  EXPECT_EQ(transport.TopicId("/collision_topic"), -1);
+  EXPECT_EQ(transport.TopicById(transport.TopicId("/test_topic")),
+            topics["/test_topic"]);
+}
+
+//////////////////////////////////////////////////
+// Disable test on windows until we fix "LNK2001 unresolved external symbol"
+// error
+TEST(PlottingInterfaceTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(OneSubscription))
+{
+  common::Console::SetVerbosity(4);
+
+  transport::Node node;
+  auto pub = node.Advertise<msgs::Vector3d>("/single_topic");
+
+  Transport transport;
+
+  // two fields of the topic, and one of them on two charts
+  auto timeRef = std::make_shared<double>(10);
+  transport.Subscribe("/single_topic", "x", 1, timeRef);
+  transport.Subscribe("/single_topic", "y", 1, timeRef);
+  transport.Subscribe("/single_topic", "x", 2, timeRef);
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+  std::map<std::pair<int, QString>, QVector<double>> xs;
+  QObject::connect(&transport, &Transport::seriesPoints,
+      [&](QVector<int> _charts, QString _fieldID, QVector<double> _x,
+          QVector<double>)
+      {
+        for (auto chart : _charts)
+          xs[{chart, _fieldID}] += _x;
+      });
+
+  std::atomic<int> received{0};
+  std::function<void(const msgs::Vector3d &)> cb =
+      [&](const msgs::Vector3d &)
+      {
+        received++;
+      };
+  node.Subscribe("/single_topic", cb);
+
+  const int count = 5;
+  msgs::Vector3d msg;
+  for (int i = 1; i <= count; ++i)
+  {
+    msg.mutable_header()->mutable_stamp()->set_sec(i);
+    msg.set_x(i);
+    msg.set_y(-i);
+    pub.Publish(msg);
+  }
+
+  int sleep = 0;
+  int maxSleep = 30;
+  while (received < count && sleep < maxSleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    sleep++;
+  }
+  EXPECT_EQ(received, count);
+
+  // leave time to any duplicated delivery before flushing
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  transport.Flush();
+
+  // each message is sampled once, whatever the fields and charts using it
+  for (auto const &key : {std::make_pair(1, QString("/single_topic-x")),
+                          std::make_pair(1, QString("/single_topic-y")),
+                          std::make_pair(2, QString("/single_topic-x"))})
+  {
+    // the transport may deliver the messages out of order
+    auto x = xs[key];
+    std::sort(x.begin(), x.end());
+    ASSERT_EQ(x.size(), count);
+    for (int i = 0; i < count; ++i)
+      EXPECT_DOUBLE_EQ(x[i], i + 1);
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(PlottingInterfaceTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Series))
+{
+  common::Console::SetVerbosity(4);
+  Application app(g_argc, g_argv);
+
+  PlottingInterface plottingIface;
+  plottingIface.SetSeriesCapacity(4);
+  EXPECT_EQ(plottingIface.SeriesCapacity(), 4u);
+
+  // notified once per flush with the bounds of the new points
+  int updates = 0;
+  QObject::connect(&plottingIface, &PlottingInterface::seriesUpdated,
+      [&](int _chart, QString _fieldID, double _minX, double _maxX,
+          double _minY, double _maxY)
+      {
+        EXPECT_EQ(_chart, 1);
+        EXPECT_EQ(_fieldID, QString("/topic-data"));
+        EXPECT_DOUBLE_EQ(_minX, 0.0);
+        EXPECT_DOUBLE_EQ(_maxX, 2.0);
+        EXPECT_DOUBLE_EQ(_minY, -1.0);
+        EXPECT_DOUBLE_EQ(_maxY, 5.0);
+        updates++;
+      });
+
+  EXPECT_EQ(plottingIface.Series(1, "/topic-data"), nullptr);
+
+  plottingIface.onPlotPoints(1, "/topic-data", {0.0, 1.0}, {5.0, -1.0});
+  plottingIface.onPlot(1, "/topic-data", 2.0, 3.0);
+
+  auto series = plottingIface.Series(1, "/topic-data");
+  ASSERT_NE(series, nullptr);
+  EXPECT_EQ(series->Size(), 3u);
+  EXPECT_EQ(updates, 0);
+
+  plottingIface.Flush();
+  EXPECT_EQ(updates, 1);
+
+  // nothing new to notify
+  plottingIface.Flush();
+  EXPECT_EQ(updates, 1);
+
+  // statistics of the received points
+  EXPECT_EQ(plottingIface.Stats(1, "/topic"), nullptr);
+  auto stats = plottingIface.Stats(1, "/topic-data");
+  ASSERT_NE(stats, nullptr);
+  EXPECT_EQ(stats->Count(), 3u);
+  EXPECT_DOUBLE_EQ(stats->Min(), -1.0);
+  EXPECT_DOUBLE_EQ(stats->Max(), 5.0);
+  EXPECT_DOUBLE_EQ(stats->Mean(), 7.0 / 3.0);
+  EXPECT_DOUBLE_EQ(plottingIface.StatsWindow(), 10.0);
+  EXPECT_EQ(plottingIface.WindowStats(1, "/topic-data")->Count(), 3u);
+
+  // changing the window restarts the window statistics
+  plottingIface.SetStatsWindow(1.5);
+  EXPECT_DOUBLE_EQ(plottingIface.StatsWindow(), 1.5);
+  EXPECT_EQ(plottingIface.WindowStats(1, "/topic-data")->Count(), 0u);
+
+  // the capacity limits the stored points
+  plottingIface.onPlotPoints(1, "/topic-data", {3.0, 4.0}, {0.0, 0.0});
+  EXPECT_EQ(series->Size(), 4u);
+  EXPECT_DOUBLE_EQ(series->Time(0), 1.0);
+
+  // but not the points of the full history statistics
+  EXPECT_EQ(stats->Count(), 5u);
+  EXPECT_DOUBLE_EQ(stats->Mean(), 1.4);
+
+  auto statsMap = plottingIface.seriesStats(1, "/topic-data");
+  EXPECT_EQ(statsMap["count"].toULongLong(), 5u);
+  EXPECT_DOUBLE_EQ(statsMap["max"].toDouble(), 5.0);
+  auto windowMap = statsMap["window"].toMap();
+  EXPECT_EQ(windowMap["count"].toULongLong(), 2u);
+  EXPECT_DOUBLE_EQ(windowMap["rms"].toDouble(), 0.0);
+  EXPECT_TRUE(plottingIface.seriesStats(2, "/topic-data").isEmpty());
+
+  // unsubscribing removes the stored points
+  plottingIface.unsubscribe(1, "/topic", "data");
+  EXPECT_EQ(plottingIface.Series(1, "/topic-data"), nullptr);
+}
+
+//////////////////////////////////////////////////
+TEST(PlottingInterfaceTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Derived))
+{
+  common::Console::SetVerbosity(4);
+  Application app(g_argc, g_argv);
+
+  PlottingInterface plottingIface;
+
+  // invalid expressions and taken IDs
+  plottingIface.onPlotPoints(1, "/a-x", {0.0, 1.0, 2.0}, {1.0, 2.0, 3.0});
+  EXPECT_FALSE(plottingIface.addDerivedSeries(1, "sum", "{/a-x} +"));
+  EXPECT_FALSE(plottingIface.addDerivedSeries(1, "sum", "{sum} + 1"));
+  EXPECT_FALSE(plottingIface.addDerivedSeries(1, "/a-x", "{/a-x} + 1"));
+
+  ASSERT_TRUE(plottingIface.addDerivedSeries(1, "sum", "{/a-x} + {/b-y}"));
+
+  // waits for the second input
+  plottingIface.Flush();
+  EXPECT_EQ(plottingIface.Series(1, "sum"), nullptr);
+
+  // evaluated at the times of the first input, interpolating the second one
+  int updates = 0;
+  QObject::connect(&plottingIface, &PlottingInterface::seriesUpdated,
+      [&](int, QString _fieldID, double, double, double, double)
+      {
+        if (_fieldID == "sum")
+          updates++;
+      });
+  plottingIface.onPlotPoints(1, "/b-y", {0.5, 3.0}, {10.0, 35.0});
+  plottingIface.Flush();
+  EXPECT_EQ(updates, 1);
+
+  auto sum = plottingIface.Series(1, "sum");
+  ASSERT_NE(sum, nullptr);
+  ASSERT_EQ(sum->Size(), 2u);
+  EXPECT_DOUBLE_EQ(sum->Time(0), 1.0);
+  EXPECT_DOUBLE_EQ(sum->Value(0), 2.0 + 15.0);
+  EXPECT_DOUBLE_EQ(sum->Value(1), 3.0 + 25.0);
+
+  // only the new samples are evaluated
+  plottingIface.onPlotPoints(1, "/a-x", {3.0}, {4.0});
+  plottingIface.Flush();
+  EXPECT_EQ(sum->Size(), 3u);
+  EXPECT_DOUBLE_EQ(sum->Value(2), 4.0 + 35.0);
+
+  // derived series of other charts are independent
+  EXPECT_EQ(plottingIface.Series(2, "sum"), nullptr);
+
+  // redefining restarts the series, the non-finite values are dropped
+  ASSERT_TRUE(plottingIface.addDerivedSeries(1, "sum", "deriv({/a-x})"));
+  EXPECT_EQ(plottingIface.Series(1, "sum"), nullptr);
+  plottingIface.Flush();
+  sum = plottingIface.Series(1, "sum");
+  ASSERT_NE(sum, nullptr);
+  EXPECT_EQ(sum->Size(), 3u);
+  EXPECT_DOUBLE_EQ(sum->Value(0), 1.0);
+
+  plottingIface.removeDerivedSeries(1, "sum");
+  EXPECT_EQ(plottingIface.Series(1, "sum"), nullptr);
+  plottingIface.Flush();
+  EXPECT_EQ(plottingIface.Series(1, "sum"), nullptr);
+}
+
+//////////////////////////////////////////////////
+TEST(PlottingInterfaceTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(SharedSeries))
+{
+  common::Console::SetVerbosity(4);
+  Application app(g_argc, g_argv);
+
+  PlottingInterface plottingIface;
+
+  std::map<int, int> updates;
+  QObject::connect(&plottingIface, &PlottingInterface::seriesUpdated,
+      [&](int _chart, QString, double, double, double, double)
+      {
+        updates[_chart]++;
+      });
+
+  // the samples of a field plotted on 2 charts are stored once
+  plottingIface.onSeriesPoints({1, 2}, "/topic-data", {0.0, 1.0, 2.0},
+                               {1.0, 2.0, 3.0});
+  auto series = plottingIface.Series(1, "/topic-data");
+  ASSERT_NE(series, nullptr);
+  EXPECT_EQ(series, plottingIface.Series(2, "/topic-data"));
+  EXPECT_EQ(series->Size(), 3u);
+  EXPECT_EQ(plottingIface.Series(3, "/topic-data"), nullptr);
+  EXPECT_EQ(plottingIface.Stats(1, "/topic-data"),
+            plottingIface.Stats(2, "/topic-data"));
+
+  // both charts are notified
+  plottingIface.Flush();
+  EXPECT_EQ(updates[1], 1);
+  EXPECT_EQ(updates[2], 1);
+
+  // points sent to each chart are stored once too
+  plottingIface.onPlot(1, "/topic-data", 3.0, 4.0);
+  plottingIface.onPlot(2, "/topic-data", 3.0, 4.0);
+  plottingIface.onPlotPoints(1, "/topic-data", {4.0}, {5.0});
+  plottingIface.onPlotPoints(2, "/topic-data", {4.0}, {5.0});
+  EXPECT_EQ(series->Size(), 5u);
+
+  // the samples are kept while a chart plots the field
+  plottingIface.unsubscribe(1, "/topic", "data");
+  EXPECT_EQ(plottingIface.Series(1, "/topic-data"), nullptr);
+  EXPECT_EQ(plottingIface.Series(2, "/topic-data"), series);
+  plottingIface.onPlot(2, "/topic-data", 5.0, 6.0);
+  EXPECT_EQ(series->Size(), 6u);
+
+  plottingIface.unsubscribe(2, "/topic", "data");
+  EXPECT_EQ(plottingIface.Series(2, "/topic-data"), nullptr);
+}
+
+//////////////////////////////////////////////////
+TEST(PlottingInterfaceTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Trigger))
+{
+  common::Console::SetVerbosity(4);
+  Application app(g_argc, g_argv);
+
+  PlottingInterface plottingIface;
+
+  int updates = 0;
+  QObject::connect(&plottingIface, &PlottingInterface::seriesUpdated,
+      [&](int, QString, double, double, double, double)
+      {
+        updates++;
+      });
+  std::vector<double> captures;
+  QObject::connect(&plottingIface, &PlottingInterface::captureCompleted,
+      [&](double _time, double, double)
+      {
+        captures.push_back(_time);
+      });
+
+  EXPECT_FALSE(plottingIface.setTrigger("", "rising", 0, 1, 1, false));
+  EXPECT_FALSE(plottingIface.setTrigger("/topic-a", "sideways", 0, 1, 1,
+                                        false));
+  EXPECT_FALSE(plottingIface.TriggerEnabled());
+
+  ASSERT_TRUE(plottingIface.setTrigger("/topic-a", "rising", 5, 1, 2, true));
+  EXPECT_TRUE(plottingIface.TriggerEnabled());
+  EXPECT_TRUE(plottingIface.TriggerArmed());
+
+  // a square wave crossing the threshold upwards at t = 10 and t = 20
+  auto step = [&](double _from, double _to)
+  {
+    for (double t = _from; t < _to; t += 0.5)
+    {
+      double a = (static_cast<int>(t) / 10) % 2 ? 10.0 : 0.0;
+      plottingIface.onSeriesPoints({1}, "/topic-a", {t}, {a});
+      plottingIface.onSeriesPoints({1}, "/topic-b", {t}, {t});
+    }
+  };
+
+  // nothing is drawn while waiting for the trigger
+  step(0, 11);
+  plottingIface.Flush();
+  EXPECT_EQ(updates, 0);
+  EXPECT_TRUE(captures.empty());
+  EXPECT_EQ(plottingIface.Capture(1, "/topic-b"), nullptr);
+
+  // the capture completes once the post-trigger duration elapsed
+  step(11, 13);
+  plottingIface.Flush();
+  ASSERT_EQ(captures.size(), 1u);
+  EXPECT_DOUBLE_EQ(captures[0], 10.0);
+  EXPECT_EQ(updates, 2);
+
+  auto capture = plottingIface.Capture(1, "/topic-b");
+  ASSERT_NE(capture, nullptr);
+  ASSERT_EQ(capture->Size(), 7u);
+  EXPECT_DOUBLE_EQ(capture->Time(0), 9.0);
+  EXPECT_DOUBLE_EQ(capture->Time(6), 12.0);
+
+  // single shot: no capture of the next crossing until armed again
+  EXPECT_FALSE(plottingIface.TriggerArmed());
+  step(13, 25);
+  plottingIface.Flush();
+  EXPECT_EQ(captures.size(), 1u);
+
+  plottingIface.armTrigger();
+  EXPECT_TRUE(plottingIface.TriggerArmed());
+  step(25, 31);
+  plottingIface.Flush();
+  EXPECT_EQ(captures.size(), 1u);
+  step(31, 33);
+  plottingIface.Flush();
+  ASSERT_EQ(captures.size(), 2u);
+  EXPECT_DOUBLE_EQ(captures[1], 30.0);
+
+  // back to the continuous mode
+  updates = 0;
+  plottingIface.clearTrigger();
+  EXPECT_FALSE(plottingIface.TriggerEnabled());
+  EXPECT_EQ(plottingIface.Capture(1, "/topic-b"), nullptr);
+  EXPECT_EQ(updates, 2);
+}
+
+//////////////////////////////////////////////////
+TEST(PlottingInterfaceTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(XYSeries))
+{
+  common::Console::SetVerbosity(4);
+  Application app(g_argc, g_argv);
+
+  PlottingInterface plottingIface;
+
+  int updates = 0;
+  QObject::connect(&plottingIface, &PlottingInterface::xySeriesUpdated,
+      [&](int _chart, QString _name, double _minX, double _maxX,
+          double _minY, double _maxY)
+      {
+        EXPECT_EQ(_chart, 1);
+        EXPECT_EQ(_name, "trajectory");
+        EXPECT_DOUBLE_EQ(_minX, 0);
+        EXPECT_DOUBLE_EQ(_maxX, 3);
+        EXPECT_DOUBLE_EQ(_minY, 0);
+        EXPECT_DOUBLE_EQ(_maxY, 9);
+        updates++;
+      });
+
+  // the ID is taken by a field
+  plottingIface.onSeriesPoints({1}, "/pose-x", {0.0}, {0.0});
+  EXPECT_FALSE(plottingIface.AddXYSeries(1, "/pose-x", "/pose-x", "/odom-y"));
+
+  ASSERT_TRUE(plottingIface.AddXYSeries(1, "trajectory", "/pose-x",
+                                        "/odom-y", 0.01));
+  EXPECT_FALSE(plottingIface.addDerivedSeries(1, "trajectory", "1"));
+
+  // the fields of different topics are paired by time
+  plottingIface.onSeriesPoints({1}, "/pose-x", {1.0, 2.0, 3.0},
+                               {1.0, 2.0, 3.0});
+  plottingIface.onSeriesPoints({1}, "/odom-y", {0.005, 1.002, 1.5, 2.0, 3.0},
+                               {0.0, 1.0, -1.0, 4.0, 9.0});
+  plottingIface.Flush();
+  EXPECT_EQ(updates, 1);
+
+  std::vector<double> x;
+  std::vector<double> y;
+  ASSERT_TRUE(plottingIface.XYPoints(1, "trajectory", x, y));
+  EXPECT_EQ(x, std::vector<double>({0, 1, 2, 3}));
+  EXPECT_EQ(y, std::vector<double>({0, 1, 4, 9}));
+
+  // nothing new
+  plottingIface.Flush();
+  EXPECT_EQ(updates, 1);
+
+  EXPECT_FALSE(plottingIface.XYPoints(2, "trajectory", x, y));
+  plottingIface.removeXYSeries(1, "trajectory");
+  EXPECT_FALSE(plottingIface.XYPoints(1, "trajectory", x, y));
+}
+
+//////////////////////////////////////////////////
+TEST(PlottingInterfaceTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Recording))
+{
+  common::Console::SetVerbosity(4);
+  Application app(g_argc, g_argv);
+
+  PlottingInterface plottingIface;
+
+  int updates = 0;
+  QObject::connect(&plottingIface, &PlottingInterface::seriesUpdated,
+      [&](int _chart, QString _fieldID, double _minX, double _maxX,
+          double _minY, double _maxY)
+      {
+        EXPECT_EQ(_chart, 1);
+        EXPECT_EQ(_fieldID, "/topic-data");
+        EXPECT_DOUBLE_EQ(_minX, 0);
+        EXPECT_DOUBLE_EQ(_maxX, 2);
+        EXPECT_DOUBLE_EQ(_minY, -1);
+        EXPECT_DOUBLE_EQ(_maxY, 5);
+        updates++;
+      });
+
+  SeriesSnapshot snapshot;
+  snapshot.name = "/topic-data";
+  snapshot.times = {0, 1, 2};
+  snapshot.values = {5, -1, 3};
+  auto path = common::joinPaths(
+      std::string(PROJECT_BINARY_PATH), "recording.bin");
+  ASSERT_TRUE(WriteSeriesBinary(path, snapshot));
+
+  EXPECT_TRUE(plottingIface.openRecording(1, "/does/not/exist").isEmpty());
+  EXPECT_EQ(plottingIface.openRecording(1, QString::fromStdString(
+      "file://" + path)), "/topic-data");
+  ASSERT_NE(plottingIface.Recording(1, "/topic-data"), nullptr);
+  EXPECT_EQ(plottingIface.Recording(1, "/topic-data")->Size(), 3u);
+
+  // already open on that chart
+  EXPECT_TRUE(plottingIface.openRecording(1,
+      QString::fromStdString(path)).isEmpty());
+
+  // the chart is notified once
+  plottingIface.Flush();
+  plottingIface.Flush();
+  EXPECT_EQ(updates, 1);
+
+  plottingIface.closeRecording(1, "/topic-data");
+  EXPECT_EQ(plottingIface.Recording(1, "/topic-data"), nullptr);
 }
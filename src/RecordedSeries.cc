@@ -0,0 +1,474 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#include <QFile>
+
+#include "ignition/gui/RecordedSeries.hh"
+#include "SeriesBinaryHeader.hh"
+
+// Number of blocks of a pyramid level aggregated per block of the next one
+#define PYRAMID_FANOUT 32
+
+namespace
+{
+/// \brief Max length of a CSV line
+const std::size_t kMaxLineLength = 128;
+
+/// \brief Remove the leading and trailing whitespace of a string
+/// \param[in] _str String
+/// \return Trimmed string
+std::string Trim(const std::string &_str)
+{
+  auto first = _str.find_first_not_of(" \t\r");
+  if (first == std::string::npos)
+    return "";
+  auto last = _str.find_last_not_of(" \t\r");
+  return _str.substr(first, last - first + 1);
+}
+}
+
+namespace ignition
+{
+namespace gui
+{
+class RecordedSeriesPrivate
+{
+  /// \brief Read a double of a column, which may be unaligned in the
+  /// mapped file
+  /// \param[in] _column Start of the column
+  /// \param[in] _index Index of the double
+  /// \return Value
+  public: static double Load(const unsigned char *_column,
+                             std::size_t _index)
+  {
+    double value;
+    std::memcpy(&value, _column + _index * sizeof(double), sizeof(double));
+    return value;
+  }
+
+  /// \brief Read the mapped file as a binary series file
+  /// \return True on success
+  public: bool OpenBinary()
+  {
+    std::uint64_t fileSize = static_cast<std::uint64_t>(this->file.size());
+    SeriesBinaryHeader header;
+    if (fileSize < SeriesBinaryHeader::kSize ||
+        !header.Read(reinterpret_cast<const char *>(this->map), fileSize))
+    {
+      return false;
+    }
+
+    this->name.assign(
+        reinterpret_cast<const char *>(this->map + header.NameOffset()),
+        header.nameLength);
+    this->size = static_cast<std::size_t>(header.count);
+    this->times = this->map + header.TimesOffset();
+    this->values = this->times + this->size * sizeof(double);
+    return true;
+  }
+
+  /// \brief Parse the mapped file as a CSV series file, with a
+  /// "time, <name>" header line
+  /// \return True on success
+  public: bool OpenCSV()
+  {
+    auto p = reinterpret_cast<const char *>(this->map);
+    auto end = p + this->file.size();
+
+    auto eol = std::find(p, end, '\n');
+    std::string header(p, eol);
+    auto comma = header.find(',');
+    if (comma == std::string::npos || Trim(header.substr(0, comma)) != "time")
+      return false;
+    this->name = Trim(header.substr(comma + 1));
+
+    char line[kMaxLineLength];
+    p = eol;
+    while (p < end)
+    {
+      // skip the newline
+      p++;
+      eol = std::find(p, end, '\n');
+      std::size_t length = static_cast<std::size_t>(eol - p);
+      if (length > 0 && p[length - 1] == '\r')
+        length--;
+      if (length == 0)
+      {
+        p = eol;
+        continue;
+      }
+      if (length >= sizeof(line))
+        return false;
+
+      // the mapped file isn't null terminated
+      std::memcpy(line, p, length);
+      line[length] = '\0';
+
+      char *next = nullptr;
+      double time = std::strtod(line, &next);
+      if (next == line)
+        return false;
+      while (*next == ' ')
+        next++;
+      if (*next != ',')
+        return false;
+
+      char *valueStart = next + 1;
+      double value = std::strtod(valueStart, &next);
+      if (next == valueStart)
+        return false;
+
+      if (!this->timeColumn.empty() && time < this->timeColumn.back())
+        return false;
+
+      this->timeColumn.push_back(time);
+      this->valueColumn.push_back(value);
+      p = eol;
+    }
+
+    // the parsed columns replace the mapping
+    this->file.unmap(this->map);
+    this->map = nullptr;
+    this->file.close();
+
+    this->size = this->timeColumn.size();
+    this->times = reinterpret_cast<const unsigned char *>(
+        this->timeColumn.data());
+    this->values = reinterpret_cast<const unsigned char *>(
+        this->valueColumn.data());
+    return true;
+  }
+
+  /// \brief Build the min/max pyramid of the values
+  public: void BuildPyramid()
+  {
+    std::size_t count = this->size;
+    std::size_t level = 0;
+    while (count > 1)
+    {
+      std::size_t blocks = (count + PYRAMID_FANOUT - 1) / PYRAMID_FANOUT;
+      this->mins.emplace_back(blocks, std::numeric_limits<double>::max());
+      this->maxs.emplace_back(blocks,
+                              std::numeric_limits<double>::lowest());
+      auto &mins = this->mins.back();
+      auto &maxs = this->maxs.back();
+
+      for (std::size_t b = 0; b < blocks; ++b)
+      {
+        std::size_t first = b * PYRAMID_FANOUT;
+        std::size_t last = std::min(first + PYRAMID_FANOUT, count);
+        double minValue = std::numeric_limits<double>::max();
+        double maxValue = std::numeric_limits<double>::lowest();
+        if (level == 0)
+        {
+          // NaN values fail both comparisons and are ignored
+          for (std::size_t i = first; i < last; ++i)
+          {
+            double value = Load(this->values, i);
+            if (value < minValue)
+              minValue = value;
+            if (value > maxValue)
+              maxValue = value;
+          }
+        }
+        else
+        {
+          auto const &lowerMins = this->mins[level - 1];
+          auto const &lowerMaxs = this->maxs[level - 1];
+          for (std::size_t i = first; i < last; ++i)
+          {
+            minValue = std::min(minValue, lowerMins[i]);
+            maxValue = std::max(maxValue, lowerMaxs[i]);
+          }
+        }
+        mins[b] = minValue;
+        maxs[b] = maxValue;
+      }
+
+      count = blocks;
+      level++;
+    }
+
+    if (this->size == 1)
+    {
+      this->minValue = Load(this->values, 0);
+      this->maxValue = this->minValue;
+    }
+    else if (!this->mins.empty())
+    {
+      this->minValue = this->mins.back()[0];
+      this->maxValue = this->maxs.back()[0];
+    }
+  }
+
+  /// \brief Mapped file
+  public: QFile file;
+
+  /// \brief Start of the mapped file, null if not mapped
+  public: uchar *map = nullptr;
+
+  /// \brief Series name
+  public: std::string name;
+
+  /// \brief Number of samples
+  public: std::size_t size = 0;
+
+  /// \brief Column of the sample times, in the mapped file or timeColumn
+  public: const unsigned char *times = nullptr;
+
+  /// \brief Column of the sample values, in the mapped file or valueColumn
+  public: const unsigned char *values = nullptr;
+
+  /// \brief Sample times parsed from a CSV file
+  public: std::vector<double> timeColumn;
+
+  /// \brief Sample values parsed from a CSV file
+  public: std::vector<double> valueColumn;
+
+  /// \brief Min value of the blocks of each level of the pyramid
+  public: std::vector<std::vector<double>> mins;
+
+  /// \brief Max value of the blocks of each level of the pyramid
+  public: std::vector<std::vector<double>> maxs;
+
+  /// \brief Min value of all the samples
+  public: double minValue = 0;
+
+  /// \brief Max value of all the samples
+  public: double maxValue = 0;
+};
+}
+}
+
+using namespace ignition;
+using namespace gui;
+
+//////////////////////////////////////////////////
+RecordedSeries::RecordedSeries()
+  : dataPtr(std::make_unique<RecordedSeriesPrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+RecordedSeries::~RecordedSeries()
+{
+  this->Close();
+}
+
+//////////////////////////////////////////////////
+bool RecordedSeries::Open(const std::string &_path)
+{
+  this->Close();
+
+  auto d = this->dataPtr.get();
+  d->file.setFileName(QString::fromStdString(_path));
+  if (!d->file.open(QIODevice::ReadOnly) || d->file.size() == 0)
+  {
+    this->Close();
+    return false;
+  }
+
+  d->map = d->file.map(0, d->file.size());
+  if (!d->map || !(d->OpenBinary() || d->OpenCSV()))
+  {
+    this->Close();
+    return false;
+  }
+
+  d->BuildPyramid();
+  return true;
+}
+
+//////////////////////////////////////////////////
+void RecordedSeries::Close()
+{
+  auto d = this->dataPtr.get();
+  if (d->map)
+    d->file.unmap(d->map);
+  d->map = nullptr;
+  d->file.close();
+
+  d->name.clear();
+  d->size = 0;
+  d->times = nullptr;
+  d->values = nullptr;
+  d->timeColumn.clear();
+  d->valueColumn.clear();
+  d->mins.clear();
+  d->maxs.clear();
+  d->minValue = 0;
+  d->maxValue = 0;
+}
+
+//////////////////////////////////////////////////
+const std::string &RecordedSeries::Name() const
+{
+  return this->dataPtr->name;
+}
+
+//////////////////////////////////////////////////
+std::size_t RecordedSeries::Size() const
+{
+  return this->dataPtr->size;
+}
+
+//////////////////////////////////////////////////
+double RecordedSeries::Time(std::size_t _index) const
+{
+  return RecordedSeriesPrivate::Load(this->dataPtr->times, _index);
+}
+
+//////////////////////////////////////////////////
+double RecordedSeries::Value(std::size_t _index) const
+{
+  return RecordedSeriesPrivate::Load(this->dataPtr->values, _index);
+}
+
+//////////////////////////////////////////////////
+std::size_t RecordedSeries::LowerBound(double _time) const
+{
+  std::size_t first = 0;
+  std::size_t count = this->dataPtr->size;
+  while (count > 0)
+  {
+    std::size_t step = count / 2;
+    if (this->Time(first + step) < _time)
+    {
+      first += step + 1;
+      count -= step + 1;
+    }
+    else
+    {
+      count = step;
+    }
+  }
+  return first;
+}
+
+//////////////////////////////////////////////////
+double RecordedSeries::MinValue() const
+{
+  return this->dataPtr->minValue;
+}
+
+//////////////////////////////////////////////////
+double RecordedSeries::MaxValue() const
+{
+  return this->dataPtr->maxValue;
+}
+
+//////////////////////////////////////////////////
+std::size_t RecordedSeries::Levels() const
+{
+  return this->dataPtr->mins.size();
+}
+
+//////////////////////////////////////////////////
+void RecordedSeries::Points(double _minX, double _maxX, unsigned int _pixels,
+                            std::vector<double> &_x,
+                            std::vector<double> &_y) const
+{
+  _x.clear();
+  _y.clear();
+
+  auto d = this->dataPtr.get();
+  std::size_t size = d->size;
+  if (size == 0 || _pixels == 0 || !(_maxX >= _minX))
+    return;
+
+  // sample range, with a sample beyond each side
+  std::size_t first = this->LowerBound(_minX);
+  if (first > 0)
+    first--;
+  std::size_t last = this->LowerBound(_maxX);
+  while (last < size && this->Time(last) <= _maxX)
+    last++;
+  if (last < size)
+    last++;
+
+  std::size_t count = last - first;
+  if (count <= 2 * static_cast<std::size_t>(_pixels))
+  {
+    _x.reserve(count);
+    _y.reserve(count);
+    for (std::size_t i = first; i < last; ++i)
+    {
+      _x.push_back(this->Time(i));
+      _y.push_back(this->Value(i));
+    }
+    return;
+  }
+
+  // coarsest level with blocks of at most a pixel column of samples
+  std::size_t perPixel = count / _pixels;
+  std::size_t level = 0;
+  std::size_t block = 1;
+  while (level < d->mins.size() && block * PYRAMID_FANOUT <= perPixel)
+  {
+    block *= PYRAMID_FANOUT;
+    level++;
+  }
+  std::size_t perBucket = std::max<std::size_t>(1, perPixel / block);
+
+  std::size_t firstBlock = first / block;
+  std::size_t lastBlock = (last + block - 1) / block;
+  _x.reserve(2 * (lastBlock - firstBlock) / perBucket + 2);
+  _y.reserve(2 * (lastBlock - firstBlock) / perBucket + 2);
+  for (std::size_t b = firstBlock; b < lastBlock; b += perBucket)
+  {
+    std::size_t end = std::min(b + perBucket, lastBlock);
+    double minValue = std::numeric_limits<double>::max();
+    double maxValue = std::numeric_limits<double>::lowest();
+    if (level == 0)
+    {
+      for (std::size_t i = b; i < end; ++i)
+      {
+        double value = this->Value(i);
+        if (value < minValue)
+          minValue = value;
+        if (value > maxValue)
+          maxValue = value;
+      }
+    }
+    else
+    {
+      auto const &mins = d->mins[level - 1];
+      auto const &maxs = d->maxs[level - 1];
+      for (std::size_t i = b; i < end; ++i)
+      {
+        minValue = std::min(minValue, mins[i]);
+        maxValue = std::max(maxValue, maxs[i]);
+      }
+    }
+
+    // only NaN values
+    if (minValue > maxValue)
+      continue;
+
+    double time = this->Time(b * block);
+    _x.push_back(time);
+    _y.push_back(minValue);
+    _x.push_back(time);
+    _y.push_back(maxValue);
+  }
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <ignition/common/Filesystem.hh>
+
+#include "test_config.h"  // NOLINT(build/include)
+#include "ignition/gui/RecordedSeries.hh"
+#include "ignition/gui/SeriesExport.hh"
+
+using namespace ignition;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(RecordedSeriesTest, Open)
+{
+  RecordedSeries recorded;
+  EXPECT_EQ(recorded.Size(), 0u);
+  EXPECT_FALSE(recorded.Open("/does/not/exist"));
+
+  SeriesSnapshot snapshot;
+  snapshot.name = "/topic-data";
+  snapshot.times = {0, 0.5, 1, 1.5};
+  snapshot.values = {1, -2, 3, std::nan("")};
+
+  // binary, mapped in place
+  auto binPath = common::joinPaths(
+      std::string(PROJECT_BINARY_PATH), "recorded.bin");
+  ASSERT_TRUE(WriteSeriesBinary(binPath, snapshot));
+  ASSERT_TRUE(recorded.Open(binPath));
+  EXPECT_EQ(recorded.Name(), "/topic-data");
+  ASSERT_EQ(recorded.Size(), 4u);
+  EXPECT_DOUBLE_EQ(recorded.Time(1), 0.5);
+  EXPECT_DOUBLE_EQ(recorded.Value(2), 3);
+  EXPECT_DOUBLE_EQ(recorded.MinValue(), -2);
+  EXPECT_DOUBLE_EQ(recorded.MaxValue(), 3);
+  EXPECT_EQ(recorded.LowerBound(0.7), 2u);
+  EXPECT_EQ(recorded.LowerBound(5), 4u);
+
+  // CSV, parsed
+  auto csvPath = common::joinPaths(
+      std::string(PROJECT_BINARY_PATH), "recorded.csv");
+  ASSERT_TRUE(WriteSeriesCSV(csvPath, snapshot));
+  ASSERT_TRUE(recorded.Open(csvPath));
+  EXPECT_EQ(recorded.Name(), "/topic-data");
+  ASSERT_EQ(recorded.Size(), 4u);
+  EXPECT_DOUBLE_EQ(recorded.Time(3), 1.5);
+  EXPECT_DOUBLE_EQ(recorded.Value(1), -2);
+  EXPECT_DOUBLE_EQ(recorded.MaxValue(), 3);
+
+  // not a series file
+  {
+    std::ofstream file(csvPath);
+    file << "time, data\n1, 2\n0, 3\n";
+  }
+  EXPECT_FALSE(recorded.Open(csvPath));
+  EXPECT_EQ(recorded.Size(), 0u);
+  {
+    std::ofstream file(csvPath);
+    file << "hello\n";
+  }
+  EXPECT_FALSE(recorded.Open(csvPath));
+
+  recorded.Close();
+  EXPECT_TRUE(recorded.Name().empty());
+}
+
+/////////////////////////////////////////////////
+TEST(RecordedSeriesTest, Pyramid)
+{
+  SeriesSnapshot snapshot;
+  snapshot.name = "data";
+  const std::size_t count = 1000000;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    snapshot.times.push_back(i * 0.001);
+    snapshot.values.push_back(std::sin(i * 0.01));
+  }
+  // spike to be kept at any zoom level
+  snapshot.values[123457] = 10;
+
+  auto path = common::joinPaths(
+      std::string(PROJECT_BINARY_PATH), "pyramid.bin");
+  ASSERT_TRUE(WriteSeriesBinary(path, snapshot));
+
+  RecordedSeries recorded;
+  ASSERT_TRUE(recorded.Open(path));
+  EXPECT_EQ(recorded.Levels(), 4u);
+  EXPECT_DOUBLE_EQ(recorded.MaxValue(), 10);
+  EXPECT_NEAR(recorded.MinValue(), -1, 1e-6);
+
+  // whole range on 500 pixels
+  std::vector<double> x;
+  std::vector<double> y;
+  recorded.Points(0, 1000, 500, x, y);
+  ASSERT_EQ(x.size(), y.size());
+  EXPECT_GE(x.size(), 500u);
+  EXPECT_LE(x.size(), 4 * 500u);
+  double maxY = -1;
+  for (std::size_t i = 0; i < y.size(); ++i)
+  {
+    maxY = std::max(maxY, y[i]);
+    if (i > 0)
+      EXPECT_LE(x[i - 1], x[i]);
+  }
+  EXPECT_DOUBLE_EQ(maxY, 10);
+
+  // zoomed in to a few samples, which are all returned with a sample
+  // beyond each side
+  recorded.Points(123.4564, 123.4606, 500, x, y);
+  ASSERT_EQ(x.size(), 6u);
+  EXPECT_DOUBLE_EQ(x.front(), 123.456);
+  EXPECT_DOUBLE_EQ(x.back(), 123.461);
+  EXPECT_DOUBLE_EQ(y[1], 10);
+
+  // invalid range
+  recorded.Points(2, 1, 500, x, y);
+  EXPECT_TRUE(x.empty());
+}
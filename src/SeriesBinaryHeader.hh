@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_GUI_SERIESBINARYHEADER_HH_
+#define IGNITION_GUI_SERIESBINARYHEADER_HH_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ignition
+{
+namespace gui
+{
+/// \brief Header of binary series files, shared by the writer and the
+/// readers so the layout is defined once. The file holds the magic bytes,
+/// the format version, the name length and the sample count, followed by
+/// the name, the time column and the value column, in native byte order.
+class SeriesBinaryHeader
+{
+  /// \brief Size in bytes of the serialized header
+  public: static constexpr std::size_t kSize = 24;
+
+  /// \brief Serialize the header
+  /// \param[out] _data Buffer of kSize bytes
+  public: void Write(char *_data) const;
+
+  /// \brief Deserialize and validate a header. The file size must match
+  /// exactly, so a truncated file or a bogus count is caught before the
+  /// columns are read.
+  /// \param[in] _data First kSize bytes of the file
+  /// \param[in] _fileSize Size in bytes of the whole file
+  /// \return True if the header is valid for that file
+  public: bool Read(const char *_data, std::uint64_t _fileSize);
+
+  /// \brief Get the offset of the name in the file
+  /// \return Offset in bytes
+  public: std::uint64_t NameOffset() const
+  {
+    return kSize;
+  }
+
+  /// \brief Get the offset of the time column in the file, the value
+  /// column follows it
+  /// \return Offset in bytes
+  public: std::uint64_t TimesOffset() const
+  {
+    return kSize + this->nameLength;
+  }
+
+  /// \brief Length in bytes of the series name
+  public: std::uint32_t nameLength = 0;
+
+  /// \brief Number of samples
+  public: std::uint64_t count = 0;
+};
+}
+}
+
+#endif
@@ -0,0 +1,398 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <limits>
+
+#include "ignition/gui/SeriesDecimator.hh"
+#include "ignition/gui/TimeSeries.hh"
+
+/// \brief Bucket width exponent when there's no valid view
+#define NO_VIEW (std::numeric_limits<int>::min())
+
+namespace ignition
+{
+namespace gui
+{
+/// \brief First, last, min and max samples of a bucket
+class Bucket
+{
+  /// \brief Add a sample, samples are expected in x order
+  /// \param[in] _x x coordinate of the sample
+  /// \param[in] _y y coordinate of the sample
+  /// \param[in] _n Number of the sample in the series, see
+  /// TimeSeries::TotalCount
+  public: void Add(double _x, double _y, std::uint64_t _n)
+  {
+    if (this->count == 0)
+    {
+      this->firstX = this->minX = this->maxX = _x;
+      this->firstY = this->minY = this->maxY = _y;
+      this->firstN = this->minN = this->maxN = _n;
+    }
+    else if (_y < this->minY)
+    {
+      this->minX = _x;
+      this->minY = _y;
+      this->minN = _n;
+    }
+    else if (_y > this->maxY)
+    {
+      this->maxX = _x;
+      this->maxY = _y;
+      this->maxN = _n;
+    }
+
+    this->lastX = _x;
+    this->lastY = _y;
+    this->lastN = _n;
+    ++this->count;
+  }
+
+  /// \brief Number of samples in the bucket
+  public: std::uint64_t count = 0;
+
+  /// \brief First sample
+  public: double firstX = 0, firstY = 0;
+
+  /// \brief Last sample
+  public: double lastX = 0, lastY = 0;
+
+  /// \brief Sample with the min value
+  public: double minX = 0, minY = 0;
+
+  /// \brief Sample with the max value
+  public: double maxX = 0, maxY = 0;
+
+  /// \brief Numbers of the first, last, min and max samples in the series
+  public: std::uint64_t firstN = 0, lastN = 0, minN = 0, maxN = 0;
+};
+
+class SeriesDecimatorPrivate
+{
+  /// \brief Get the index of the bucket that holds an x coordinate
+  /// \param[in] _x x coordinate
+  /// \return Bucket index
+  public: std::int64_t BucketIndex(double _x) const
+  {
+    return static_cast<std::int64_t>(std::floor(_x / this->bucketWidth));
+  }
+
+  /// \brief Add a sample to its bucket if it is covered
+  /// \param[in] _x x coordinate of the sample
+  /// \param[in] _y y coordinate of the sample
+  /// \param[in] _n Number of the sample in the series
+  public: void Add(double _x, double _y, std::uint64_t _n);
+
+  /// \brief Add the samples of a series within an x range
+  /// \param[in] _series Series to read the samples from
+  /// \param[in] _from Start of the range, inclusive
+  /// \param[in] _to End of the range, exclusive
+  public: void Scan(const TimeSeries &_series, double _from, double _to);
+
+  /// \brief Min visible x coordinate
+  public: double minX = 0;
+
+  /// \brief Max visible x coordinate
+  public: double maxX = 0;
+
+  /// \brief Width of the buckets, power of two, zero if no valid view
+  public: double bucketWidth = 0;
+
+  /// \brief Exponent of the bucket width, NO_VIEW if no valid view
+  public: int bucketExponent = NO_VIEW;
+
+  /// \brief Index of the first covered bucket
+  public: std::int64_t firstBucket = 0;
+
+  /// \brief Covered buckets, contiguous starting at firstBucket
+  public: std::deque<Bucket> buckets;
+
+  /// \brief Number of samples of the series consumed by the last update
+  public: std::uint64_t consumed = 0;
+
+  /// \brief Number of samples overwritten in the series at the last update
+  public: std::uint64_t overwritten = 0;
+
+  /// \brief True if there's a sample before the covered buckets
+  public: bool hasBefore = false;
+
+  /// \brief Closest sample before the covered buckets
+  public: double beforeX = 0, beforeY = 0;
+
+  /// \brief True if there's a sample after the covered buckets
+  public: bool hasAfter = false;
+
+  /// \brief Closest sample after the covered buckets
+  public: double afterX = 0, afterY = 0;
+};
+}
+}
+
+using namespace ignition;
+using namespace gui;
+
+//////////////////////////////////////////////////
+void SeriesDecimatorPrivate::Add(double _x, double _y, std::uint64_t _n)
+{
+  if (std::isnan(_x) || std::isnan(_y))
+    return;
+
+  std::int64_t index = this->BucketIndex(_x) - this->firstBucket;
+  if (index < 0 || index >= static_cast<std::int64_t>(this->buckets.size()))
+    return;
+
+  this->buckets[index].Add(_x, _y, _n);
+}
+
+//////////////////////////////////////////////////
+void SeriesDecimatorPrivate::Scan(const TimeSeries &_series, double _from,
+                                  double _to)
+{
+  std::uint64_t oldest = _series.TotalCount() - _series.Size();
+  for (std::size_t i = _series.LowerBound(_from);
+       i < _series.Size() && _series.Time(i) < _to; ++i)
+  {
+    this->Add(_series.Time(i), _series.Value(i), oldest + i);
+  }
+}
+
+//////////////////////////////////////////////////
+SeriesDecimator::SeriesDecimator()
+  : dataPtr(std::make_unique<SeriesDecimatorPrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+SeriesDecimator::~SeriesDecimator()
+{
+}
+
+//////////////////////////////////////////////////
+void SeriesDecimator::SetView(double _minX, double _maxX,
+                              unsigned int _pixels)
+{
+  this->dataPtr->minX = _minX;
+  this->dataPtr->maxX = _maxX;
+
+  int bucketExponent = NO_VIEW;
+  double pixelWidth = _pixels > 0 ? (_maxX - _minX) / _pixels : 0;
+  if (pixelWidth > 0 && std::isfinite(pixelWidth))
+  {
+    // round up to a power of two, so the bucket boundaries are exact and
+    // the width only changes when the range doubles or halves
+    bucketExponent = static_cast<int>(std::ceil(std::log2(pixelWidth)));
+  }
+
+  if (bucketExponent != this->dataPtr->bucketExponent)
+  {
+    this->dataPtr->bucketExponent = bucketExponent;
+    this->dataPtr->bucketWidth = bucketExponent == NO_VIEW ?
+        0 : std::ldexp(1.0, bucketExponent);
+    this->Reset();
+  }
+}
+
+//////////////////////////////////////////////////
+double SeriesDecimator::BucketWidth() const
+{
+  return this->dataPtr->bucketWidth;
+}
+
+//////////////////////////////////////////////////
+void SeriesDecimator::Reset()
+{
+  this->dataPtr->buckets.clear();
+  this->dataPtr->hasBefore = false;
+  this->dataPtr->hasAfter = false;
+}
+
+//////////////////////////////////////////////////
+void SeriesDecimator::Update(const TimeSeries &_series)
+{
+  auto d = this->dataPtr.get();
+  if (d->bucketWidth <= 0)
+  {
+    this->Reset();
+    return;
+  }
+
+  // the series has been cleared
+  std::uint64_t total = _series.TotalCount();
+  if (total < d->consumed)
+  {
+    this->Reset();
+    d->overwritten = 0;
+  }
+
+  std::int64_t first = d->BucketIndex(d->minX);
+  std::int64_t last = d->BucketIndex(d->maxX);
+  double width = d->bucketWidth;
+
+  if (d->buckets.empty())
+  {
+    d->firstBucket = first;
+    d->buckets.resize(last - first + 1);
+    d->Scan(_series, first * width, (last + 1) * width);
+  }
+  else
+  {
+    // aggregate the samples appended since the last update into the
+    // buckets that were already covered. Samples that fall in newly covered
+    // buckets are added below when scanning those buckets.
+    std::uint64_t oldest = total - _series.Size();
+    for (std::uint64_t n = std::max(d->consumed, oldest); n < total; ++n)
+    {
+      std::size_t i = static_cast<std::size_t>(n - oldest);
+      d->Add(_series.Time(i), _series.Value(i), n);
+    }
+
+    // drop the samples overwritten in the series since the last update: the
+    // buckets before the oldest sample are emptied and the bucket holding it
+    // is recomputed
+    if (oldest > d->overwritten)
+    {
+      std::int64_t oldestBucket = _series.Empty() ?
+          std::numeric_limits<std::int64_t>::max() :
+          d->BucketIndex(_series.Time(0));
+
+      while (!d->buckets.empty() && d->firstBucket < oldestBucket)
+      {
+        d->buckets.pop_front();
+        ++d->firstBucket;
+      }
+
+      if (!d->buckets.empty() && d->firstBucket == oldestBucket)
+      {
+        d->buckets.front() = Bucket();
+        d->Scan(_series, oldestBucket * width, (oldestBucket + 1) * width);
+      }
+    }
+
+    // drop the buckets out of the view
+    while (!d->buckets.empty() && d->firstBucket < first)
+    {
+      d->buckets.pop_front();
+      ++d->firstBucket;
+    }
+    while (!d->buckets.empty() &&
+           d->firstBucket + static_cast<std::int64_t>(d->buckets.size()) - 1 >
+           last)
+    {
+      d->buckets.pop_back();
+    }
+
+    if (d->buckets.empty())
+    {
+      d->firstBucket = first;
+      d->buckets.resize(last - first + 1);
+      d->Scan(_series, first * width, (last + 1) * width);
+    }
+    else
+    {
+      // cover the newly visible buckets at both sides
+      std::int64_t coveredFirst = d->firstBucket;
+      std::int64_t coveredLast =
+          d->firstBucket + static_cast<std::int64_t>(d->buckets.size()) - 1;
+
+      if (first < coveredFirst)
+      {
+        d->buckets.insert(d->buckets.begin(), coveredFirst - first, Bucket());
+        d->firstBucket = first;
+        d->Scan(_series, first * width, coveredFirst * width);
+      }
+      if (last > coveredLast)
+      {
+        d->buckets.resize(last - d->firstBucket + 1);
+        d->Scan(_series, (coveredLast + 1) * width, (last + 1) * width);
+      }
+    }
+  }
+  d->consumed = total;
+  d->overwritten = total - _series.Size();
+
+  // closest samples out of the covered buckets
+  std::size_t before = _series.LowerBound(first * width);
+  d->hasBefore = before > 0;
+  if (d->hasBefore)
+  {
+    d->beforeX = _series.Time(before - 1);
+    d->beforeY = _series.Value(before - 1);
+  }
+
+  std::size_t after = _series.LowerBound((last + 1) * width);
+  d->hasAfter = after < _series.Size();
+  if (d->hasAfter)
+  {
+    d->afterX = _series.Time(after);
+    d->afterY = _series.Value(after);
+  }
+}
+
+//////////////////////////////////////////////////
+void SeriesDecimator::Points(std::vector<double> &_x,
+                             std::vector<double> &_y) const
+{
+  _x.clear();
+  _y.clear();
+
+  if (this->dataPtr->hasBefore)
+  {
+    _x.push_back(this->dataPtr->beforeX);
+    _y.push_back(this->dataPtr->beforeY);
+  }
+
+  for (auto const &bucket : this->dataPtr->buckets)
+  {
+    if (bucket.count == 0)
+      continue;
+
+    // first, min, max and last in series order, skipping the samples
+    // repeated in the bucket
+    double points[4][2] = {
+        {bucket.firstX, bucket.firstY},
+        {bucket.minX, bucket.minY},
+        {bucket.maxX, bucket.maxY},
+        {bucket.lastX, bucket.lastY}};
+    std::uint64_t numbers[4] = {
+        bucket.firstN, bucket.minN, bucket.maxN, bucket.lastN};
+    if (numbers[2] < numbers[1])
+    {
+      std::swap(points[1][0], points[2][0]);
+      std::swap(points[1][1], points[2][1]);
+      std::swap(numbers[1], numbers[2]);
+    }
+
+    for (int i = 0; i < 4; ++i)
+    {
+      if (i > 0 && numbers[i] == numbers[i - 1])
+        continue;
+
+      _x.push_back(points[i][0]);
+      _y.push_back(points[i][1]);
+    }
+  }
+
+  if (this->dataPtr->hasAfter)
+  {
+    _x.push_back(this->dataPtr->afterX);
+    _y.push_back(this->dataPtr->afterY);
+  }
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "ignition/gui/SeriesDecimator.hh"
+#include "ignition/gui/TimeSeries.hh"
+
+using namespace ignition;
+using namespace gui;
+
+/// \brief Decimate a series from scratch
+/// \param[in] _series Series to decimate
+/// \param[in] _minX Min visible x
+/// \param[in] _maxX Max visible x
+/// \param[in] _pixels Visible width in pixels
+/// \param[out] _x Decimated x coordinates
+/// \param[out] _y Decimated y coordinates
+void decimate(const TimeSeries &_series, double _minX, double _maxX,
+    unsigned int _pixels, std::vector<double> &_x, std::vector<double> &_y)
+{
+  SeriesDecimator decimator;
+  decimator.SetView(_minX, _maxX, _pixels);
+  decimator.Update(_series);
+  decimator.Points(_x, _y);
+}
+
+/////////////////////////////////////////////////
+TEST(SeriesDecimatorTest, Bounded)
+{
+  TimeSeries series(200000);
+  for (int i = 0; i < 200000; ++i)
+    series.Append(i * 0.001, std::sin(i * 0.01));
+
+  std::vector<double> x;
+  std::vector<double> y;
+  decimate(series, 0, 200, 500, x, y);
+
+  // at most 4 points per bucket, and buckets are at least a pixel wide
+  EXPECT_FALSE(x.empty());
+  EXPECT_LE(x.size(), 4u * 501u);
+  EXPECT_EQ(x.size(), y.size());
+  EXPECT_TRUE(std::is_sorted(x.begin(), x.end()));
+
+  // the extremes are kept
+  EXPECT_NEAR(*std::max_element(y.begin(), y.end()), 1.0, 1e-6);
+  EXPECT_NEAR(*std::min_element(y.begin(), y.end()), -1.0, 1e-6);
+}
+
+/////////////////////////////////////////////////
+TEST(SeriesDecimatorTest, Spike)
+{
+  TimeSeries series(100000);
+  for (int i = 0; i < 100000; ++i)
+    series.Append(i * 0.001, i == 54321 ? 100.0 : 0.0);
+
+  std::vector<double> x;
+  std::vector<double> y;
+  decimate(series, 0, 100, 100, x, y);
+
+  auto spike = std::max_element(y.begin(), y.end());
+  ASSERT_NE(spike, y.end());
+  EXPECT_DOUBLE_EQ(*spike, 100.0);
+  EXPECT_DOUBLE_EQ(x[spike - y.begin()], 54.321);
+}
+
+/////////////////////////////////////////////////
+TEST(SeriesDecimatorTest, Edges)
+{
+  TimeSeries series(100);
+  for (int i = 0; i < 100; ++i)
+    series.Append(i, i);
+
+  std::vector<double> x;
+  std::vector<double> y;
+  decimate(series, 20.5, 40.5, 1000, x, y);
+
+  // one sample at each side of the visible range
+  ASSERT_FALSE(x.empty());
+  EXPECT_LT(x.front(), 20.5);
+  EXPECT_GT(x.back(), 40.5);
+
+  // no samples to decimate
+  decimate(TimeSeries(10), 0, 10, 100, x, y);
+  EXPECT_TRUE(x.empty());
+
+  // invalid view
+  decimate(series, 10, 0, 100, x, y);
+  EXPECT_TRUE(x.empty());
+  decimate(series, 0, 10, 0, x, y);
+  EXPECT_TRUE(x.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(SeriesDecimatorTest, Incremental)
+{
+  TimeSeries series(5000);
+  SeriesDecimator decimator;
+
+  std::vector<double> x;
+  std::vector<double> y;
+  std::vector<double> expectedX;
+  std::vector<double> expectedY;
+
+  // stream samples while the view follows and grows, as in a live chart,
+  // then pan and zoom
+  int sample = 0;
+  double minX = 0;
+  double maxX = 10;
+  for (int step = 0; step < 60; ++step)
+  {
+    for (int i = 0; i < 97; ++i, ++sample)
+      series.Append(sample * 0.01, std::sin(sample * 0.37) * sample);
+
+    if (step < 30)
+      maxX = std::max(maxX, sample * 0.01);
+    else if (step < 45)
+    {
+      minX -= 0.3;
+      maxX -= 0.3;
+    }
+    else
+    {
+      minX += 0.5;
+      maxX += 2.0;
+    }
+
+    decimator.SetView(minX, maxX, 300);
+    decimator.Update(series);
+    decimator.Points(x, y);
+
+    decimate(series, minX, maxX, 300, expectedX, expectedY);
+    EXPECT_EQ(x, expectedX) << "step " << step;
+    EXPECT_EQ(y, expectedY) << "step " << step;
+  }
+
+  // a cleared series is decimated from scratch
+  series.Clear();
+  series.Append(minX, 1.0);
+  decimator.Update(series);
+  decimator.Points(x, y);
+  ASSERT_EQ(x.size(), 1u);
+  EXPECT_DOUBLE_EQ(y[0], 1.0);
+}
@@ -0,0 +1,244 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "ignition/gui/SeriesExport.hh"
+#include "ignition/gui/TimeSeries.hh"
+#include "SeriesBinaryHeader.hh"
+
+// Number of samples written between progress reports
+#define CHUNK_SIZE (1 << 16)
+// Size in bytes of the CSV text buffered before writing it to the file
+#define CSV_BUFFER_SIZE (1 << 20)
+
+namespace
+{
+/// \brief Magic bytes at the start of binary series files
+const char kMagic[8] = {'I', 'G', 'N', 'S', 'E', 'R', 'I', 'E'};
+
+/// \brief Version of the binary series format
+const std::uint32_t kVersion = 1;
+
+/// \brief Write a column of doubles, reporting the progress per chunk
+/// \param[in] _file Output file
+/// \param[in] _column Column to write
+/// \param[in] _offset Number of samples written before this column, to
+/// report the progress of the whole file
+/// \param[in] _progress Progress callback
+/// \return True on success
+bool WriteColumn(std::ofstream &_file, const std::vector<double> &_column,
+                 std::size_t _offset,
+                 const ignition::gui::SeriesProgressCallback &_progress)
+{
+  for (std::size_t i = 0; i < _column.size(); i += CHUNK_SIZE)
+  {
+    std::size_t count = std::min<std::size_t>(CHUNK_SIZE, _column.size() - i);
+    _file.write(reinterpret_cast<const char *>(_column.data() + i),
+                static_cast<std::streamsize>(count * sizeof(double)));
+    if (!_file)
+      return false;
+
+    if (_progress && !_progress(_offset + (i + count) / 2))
+      return false;
+  }
+  return true;
+}
+}
+
+using namespace ignition;
+using namespace gui;
+
+//////////////////////////////////////////////////
+void SeriesBinaryHeader::Write(char *_data) const
+{
+  std::memcpy(_data, kMagic, sizeof(kMagic));
+  _data += sizeof(kMagic);
+  std::memcpy(_data, &kVersion, sizeof(kVersion));
+  _data += sizeof(kVersion);
+  std::memcpy(_data, &this->nameLength, sizeof(this->nameLength));
+  _data += sizeof(this->nameLength);
+  std::memcpy(_data, &this->count, sizeof(this->count));
+}
+
+//////////////////////////////////////////////////
+bool SeriesBinaryHeader::Read(const char *_data, std::uint64_t _fileSize)
+{
+  static_assert(kSize == sizeof(kMagic) + sizeof(kVersion) +
+      sizeof(nameLength) + sizeof(count), "Unexpected header size");
+
+  if (_fileSize < kSize || std::memcmp(_data, kMagic, sizeof(kMagic)) != 0)
+    return false;
+  _data += sizeof(kMagic);
+
+  std::uint32_t version = 0;
+  std::memcpy(&version, _data, sizeof(version));
+  _data += sizeof(version);
+  std::memcpy(&this->nameLength, _data, sizeof(this->nameLength));
+  _data += sizeof(this->nameLength);
+  std::memcpy(&this->count, _data, sizeof(this->count));
+
+  return version == kVersion &&
+      this->count <= (_fileSize - kSize) / (2 * sizeof(double)) &&
+      _fileSize == this->TimesOffset() + 2 * this->count * sizeof(double);
+}
+
+//////////////////////////////////////////////////
+SeriesSnapshot::SeriesSnapshot(const std::string &_name,
+                               const TimeSeries &_series)
+  : name(_name)
+{
+  TimeSeriesSpan first;
+  TimeSeriesSpan second;
+  _series.Spans(first, second);
+
+  this->times.reserve(_series.Size());
+  this->values.reserve(_series.Size());
+  for (auto const &span : {first, second})
+  {
+    this->times.insert(this->times.end(), span.times,
+                       span.times + span.size);
+    this->values.insert(this->values.end(), span.values,
+                        span.values + span.size);
+  }
+}
+
+//////////////////////////////////////////////////
+bool ignition::gui::WriteSeriesCSV(const std::string &_path,
+                                   const SeriesSnapshot &_series,
+                                   const SeriesProgressCallback &_progress)
+{
+  std::ofstream file(_path, std::ios::out | std::ios::binary);
+  if (!file.is_open())
+    return false;
+
+  std::string buffer;
+  buffer.reserve(CSV_BUFFER_SIZE + 64);
+  buffer += "time, " + _series.name + "\n";
+
+  std::size_t count = std::min(_series.times.size(), _series.values.size());
+  char line[64];
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    int length = std::snprintf(line, sizeof(line), "%.15g, %.15g\n",
+                               _series.times[i], _series.values[i]);
+    buffer.append(line, static_cast<std::size_t>(length));
+
+    if (buffer.size() >= CSV_BUFFER_SIZE)
+    {
+      file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+      buffer.clear();
+      if (!file)
+        return false;
+    }
+
+    if (_progress && (i + 1) % CHUNK_SIZE == 0 && !_progress(i + 1))
+      return false;
+  }
+
+  file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+  file.close();
+  if (!file)
+    return false;
+
+  return !_progress || _progress(count);
+}
+
+//////////////////////////////////////////////////
+bool ignition::gui::WriteSeriesBinary(const std::string &_path,
+                                      const SeriesSnapshot &_series,
+                                      const SeriesProgressCallback &_progress)
+{
+  if (_series.times.size() != _series.values.size())
+    return false;
+
+  std::ofstream file(_path, std::ios::out | std::ios::binary);
+  if (!file.is_open())
+    return false;
+
+  SeriesBinaryHeader header;
+  header.nameLength = static_cast<std::uint32_t>(_series.name.size());
+  header.count = static_cast<std::uint64_t>(_series.times.size());
+
+  char headerData[SeriesBinaryHeader::kSize];
+  header.Write(headerData);
+  file.write(headerData, sizeof(headerData));
+  file.write(_series.name.data(), header.nameLength);
+
+  // each column counts for half of the progress
+  if (!WriteColumn(file, _series.times, 0, _progress) ||
+      !WriteColumn(file, _series.values, _series.times.size() / 2, _progress))
+  {
+    return false;
+  }
+
+  file.close();
+  if (!file)
+    return false;
+
+  return !_progress || _progress(_series.times.size());
+}
+
+//////////////////////////////////////////////////
+bool ignition::gui::WriteSeries(const std::string &_path,
+                                const SeriesSnapshot &_series,
+                                SeriesFormat _format,
+                                const SeriesProgressCallback &_progress)
+{
+  if (_format == SeriesFormat::BINARY)
+    return WriteSeriesBinary(_path, _series, _progress);
+
+  return WriteSeriesCSV(_path, _series, _progress);
+}
+
+//////////////////////////////////////////////////
+bool ignition::gui::ReadSeriesBinary(const std::string &_path,
+                                     SeriesSnapshot &_series)
+{
+  std::ifstream file(_path, std::ios::in | std::ios::binary | std::ios::ate);
+  if (!file.is_open())
+    return false;
+
+  auto fileSize = static_cast<std::uint64_t>(file.tellg());
+  file.seekg(0);
+
+  // the header is validated before allocating the columns
+  char headerData[SeriesBinaryHeader::kSize];
+  SeriesBinaryHeader header;
+  if (fileSize < sizeof(headerData) ||
+      !file.read(headerData, sizeof(headerData)) ||
+      !header.Read(headerData, fileSize))
+  {
+    return false;
+  }
+
+  _series.name.resize(header.nameLength);
+  _series.times.resize(header.count);
+  _series.values.resize(header.count);
+
+  auto columnSize =
+      static_cast<std::streamsize>(header.count * sizeof(double));
+  file.read(&_series.name[0], header.nameLength);
+  file.read(reinterpret_cast<char *>(_series.times.data()), columnSize);
+  file.read(reinterpret_cast<char *>(_series.values.data()), columnSize);
+
+  return static_cast<bool>(file);
+}
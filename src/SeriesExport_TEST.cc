@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <ignition/common/Filesystem.hh>
+
+#include "test_config.h"  // NOLINT(build/include)
+#include "ignition/gui/SeriesExport.hh"
+#include "ignition/gui/TimeSeries.hh"
+
+using namespace ignition;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(SeriesExportTest, Snapshot)
+{
+  // wrapped around ring buffer
+  TimeSeries series(4);
+  for (int i = 0; i < 6; ++i)
+    series.Append(i, 10 + i);
+
+  SeriesSnapshot snapshot("/topic-data", series);
+  EXPECT_EQ(snapshot.name, "/topic-data");
+  ASSERT_EQ(snapshot.times.size(), 4u);
+  ASSERT_EQ(snapshot.values.size(), 4u);
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    EXPECT_DOUBLE_EQ(snapshot.times[i], 2.0 + i);
+    EXPECT_DOUBLE_EQ(snapshot.values[i], 12.0 + i);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(SeriesExportTest, CSV)
+{
+  SeriesSnapshot snapshot;
+  snapshot.name = "data";
+  snapshot.times = {0.5, 1.5};
+  snapshot.values = {-1, 2.25};
+
+  auto path = common::joinPaths(
+      std::string(PROJECT_BINARY_PATH), "series.csv");
+  ASSERT_TRUE(WriteSeriesCSV(path, snapshot));
+
+  std::ifstream file(path);
+  std::stringstream content;
+  content << file.rdbuf();
+  EXPECT_EQ(content.str(), "time, data\n0.5, -1\n1.5, 2.25\n");
+
+  // can't write to a directory
+  EXPECT_FALSE(WriteSeriesCSV(PROJECT_BINARY_PATH, snapshot));
+}
+
+/////////////////////////////////////////////////
+TEST(SeriesExportTest, Binary)
+{
+  SeriesSnapshot snapshot;
+  snapshot.name = "/imu-linear_acceleration-x";
+  for (int i = 0; i < 200000; ++i)
+  {
+    snapshot.times.push_back(i * 0.001);
+    snapshot.values.push_back(i % 7 - 3.5);
+  }
+
+  // the progress is reported up to the sample count
+  std::size_t lastProgress = 0;
+  int reports = 0;
+  auto path = common::joinPaths(
+      std::string(PROJECT_BINARY_PATH), "series.bin");
+  ASSERT_TRUE(WriteSeries(path, snapshot, SeriesFormat::BINARY,
+      [&](std::size_t _written)
+      {
+        EXPECT_GE(_written, lastProgress);
+        lastProgress = _written;
+        reports++;
+        return true;
+      }));
+  EXPECT_GT(reports, 1);
+  EXPECT_EQ(lastProgress, snapshot.times.size());
+
+  SeriesSnapshot read;
+  ASSERT_TRUE(ReadSeriesBinary(path, read));
+  EXPECT_EQ(read.name, snapshot.name);
+  EXPECT_EQ(read.times, snapshot.times);
+  EXPECT_EQ(read.values, snapshot.values);
+
+  // cancelled writing
+  EXPECT_FALSE(WriteSeriesBinary(path, snapshot,
+      [](std::size_t) { return false; }));
+
+  // not a series file
+  auto csvPath = common::joinPaths(
+      std::string(PROJECT_BINARY_PATH), "series.csv");
+  ASSERT_TRUE(WriteSeriesCSV(csvPath, snapshot));
+  EXPECT_FALSE(ReadSeriesBinary(csvPath, read));
+
+  // truncated file
+  ASSERT_TRUE(WriteSeriesBinary(path, snapshot));
+  std::string content;
+  {
+    std::ifstream file(path, std::ios::binary);
+    std::stringstream stream;
+    stream << file.rdbuf();
+    content = stream.str();
+  }
+  {
+    std::ofstream file(path, std::ios::binary);
+    file.write(content.data(), content.size() - 8);
+  }
+  EXPECT_FALSE(ReadSeriesBinary(path, read));
+
+  EXPECT_FALSE(ReadSeriesBinary("/does/not/exist", read));
+}
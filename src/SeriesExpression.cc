@@ -0,0 +1,849 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <locale>
+#include <sstream>
+#include <utility>
+
+#include "ignition/gui/SeriesExpression.hh"
+#include "ignition/gui/TimeSeries.hh"
+
+namespace
+{
+/// \brief Function of one argument
+using Function1 = double (*)(double);
+
+/// \brief Function of two arguments
+using Function2 = double (*)(double, double);
+
+/// \brief Functions of one argument by name
+const std::pair<const char *, Function1> kFunctions1[] =
+{
+  {"abs", [](double _x) { return std::abs(_x); }},
+  {"sqrt", [](double _x) { return std::sqrt(_x); }},
+  {"exp", [](double _x) { return std::exp(_x); }},
+  {"log", [](double _x) { return std::log(_x); }},
+  {"sin", [](double _x) { return std::sin(_x); }},
+  {"cos", [](double _x) { return std::cos(_x); }},
+  {"tan", [](double _x) { return std::tan(_x); }},
+  {"asin", [](double _x) { return std::asin(_x); }},
+  {"acos", [](double _x) { return std::acos(_x); }},
+  {"atan", [](double _x) { return std::atan(_x); }},
+  {"floor", [](double _x) { return std::floor(_x); }},
+  {"ceil", [](double _x) { return std::ceil(_x); }},
+};
+
+/// \brief Functions of two arguments by name
+const std::pair<const char *, Function2> kFunctions2[] =
+{
+  {"atan2", [](double _y, double _x) { return std::atan2(_y, _x); }},
+  {"hypot", [](double _x, double _y) { return std::hypot(_x, _y); }},
+  {"min", [](double _a, double _b) { return std::min(_a, _b); }},
+  {"max", [](double _a, double _b) { return std::max(_a, _b); }},
+  {"pow", [](double _x, double _y) { return std::pow(_x, _y); }},
+};
+
+/// \brief Instruction of a compiled expression
+class Instruction
+{
+  /// \brief Operations, each pops its operands from the stack and pushes
+  /// its result
+  public: enum Op
+  {
+    CONSTANT,
+    INPUT,
+    TIME,
+    ADD,
+    SUB,
+    MUL,
+    DIV,
+    POW,
+    NEG,
+    FUNCTION1,
+    FUNCTION2,
+    DERIV,
+    INTEGRAL
+  };
+
+  /// \brief Operation
+  public: Op op;
+
+  /// \brief Index of the constant, input, function or state of the operation
+  public: std::size_t arg = 0;
+};
+
+/// \brief State of a deriv or integral operation between samples
+class OpState
+{
+  /// \brief True once a sample has been processed
+  public: bool started = false;
+
+  /// \brief Time of the previous sample
+  public: double time = 0;
+
+  /// \brief Value of the previous sample
+  public: double value = 0;
+
+  /// \brief Last output, the derivative or the integral
+  public: double output = 0;
+};
+
+/// \brief Result of aligning an input to a sample time
+enum class AlignResult
+{
+  /// \brief The input value is available
+  READY,
+
+  /// \brief The input needs more samples
+  WAIT,
+
+  /// \brief The input has no value for that time, nor will it ever have
+  SKIP
+};
+
+/// \brief Get the value of a series at a time
+/// \param[in] _series Input series
+/// \param[in] _time Sample time
+/// \param[in] _alignment Alignment
+/// \param[out] _value Input value, if ready
+/// \return Alignment result
+AlignResult AlignedValue(const ignition::gui::TimeSeries &_series,
+                         double _time,
+                         ignition::gui::SeriesAlignment _alignment,
+                         double &_value)
+{
+  std::size_t size = _series.Size();
+  if (size == 0)
+    return AlignResult::WAIT;
+
+  // the inputs are aligned on exactly the same times, samples of the same
+  // message share the same time. The lower bound isn't before the time, so
+  // it's at the time if it isn't after it either.
+  std::size_t index = _series.LowerBound(_time);
+  if (index < size && !(_time < _series.Time(index)))
+  {
+    _value = _series.Value(index);
+    return AlignResult::READY;
+  }
+
+  // the input started after that time
+  if (index == 0)
+    return AlignResult::SKIP;
+
+  if (_alignment == ignition::gui::SeriesAlignment::HOLD)
+  {
+    _value = _series.Value(index - 1);
+    return AlignResult::READY;
+  }
+
+  if (index == size)
+    return AlignResult::WAIT;
+
+  double t0 = _series.Time(index - 1);
+  double t1 = _series.Time(index);
+  double v0 = _series.Value(index - 1);
+  double v1 = _series.Value(index);
+  _value = v0 + (v1 - v0) * (_time - t0) / (t1 - t0);
+  return AlignResult::READY;
+}
+}
+
+namespace ignition
+{
+namespace gui
+{
+class SeriesExpressionPrivate
+{
+  /// \brief Parse a sum of terms
+  /// \return False on error
+  public: bool ParseSum();
+
+  /// \brief Parse a product of factors
+  /// \return False on error
+  public: bool ParseProduct();
+
+  /// \brief Parse a factor with an optional minus sign
+  /// \return False on error
+  public: bool ParseUnary();
+
+  /// \brief Parse a factor with an optional exponent
+  /// \return False on error
+  public: bool ParsePower();
+
+  /// \brief Parse a number, input, constant, function call or parenthesis
+  /// \return False on error
+  public: bool ParsePrimary();
+
+  /// \brief Skip the whitespaces
+  public: void SkipSpaces();
+
+  /// \brief Skip the whitespaces and check the next character
+  /// \param[in] _c Expected character
+  /// \return True if the next character is _c, which is then consumed
+  public: bool Accept(char _c);
+
+  /// \brief Set the compilation error at the current position
+  /// \param[in] _message Error message
+  /// \return False
+  public: bool Fail(const std::string &_message);
+
+  /// \brief Append an instruction, tracking the stack depth
+  /// \param[in] _op Operation
+  /// \param[in] _arg Operation argument
+  /// \param[in] _depth Change of the stack depth
+  public: void Emit(Instruction::Op _op, std::size_t _arg, int _depth);
+
+  /// \brief Expression text being compiled
+  public: std::string text;
+
+  /// \brief Position of the parser in the text
+  public: std::size_t pos = 0;
+
+  /// \brief True if the expression has been compiled
+  public: bool valid = false;
+
+  /// \brief Compilation error
+  public: std::string error;
+
+  /// \brief Input series names
+  public: std::vector<std::string> inputs;
+
+  /// \brief Compiled program
+  public: std::vector<Instruction> program;
+
+  /// \brief Constants of the program
+  public: std::vector<double> constants;
+
+  /// \brief State of the deriv and integral operations
+  public: std::vector<OpState> states;
+
+  /// \brief Stack depth while compiling
+  public: int depth = 0;
+
+  /// \brief Max stack depth of the program
+  public: int maxDepth = 0;
+
+  /// \brief Stack of columns of the evaluation
+  public: std::vector<std::vector<double>> stack;
+
+  /// \brief Input alignment
+  public: SeriesAlignment alignment = SeriesAlignment::INTERPOLATE;
+
+  /// \brief Number of samples of the first input processed by the updates
+  public: std::uint64_t processed = 0;
+
+  /// \brief Sample times of the update batch
+  public: std::vector<double> batchTimes;
+
+  /// \brief Input columns of the update batch
+  public: std::vector<std::vector<double>> batchInputs;
+};
+}
+}
+
+using namespace ignition;
+using namespace gui;
+
+//////////////////////////////////////////////////
+void SeriesExpressionPrivate::SkipSpaces()
+{
+  while (this->pos < this->text.size() &&
+         std::isspace(static_cast<unsigned char>(this->text[this->pos])))
+  {
+    this->pos++;
+  }
+}
+
+//////////////////////////////////////////////////
+bool SeriesExpressionPrivate::Accept(char _c)
+{
+  this->SkipSpaces();
+  if (this->pos < this->text.size() && this->text[this->pos] == _c)
+  {
+    this->pos++;
+    return true;
+  }
+  return false;
+}
+
+//////////////////////////////////////////////////
+bool SeriesExpressionPrivate::Fail(const std::string &_message)
+{
+  if (this->error.empty())
+  {
+    this->error = _message + " at position " + std::to_string(this->pos);
+  }
+  return false;
+}
+
+//////////////////////////////////////////////////
+void SeriesExpressionPrivate::Emit(Instruction::Op _op, std::size_t _arg,
+                                   int _depth)
+{
+  this->program.push_back({_op, _arg});
+  this->depth += _depth;
+  this->maxDepth = std::max(this->maxDepth, this->depth);
+}
+
+//////////////////////////////////////////////////
+bool SeriesExpressionPrivate::ParseSum()
+{
+  if (!this->ParseProduct())
+    return false;
+
+  while (true)
+  {
+    Instruction::Op op;
+    if (this->Accept('+'))
+      op = Instruction::ADD;
+    else if (this->Accept('-'))
+      op = Instruction::SUB;
+    else
+      return true;
+
+    if (!this->ParseProduct())
+      return false;
+    this->Emit(op, 0, -1);
+  }
+}
+
+//////////////////////////////////////////////////
+bool SeriesExpressionPrivate::ParseProduct()
+{
+  if (!this->ParseUnary())
+    return false;
+
+  while (true)
+  {
+    Instruction::Op op;
+    if (this->Accept('*'))
+      op = Instruction::MUL;
+    else if (this->Accept('/'))
+      op = Instruction::DIV;
+    else
+      return true;
+
+    if (!this->ParseUnary())
+      return false;
+    this->Emit(op, 0, -1);
+  }
+}
+
+//////////////////////////////////////////////////
+bool SeriesExpressionPrivate::ParseUnary()
+{
+  if (this->Accept('-'))
+  {
+    if (!this->ParseUnary())
+      return false;
+    this->Emit(Instruction::NEG, 0, 0);
+    return true;
+  }
+  this->Accept('+');
+
+  return this->ParsePower();
+}
+
+//////////////////////////////////////////////////
+bool SeriesExpressionPrivate::ParsePower()
+{
+  if (!this->ParsePrimary())
+    return false;
+
+  // right associative, and binds tighter than a minus sign on its left
+  if (this->Accept('^'))
+  {
+    if (!this->ParseUnary())
+      return false;
+    this->Emit(Instruction::POW, 0, -1);
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool SeriesExpressionPrivate::ParsePrimary()
+{
+  if (this->Accept('('))
+  {
+    if (!this->ParseSum())
+      return false;
+    if (!this->Accept(')'))
+      return this->Fail("Expected ')'");
+    return true;
+  }
+
+  // input series
+  if (this->Accept('{'))
+  {
+    auto end = this->text.find('}', this->pos);
+    if (end == std::string::npos)
+      return this->Fail("Expected '}'");
+
+    auto name = this->text.substr(this->pos, end - this->pos);
+    name.erase(0, name.find_first_not_of(" \t"));
+    name.erase(name.find_last_not_of(" \t") + 1);
+    if (name.empty())
+      return this->Fail("Empty series name");
+    this->pos = end + 1;
+
+    auto it = std::find(this->inputs.begin(), this->inputs.end(), name);
+    std::size_t index = it - this->inputs.begin();
+    if (it == this->inputs.end())
+      this->inputs.push_back(name);
+
+    this->Emit(Instruction::INPUT, index, 1);
+    return true;
+  }
+
+  this->SkipSpaces();
+  if (this->pos >= this->text.size())
+    return this->Fail("Unexpected end");
+
+  char c = this->text[this->pos];
+
+  // number, parsed independently of the locale
+  if (std::isdigit(static_cast<unsigned char>(c)) || c == '.')
+  {
+    std::size_t start = this->pos;
+    auto digits = [this]()
+    {
+      while (this->pos < this->text.size() &&
+             std::isdigit(static_cast<unsigned char>(this->text[this->pos])))
+      {
+        this->pos++;
+      }
+    };
+    digits();
+    if (this->pos < this->text.size() && this->text[this->pos] == '.')
+    {
+      this->pos++;
+      digits();
+    }
+    if (this->pos < this->text.size() &&
+        (this->text[this->pos] == 'e' || this->text[this->pos] == 'E'))
+    {
+      this->pos++;
+      if (this->pos < this->text.size() &&
+          (this->text[this->pos] == '+' || this->text[this->pos] == '-'))
+      {
+        this->pos++;
+      }
+      digits();
+    }
+
+    std::istringstream stream(this->text.substr(start, this->pos - start));
+    stream.imbue(std::locale::classic());
+    double value;
+    stream >> value;
+    if (stream.fail() || !stream.eof())
+    {
+      this->pos = start;
+      return this->Fail("Invalid number");
+    }
+
+    this->constants.push_back(value);
+    this->Emit(Instruction::CONSTANT, this->constants.size() - 1, 1);
+    return true;
+  }
+
+  if (!std::isalpha(static_cast<unsigned char>(c)) && c != '_')
+    return this->Fail(std::string("Unexpected '") + c + "'");
+
+  // constant, time or function
+  std::size_t start = this->pos;
+  while (this->pos < this->text.size() &&
+         (std::isalnum(static_cast<unsigned char>(this->text[this->pos])) ||
+          this->text[this->pos] == '_'))
+  {
+    this->pos++;
+  }
+  auto name = this->text.substr(start, this->pos - start);
+
+  if (!this->Accept('('))
+  {
+    if (name == "t")
+    {
+      this->Emit(Instruction::TIME, 0, 1);
+      return true;
+    }
+
+    double value;
+    if (name == "pi")
+      value = 3.14159265358979323846;
+    else if (name == "e")
+      value = 2.71828182845904523536;
+    else
+    {
+      this->pos = start;
+      return this->Fail("Unknown name '" + name + "'");
+    }
+
+    this->constants.push_back(value);
+    this->Emit(Instruction::CONSTANT, this->constants.size() - 1, 1);
+    return true;
+  }
+
+  if (!this->ParseSum())
+    return false;
+
+  // functions of two arguments
+  if (this->Accept(','))
+  {
+    if (!this->ParseSum())
+      return false;
+    if (!this->Accept(')'))
+      return this->Fail("Expected ')'");
+
+    for (std::size_t i = 0; i < std::size(kFunctions2); ++i)
+    {
+      if (name == kFunctions2[i].first)
+      {
+        this->Emit(Instruction::FUNCTION2, i, -1);
+        return true;
+      }
+    }
+    this->pos = start;
+    return this->Fail("Unknown function '" + name + "' of 2 arguments");
+  }
+
+  if (!this->Accept(')'))
+    return this->Fail("Expected ')'");
+
+  if (name == "deriv" || name == "integral")
+  {
+    this->states.emplace_back();
+    this->Emit(name == "deriv" ? Instruction::DERIV : Instruction::INTEGRAL,
+               this->states.size() - 1, 0);
+    return true;
+  }
+
+  for (std::size_t i = 0; i < std::size(kFunctions1); ++i)
+  {
+    if (name == kFunctions1[i].first)
+    {
+      this->Emit(Instruction::FUNCTION1, i, 0);
+      return true;
+    }
+  }
+  this->pos = start;
+  return this->Fail("Unknown function '" + name + "' of 1 argument");
+}
+
+//////////////////////////////////////////////////
+SeriesExpression::SeriesExpression()
+  : dataPtr(std::make_unique<SeriesExpressionPrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+SeriesExpression::~SeriesExpression()
+{
+}
+
+//////////////////////////////////////////////////
+bool SeriesExpression::Compile(const std::string &_expression)
+{
+  auto d = this->dataPtr.get();
+  d->text = _expression;
+  d->pos = 0;
+  d->valid = false;
+  d->error.clear();
+  d->inputs.clear();
+  d->program.clear();
+  d->constants.clear();
+  d->states.clear();
+  d->depth = 0;
+  d->maxDepth = 0;
+  this->Reset();
+
+  if (!d->ParseSum())
+    return false;
+
+  // trailing characters
+  d->SkipSpaces();
+  if (d->pos < d->text.size())
+    return d->Fail(std::string("Unexpected '") + d->text[d->pos] + "'");
+
+  if (d->inputs.empty())
+  {
+    d->error = "The expression doesn't reference any series";
+    return false;
+  }
+
+  d->stack.resize(d->maxDepth);
+  d->batchInputs.resize(d->inputs.size());
+  d->valid = true;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool SeriesExpression::Valid() const
+{
+  return this->dataPtr->valid;
+}
+
+//////////////////////////////////////////////////
+const std::string &SeriesExpression::Error() const
+{
+  return this->dataPtr->error;
+}
+
+//////////////////////////////////////////////////
+const std::vector<std::string> &SeriesExpression::Inputs() const
+{
+  return this->dataPtr->inputs;
+}
+
+//////////////////////////////////////////////////
+void SeriesExpression::SetAlignment(SeriesAlignment _alignment)
+{
+  this->dataPtr->alignment = _alignment;
+}
+
+//////////////////////////////////////////////////
+SeriesAlignment SeriesExpression::Alignment() const
+{
+  return this->dataPtr->alignment;
+}
+
+//////////////////////////////////////////////////
+void SeriesExpression::Evaluate(const double *_times,
+                                const std::vector<const double *> &_inputs,
+                                std::size_t _count, double *_values)
+{
+  auto d = this->dataPtr.get();
+  if (!d->valid || _count == 0 || _inputs.size() < d->inputs.size())
+    return;
+
+  for (auto &column : d->stack)
+    column.resize(_count);
+
+  // each instruction runs over the whole batch
+  std::size_t top = 0;
+  for (auto const &instruction : d->program)
+  {
+    switch (instruction.op)
+    {
+      case Instruction::CONSTANT:
+        std::fill_n(d->stack[top++].begin(), _count,
+                    d->constants[instruction.arg]);
+        break;
+      case Instruction::INPUT:
+        std::copy_n(_inputs[instruction.arg], _count,
+                    d->stack[top++].begin());
+        break;
+      case Instruction::TIME:
+        std::copy_n(_times, _count, d->stack[top++].begin());
+        break;
+      case Instruction::NEG:
+      {
+        auto &a = d->stack[top - 1];
+        for (std::size_t i = 0; i < _count; ++i)
+          a[i] = -a[i];
+        break;
+      }
+      case Instruction::FUNCTION1:
+      {
+        auto &a = d->stack[top - 1];
+        auto function = kFunctions1[instruction.arg].second;
+        for (std::size_t i = 0; i < _count; ++i)
+          a[i] = function(a[i]);
+        break;
+      }
+      case Instruction::DERIV:
+      {
+        auto &a = d->stack[top - 1];
+        auto &state = d->states[instruction.arg];
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          double value = a[i];
+          if (!std::isfinite(value))
+          {
+            a[i] = std::numeric_limits<double>::quiet_NaN();
+            continue;
+          }
+
+          // no derivative until two samples, keep the last one if the
+          // time doesn't advance
+          if (!state.started)
+            state.output = std::numeric_limits<double>::quiet_NaN();
+          else if (_times[i] > state.time)
+            state.output = (value - state.value) / (_times[i] - state.time);
+
+          state.started = true;
+          state.time = _times[i];
+          state.value = value;
+          a[i] = state.output;
+        }
+        break;
+      }
+      case Instruction::INTEGRAL:
+      {
+        auto &a = d->stack[top - 1];
+        auto &state = d->states[instruction.arg];
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          double value = a[i];
+          if (std::isfinite(value))
+          {
+            if (state.started)
+            {
+              state.output +=
+                  (value + state.value) * 0.5 * (_times[i] - state.time);
+            }
+            state.started = true;
+            state.time = _times[i];
+            state.value = value;
+          }
+          a[i] = state.output;
+        }
+        break;
+      }
+      default:
+      {
+        // binary operations
+        auto &a = d->stack[top - 2];
+        auto &b = d->stack[top - 1];
+        switch (instruction.op)
+        {
+          case Instruction::ADD:
+            for (std::size_t i = 0; i < _count; ++i)
+              a[i] += b[i];
+            break;
+          case Instruction::SUB:
+            for (std::size_t i = 0; i < _count; ++i)
+              a[i] -= b[i];
+            break;
+          case Instruction::MUL:
+            for (std::size_t i = 0; i < _count; ++i)
+              a[i] *= b[i];
+            break;
+          case Instruction::DIV:
+            for (std::size_t i = 0; i < _count; ++i)
+              a[i] /= b[i];
+            break;
+          case Instruction::POW:
+            for (std::size_t i = 0; i < _count; ++i)
+              a[i] = std::pow(a[i], b[i]);
+            break;
+          default:
+          {
+            auto function = kFunctions2[instruction.arg].second;
+            for (std::size_t i = 0; i < _count; ++i)
+              a[i] = function(a[i], b[i]);
+            break;
+          }
+        }
+        top--;
+        break;
+      }
+    }
+  }
+
+  std::copy_n(d->stack[0].begin(), _count, _values);
+}
+
+//////////////////////////////////////////////////
+std::size_t SeriesExpression::Update(
+    const std::vector<const TimeSeries *> &_inputs,
+    std::vector<double> &_times, std::vector<double> &_values)
+{
+  _times.clear();
+  _values.clear();
+
+  auto d = this->dataPtr.get();
+  if (!d->valid || _inputs.size() != d->inputs.size() || !_inputs[0])
+    return 0;
+
+  // the first input has been cleared
+  auto const &first = *_inputs[0];
+  if (first.TotalCount() < d->processed)
+    this->Reset();
+
+  // skip the samples overwritten before being processed
+  std::uint64_t firstIndex = first.TotalCount() - first.Size();
+  std::size_t start = d->processed > firstIndex ?
+      static_cast<std::size_t>(d->processed - firstIndex) : 0;
+
+  d->batchTimes.clear();
+  for (auto &column : d->batchInputs)
+    column.clear();
+
+  std::size_t index = start;
+  for (; index < first.Size(); ++index)
+  {
+    double time = first.Time(index);
+
+    auto result = AlignResult::READY;
+    for (std::size_t i = 1; i < _inputs.size(); ++i)
+    {
+      double value = 0;
+      result = _inputs[i] ?
+          AlignedValue(*_inputs[i], time, d->alignment, value) :
+          AlignResult::WAIT;
+      if (result != AlignResult::READY)
+        break;
+      d->batchInputs[i].push_back(value);
+    }
+
+    if (result == AlignResult::WAIT)
+    {
+      // drop the partially aligned inputs of this sample
+      for (std::size_t i = 1; i < _inputs.size(); ++i)
+        d->batchInputs[i].resize(d->batchTimes.size());
+      break;
+    }
+    if (result == AlignResult::SKIP)
+    {
+      for (std::size_t i = 1; i < _inputs.size(); ++i)
+        d->batchInputs[i].resize(d->batchTimes.size());
+      continue;
+    }
+
+    d->batchTimes.push_back(time);
+    d->batchInputs[0].push_back(first.Value(index));
+  }
+  d->processed = firstIndex + index;
+
+  std::size_t count = d->batchTimes.size();
+  if (count == 0)
+    return 0;
+
+  std::vector<const double *> columns;
+  columns.reserve(d->batchInputs.size());
+  for (auto const &column : d->batchInputs)
+    columns.push_back(column.data());
+
+  _times = d->batchTimes;
+  _values.resize(count);
+  this->Evaluate(d->batchTimes.data(), columns, count, _values.data());
+  return count;
+}
+
+//////////////////////////////////////////////////
+void SeriesExpression::Reset()
+{
+  this->dataPtr->processed = 0;
+  for (auto &state : this->dataPtr->states)
+    state = OpState();
+}
@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "ignition/gui/SeriesExpression.hh"
+#include "ignition/gui/TimeSeries.hh"
+
+using namespace ignition;
+using namespace gui;
+
+/////////////////////////////////////////////////
+/// \brief Evaluate an expression of a single input on a few samples
+/// \param[in] _expression Expression text
+/// \param[in] _x Input values, at times 0, 1, 2...
+/// \return Output values
+std::vector<double> Eval(const std::string &_expression,
+                         const std::vector<double> &_x)
+{
+  SeriesExpression expression;
+  EXPECT_TRUE(expression.Compile(_expression)) << expression.Error();
+
+  std::vector<double> times;
+  for (std::size_t i = 0; i < _x.size(); ++i)
+    times.push_back(static_cast<double>(i));
+
+  std::vector<double> values(_x.size());
+  expression.Evaluate(times.data(), {_x.data()}, _x.size(), values.data());
+  return values;
+}
+
+/////////////////////////////////////////////////
+TEST(SeriesExpressionTest, Compile)
+{
+  SeriesExpression expression;
+  EXPECT_FALSE(expression.Valid());
+
+  EXPECT_TRUE(expression.Compile(
+      "sqrt({/odom-twist-linear-x}^2 + { /odom-twist-linear-y }^2)"));
+  EXPECT_TRUE(expression.Valid());
+  EXPECT_TRUE(expression.Error().empty());
+  ASSERT_EQ(expression.Inputs().size(), 2u);
+  EXPECT_EQ(expression.Inputs()[0], "/odom-twist-linear-x");
+  EXPECT_EQ(expression.Inputs()[1], "/odom-twist-linear-y");
+
+  // inputs are referenced once
+  EXPECT_TRUE(expression.Compile("{a} - {b} * {a}"));
+  EXPECT_EQ(expression.Inputs(), std::vector<std::string>({"a", "b"}));
+
+  for (auto const &invalid : {"", "{a} +", "({a}", "{a", "{}", "{a} 2",
+                              "foo({a})", "atan2({a})", "sqrt({a}, 1)",
+                              "x + {a}", "1.2.3 + {a}", "{a} $", "2 * pi"})
+  {
+    EXPECT_FALSE(expression.Compile(invalid)) << invalid;
+    EXPECT_FALSE(expression.Valid()) << invalid;
+    EXPECT_FALSE(expression.Error().empty()) << invalid;
+  }
+  EXPECT_NE(expression.Error().find("any series"), std::string::npos);
+
+  EXPECT_FALSE(expression.Compile("{a} + bar"));
+  EXPECT_EQ(expression.Error(), "Unknown name 'bar' at position 6");
+}
+
+/////////////////////////////////////////////////
+TEST(SeriesExpressionTest, Evaluate)
+{
+  EXPECT_EQ(Eval("1 + 2 * {x}", {1, 2}), std::vector<double>({3, 5}));
+  EXPECT_EQ(Eval("(1 + 2) * {x}", {1, 2}), std::vector<double>({3, 6}));
+  EXPECT_EQ(Eval("{x} - 1 - 2", {1}), std::vector<double>({-2}));
+  EXPECT_EQ(Eval("{x} / 2 / 2", {8}), std::vector<double>({2}));
+  EXPECT_EQ(Eval("-{x}^2", {3}), std::vector<double>({-9}));
+  EXPECT_EQ(Eval("2^{x}^2", {3}), std::vector<double>({512}));
+  EXPECT_EQ(Eval("2^-{x}", {1}), std::vector<double>({0.5}));
+  EXPECT_EQ(Eval("1.5e1 + .5 + {x}", {0}), std::vector<double>({15.5}));
+  EXPECT_EQ(Eval("{x} * t", {2, 2, 2}), std::vector<double>({0, 2, 4}));
+  EXPECT_EQ(Eval("abs({x}) + max({x}, 1) + hypot(3, 4)", {-2}),
+            std::vector<double>({2 + 1 + 5}));
+  EXPECT_DOUBLE_EQ(Eval("sin({x} * pi / 2)", {1})[0], 1.0);
+  EXPECT_DOUBLE_EQ(Eval("atan2({x}, -1)", {0})[0], std::acos(-1.0));
+  EXPECT_DOUBLE_EQ(Eval("log(e) * {x}", {3})[0], 3.0);
+  EXPECT_TRUE(std::isinf(Eval("1 / {x}", {0})[0]));
+
+  // derivative and integral over time
+  auto deriv = Eval("deriv({x}^2)", {0, 1, 4, 4});
+  EXPECT_TRUE(std::isnan(deriv[0]));
+  EXPECT_EQ(std::vector<double>(deriv.begin() + 1, deriv.end()),
+            std::vector<double>({1, 15, 0}));
+  EXPECT_EQ(Eval("integral({x})", {0, 2, 2, 4}),
+            std::vector<double>({0, 1, 3, 6}));
+
+  // the state is carried over between batches
+  SeriesExpression expression;
+  ASSERT_TRUE(expression.Compile("deriv({x}) + integral({x})"));
+  std::vector<double> times = {0, 1, 2, 3};
+  std::vector<double> x = {0, 1, 2, 3};
+  std::vector<double> values(4);
+  expression.Evaluate(times.data(), {x.data()}, 2, values.data());
+  expression.Evaluate(times.data() + 2, {x.data() + 2}, 2,
+                      values.data() + 2);
+  EXPECT_DOUBLE_EQ(values[1], 1 + 0.5);
+  EXPECT_DOUBLE_EQ(values[2], 1 + 2);
+  EXPECT_DOUBLE_EQ(values[3], 1 + 4.5);
+}
+
+/////////////////////////////////////////////////
+TEST(SeriesExpressionTest, Update)
+{
+  SeriesExpression expression;
+  ASSERT_TRUE(expression.Compile("{a} - {b}"));
+  EXPECT_EQ(expression.Alignment(), SeriesAlignment::INTERPOLATE);
+
+  TimeSeries a(8);
+  TimeSeries b(8);
+  std::vector<double> times;
+  std::vector<double> values;
+
+  // no second input yet
+  a.Append(1, 10);
+  a.Append(2, 20);
+  EXPECT_EQ(expression.Update({&a, nullptr}, times, values), 0u);
+
+  // the first sample of a is before b, it is skipped. The second one waits
+  // for a sample of b after it.
+  b.Append(1.5, 1);
+  EXPECT_EQ(expression.Update({&a, &b}, times, values), 0u);
+
+  b.Append(2.5, 2);
+  ASSERT_EQ(expression.Update({&a, &b}, times, values), 1u);
+  EXPECT_DOUBLE_EQ(times[0], 2);
+  EXPECT_DOUBLE_EQ(values[0], 20 - 1.5);
+
+  // only the new samples are evaluated, exact times aren't interpolated
+  a.Append(2.5, 30);
+  a.Append(3, 40);
+  ASSERT_EQ(expression.Update({&a, &b}, times, values), 1u);
+  EXPECT_DOUBLE_EQ(times[0], 2.5);
+  EXPECT_DOUBLE_EQ(values[0], 28);
+
+  // hold the last sample of the other inputs instead of waiting
+  expression.SetAlignment(SeriesAlignment::HOLD);
+  ASSERT_EQ(expression.Update({&a, &b}, times, values), 1u);
+  EXPECT_DOUBLE_EQ(times[0], 3);
+  EXPECT_DOUBLE_EQ(values[0], 38);
+  EXPECT_EQ(expression.Update({&a, &b}, times, values), 0u);
+
+  // samples overwritten before being evaluated are skipped
+  for (int i = 4; i < 20; ++i)
+    a.Append(i, i);
+  ASSERT_EQ(expression.Update({&a, &b}, times, values), 8u);
+  EXPECT_DOUBLE_EQ(times[0], 12);
+  EXPECT_DOUBLE_EQ(values[7], 19 - 2);
+
+  // restart from the oldest stored samples, and after clearing the input
+  expression.Reset();
+  EXPECT_EQ(expression.Update({&a, &b}, times, values), 8u);
+  a.Clear();
+  a.Append(30, 1);
+  ASSERT_EQ(expression.Update({&a, &b}, times, values), 1u);
+  EXPECT_DOUBLE_EQ(values[0], -1);
+
+  // wrong number of inputs
+  EXPECT_EQ(expression.Update({&a}, times, values), 0u);
+}
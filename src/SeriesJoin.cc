@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "ignition/gui/SeriesJoin.hh"
+#include "ignition/gui/TimeSeries.hh"
+
+namespace ignition
+{
+namespace gui
+{
+class SeriesJoinPrivate
+{
+  /// \brief Max time difference of paired samples
+  public: double tolerance = 0;
+
+  /// \brief Number of samples of the x series consumed so far, counted
+  /// like TimeSeries::TotalCount
+  public: std::uint64_t processedX = 0;
+
+  /// \brief Number of samples of the y series consumed so far
+  public: std::uint64_t processedY = 0;
+};
+}
+}
+
+using namespace ignition;
+using namespace gui;
+
+namespace
+{
+/// \brief Index of the first stored sample not consumed yet
+/// \param[in] _series Series
+/// \param[in] _processed Number of consumed samples
+/// \return Sample index, skipping the samples overwritten before being
+/// consumed
+std::size_t FirstUnprocessed(const TimeSeries &_series,
+                             std::uint64_t _processed)
+{
+  std::uint64_t first = _series.TotalCount() - _series.Size();
+  return _processed > first ?
+      static_cast<std::size_t>(_processed - first) : 0;
+}
+}
+
+//////////////////////////////////////////////////
+SeriesJoin::SeriesJoin(double _tolerance)
+  : dataPtr(std::make_unique<SeriesJoinPrivate>())
+{
+  this->SetTolerance(_tolerance);
+}
+
+//////////////////////////////////////////////////
+SeriesJoin::~SeriesJoin()
+{
+}
+
+//////////////////////////////////////////////////
+void SeriesJoin::SetTolerance(double _tolerance)
+{
+  this->dataPtr->tolerance = std::max(0.0, _tolerance);
+}
+
+//////////////////////////////////////////////////
+double SeriesJoin::Tolerance() const
+{
+  return this->dataPtr->tolerance;
+}
+
+//////////////////////////////////////////////////
+std::size_t SeriesJoin::Update(const TimeSeries &_x, const TimeSeries &_y,
+                               std::vector<double> &_times,
+                               std::vector<double> &_xs,
+                               std::vector<double> &_ys)
+{
+  _times.clear();
+  _xs.clear();
+  _ys.clear();
+
+  auto d = this->dataPtr.get();
+
+  // a series has been cleared
+  if (_x.TotalCount() < d->processedX || _y.TotalCount() < d->processedY)
+    this->Reset();
+
+  std::size_t i = FirstUnprocessed(_x, d->processedX);
+  std::size_t j = FirstUnprocessed(_y, d->processedY);
+  while (i < _x.Size() && j < _y.Size())
+  {
+    double tx = _x.Time(i);
+    double ty = _y.Time(j);
+
+    if (tx < ty - d->tolerance)
+    {
+      i++;
+      continue;
+    }
+    if (ty < tx - d->tolerance)
+    {
+      j++;
+      continue;
+    }
+
+    // the next sample of the earlier series may be a closer match, wait
+    // for it if it hasn't been received yet
+    if (tx < ty)
+    {
+      if (i + 1 >= _x.Size())
+        break;
+      if (std::abs(_x.Time(i + 1) - ty) < ty - tx)
+      {
+        i++;
+        continue;
+      }
+    }
+    else if (ty < tx)
+    {
+      if (j + 1 >= _y.Size())
+        break;
+      if (std::abs(_y.Time(j + 1) - tx) < tx - ty)
+      {
+        j++;
+        continue;
+      }
+    }
+
+    _times.push_back(std::max(tx, ty));
+    _xs.push_back(_x.Value(i));
+    _ys.push_back(_y.Value(j));
+    i++;
+    j++;
+  }
+
+  d->processedX = _x.TotalCount() - _x.Size() + i;
+  d->processedY = _y.TotalCount() - _y.Size() + j;
+  return _times.size();
+}
+
+//////////////////////////////////////////////////
+void SeriesJoin::Reset()
+{
+  this->dataPtr->processedX = 0;
+  this->dataPtr->processedY = 0;
+}
+
+//////////////////////////////////////////////////
+void ignition::gui::DecimateXY(const double *_xs, const double *_ys,
+                               std::size_t _count, double _minX, double _maxX,
+                               double _minY, double _maxY,
+                               unsigned int _width, unsigned int _height,
+                               std::vector<std::size_t> &_indices)
+{
+  _indices.clear();
+  if (_count == 0)
+    return;
+
+  // without a valid view, keep all the points
+  if (_width == 0 || _height == 0 || !(_maxX > _minX) || !(_maxY > _minY))
+  {
+    _indices.resize(_count);
+    for (std::size_t i = 0; i < _count; ++i)
+      _indices[i] = i;
+    return;
+  }
+
+  double scaleX = _width / (_maxX - _minX);
+  double scaleY = _height / (_maxY - _minY);
+  auto cell = [](double _value, double _min, double _scale, unsigned int _size)
+  {
+    double pixel = std::floor((_value - _min) * _scale);
+    // NaN and out of view coordinates go to the cells around the view
+    if (!(pixel >= 0))
+      return static_cast<std::int64_t>(-1);
+    return static_cast<std::int64_t>(
+        std::min(pixel, static_cast<double>(_size)));
+  };
+
+  std::int64_t lastX = 0;
+  std::int64_t lastY = 0;
+  bool pending = false;
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    std::int64_t cellX = cell(_xs[i], _minX, scaleX, _width);
+    std::int64_t cellY = cell(_ys[i], _minY, scaleY, _height);
+    if (!_indices.empty() && cellX == lastX && cellY == lastY)
+    {
+      pending = true;
+      continue;
+    }
+
+    // last point of the previous run
+    if (pending)
+    {
+      _indices.push_back(i - 1);
+      pending = false;
+    }
+
+    _indices.push_back(i);
+    lastX = cellX;
+    lastY = cellY;
+  }
+
+  if (pending)
+    _indices.push_back(_count - 1);
+}
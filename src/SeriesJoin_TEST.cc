@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "ignition/gui/SeriesJoin.hh"
+#include "ignition/gui/TimeSeries.hh"
+
+using namespace ignition;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(SeriesJoinTest, Join)
+{
+  SeriesJoin join(0.01);
+  EXPECT_DOUBLE_EQ(join.Tolerance(), 0.01);
+
+  TimeSeries x(100);
+  TimeSeries y(100);
+  std::vector<double> times;
+  std::vector<double> xs;
+  std::vector<double> ys;
+  EXPECT_EQ(join.Update(x, y, times, xs, ys), 0u);
+
+  // same times
+  for (int i = 0; i < 3; ++i)
+  {
+    x.Append(i, i);
+    y.Append(i, 10 * i);
+  }
+  ASSERT_EQ(join.Update(x, y, times, xs, ys), 3u);
+  EXPECT_EQ(times, std::vector<double>({0, 1, 2}));
+  EXPECT_EQ(xs, std::vector<double>({0, 1, 2}));
+  EXPECT_EQ(ys, std::vector<double>({0, 10, 20}));
+
+  // nothing new
+  EXPECT_EQ(join.Update(x, y, times, xs, ys), 0u);
+
+  // y slightly late, and a y sample without a match
+  x.Append(3.0, 3);
+  y.Append(3.005, 30);
+  y.Append(3.5, 35);
+  x.Append(4.0, 4);
+  y.Append(4.0, 40);
+  ASSERT_EQ(join.Update(x, y, times, xs, ys), 2u);
+  EXPECT_DOUBLE_EQ(times[0], 3.005);
+  EXPECT_DOUBLE_EQ(xs[0], 3);
+  EXPECT_DOUBLE_EQ(ys[0], 30);
+  EXPECT_DOUBLE_EQ(xs[1], 4);
+  EXPECT_DOUBLE_EQ(ys[1], 40);
+
+  // the last x sample waits for a possibly closer y sample
+  x.Append(5.0, 5);
+  y.Append(4.995, 49);
+  EXPECT_EQ(join.Update(x, y, times, xs, ys), 0u);
+  y.Append(4.999, 50);
+  EXPECT_EQ(join.Update(x, y, times, xs, ys), 0u);
+  y.Append(5.1, 51);
+  ASSERT_EQ(join.Update(x, y, times, xs, ys), 1u);
+  EXPECT_DOUBLE_EQ(ys[0], 50);
+
+  // restart after clearing
+  x.Clear();
+  y.Clear();
+  x.Append(0, 1);
+  y.Append(0, 2);
+  ASSERT_EQ(join.Update(x, y, times, xs, ys), 1u);
+  EXPECT_DOUBLE_EQ(xs[0], 1);
+  EXPECT_DOUBLE_EQ(ys[0], 2);
+
+  // samples overwritten before being joined are skipped
+  TimeSeries small(4);
+  TimeSeries other(100);
+  SeriesJoin join2;
+  for (int i = 0; i < 10; ++i)
+  {
+    small.Append(i, i);
+    other.Append(i, i);
+  }
+  ASSERT_EQ(join2.Update(small, other, times, xs, ys), 4u);
+  EXPECT_DOUBLE_EQ(times[0], 6);
+}
+
+/////////////////////////////////////////////////
+TEST(SeriesJoinTest, DecimateXY)
+{
+  std::vector<std::size_t> indices;
+  DecimateXY(nullptr, nullptr, 0, 0, 1, 0, 1, 10, 10, indices);
+  EXPECT_TRUE(indices.empty());
+
+  // a circle drawn many times on a 10x10 view
+  std::vector<double> xs;
+  std::vector<double> ys;
+  for (int i = 0; i < 100000; ++i)
+  {
+    double angle = i * 0.001;
+    xs.push_back(std::cos(angle));
+    ys.push_back(std::sin(angle));
+  }
+  DecimateXY(xs.data(), ys.data(), xs.size(), -1, 1, -1, 1, 10, 10, indices);
+  EXPECT_LT(indices.size(), 10000u);
+  ASSERT_FALSE(indices.empty());
+  EXPECT_EQ(indices.front(), 0u);
+  EXPECT_EQ(indices.back(), xs.size() - 1);
+  for (std::size_t i = 1; i < indices.size(); ++i)
+    EXPECT_LT(indices[i - 1], indices[i]);
+
+  // the points out of view collapse to the first and last ones of each run
+  xs = {0.5, 5, 6, 7, 8, 0.5};
+  ys = {0.5, 0.5, 0.5, 0.5, 0.5, 0.5};
+  DecimateXY(xs.data(), ys.data(), xs.size(), 0, 1, 0, 1, 10, 10, indices);
+  EXPECT_EQ(indices, std::vector<std::size_t>({0, 1, 4, 5}));
+
+  // invalid view, all the points are kept
+  DecimateXY(xs.data(), ys.data(), xs.size(), 0, 0, 0, 1, 10, 10, indices);
+  EXPECT_EQ(indices.size(), xs.size());
+}
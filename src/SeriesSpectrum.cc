@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+#include "ignition/gui/SeriesSpectrum.hh"
+
+namespace ignition
+{
+namespace gui
+{
+class SeriesSpectrumPrivate
+{
+  /// \brief Compute the window and the FFT tables of a segment size, if
+  /// they aren't cached already
+  /// \param[in] _size Segment size, a power of two
+  public: void Prepare(std::size_t _size)
+  {
+    if (_size == this->preparedSize && this->window == this->preparedWindow)
+      return;
+
+    const double twoPi = 2.0 * std::acos(-1.0);
+
+    // periodic window, as usual for spectral analysis
+    this->windowValues.resize(_size);
+    this->windowPower = 0;
+    for (std::size_t i = 0; i < _size; ++i)
+    {
+      double w = 1.0;
+      if (this->window == SpectrumWindow::HANN)
+        w = 0.5 - 0.5 * std::cos(twoPi * i / _size);
+      this->windowValues[i] = w;
+      this->windowPower += w * w;
+    }
+
+    this->twiddles.resize(_size / 2);
+    for (std::size_t k = 0; k < _size / 2; ++k)
+      this->twiddles[k] = std::polar(1.0, -twoPi * k / _size);
+
+    unsigned int bits = 0;
+    while ((std::size_t(1) << bits) < _size)
+      bits++;
+    this->bitReverse.resize(_size);
+    for (std::size_t i = 0; i < _size; ++i)
+    {
+      std::size_t reversed = 0;
+      for (unsigned int b = 0; b < bits; ++b)
+        reversed |= ((i >> b) & 1) << (bits - 1 - b);
+      this->bitReverse[i] = reversed;
+    }
+
+    this->buffer.resize(_size);
+    this->preparedSize = _size;
+    this->preparedWindow = this->window;
+  }
+
+  /// \brief Transform the buffer in place, which holds the input in bit
+  /// reversed order
+  public: void Transform()
+  {
+    std::size_t size = this->buffer.size();
+    auto data = this->buffer.data();
+    for (std::size_t length = 2; length <= size; length <<= 1)
+    {
+      std::size_t half = length / 2;
+      std::size_t stride = size / length;
+      for (std::size_t i = 0; i < size; i += length)
+      {
+        for (std::size_t k = 0; k < half; ++k)
+        {
+          auto t = this->twiddles[k * stride] * data[i + k + half];
+          auto u = data[i + k];
+          data[i + k] = u + t;
+          data[i + k + half] = u - t;
+        }
+      }
+    }
+  }
+
+  /// \brief Number of values per segment
+  public: std::size_t segmentSize = 1024;
+
+  /// \brief Window function
+  public: SpectrumWindow window = SpectrumWindow::HANN;
+
+  /// \brief Segment size of the cached tables, 0 if none
+  public: std::size_t preparedSize = 0;
+
+  /// \brief Window function of the cached window values
+  public: SpectrumWindow preparedWindow = SpectrumWindow::HANN;
+
+  /// \brief Window value of each index of a segment
+  public: std::vector<double> windowValues;
+
+  /// \brief Sum of the squared window values
+  public: double windowPower = 0;
+
+  /// \brief FFT twiddle factors
+  public: std::vector<std::complex<double>> twiddles;
+
+  /// \brief Bit reversed index of each index of a segment
+  public: std::vector<std::size_t> bitReverse;
+
+  /// \brief Segment being transformed
+  public: std::vector<std::complex<double>> buffer;
+};
+}
+}
+
+using namespace ignition;
+using namespace gui;
+
+//////////////////////////////////////////////////
+SeriesSpectrum::SeriesSpectrum(std::size_t _segmentSize)
+  : dataPtr(std::make_unique<SeriesSpectrumPrivate>())
+{
+  this->SetSegmentSize(_segmentSize);
+}
+
+//////////////////////////////////////////////////
+SeriesSpectrum::~SeriesSpectrum()
+{
+}
+
+//////////////////////////////////////////////////
+void SeriesSpectrum::SetSegmentSize(std::size_t _segmentSize)
+{
+  std::size_t size = 8;
+  while (size < _segmentSize)
+    size <<= 1;
+  this->dataPtr->segmentSize = size;
+}
+
+//////////////////////////////////////////////////
+std::size_t SeriesSpectrum::SegmentSize() const
+{
+  return this->dataPtr->segmentSize;
+}
+
+//////////////////////////////////////////////////
+void SeriesSpectrum::SetWindow(SpectrumWindow _window)
+{
+  this->dataPtr->window = _window;
+}
+
+//////////////////////////////////////////////////
+SpectrumWindow SeriesSpectrum::Window() const
+{
+  return this->dataPtr->window;
+}
+
+//////////////////////////////////////////////////
+std::size_t SeriesSpectrum::Compute(const double *_values,
+                                    std::size_t _count, double _sampleRate,
+                                    std::vector<double> &_frequencies,
+                                    std::vector<double> &_power)
+{
+  _frequencies.clear();
+  _power.clear();
+  if (_count < 8 || !(_sampleRate > 0))
+    return 0;
+
+  auto d = this->dataPtr.get();
+  std::size_t size = d->segmentSize;
+  while (size > _count)
+    size >>= 1;
+  d->Prepare(size);
+
+  std::size_t bins = size / 2 + 1;
+  _power.assign(bins, 0.0);
+
+  // the segments are aligned to the end, so the most recent values are
+  // always included
+  std::size_t step = size / 2;
+  std::size_t segments = 0;
+  for (std::size_t start = (_count - size) % step; start + size <= _count;
+       start += step)
+  {
+    auto segment = _values + start;
+    double mean = 0;
+    for (std::size_t i = 0; i < size; ++i)
+      mean += segment[i];
+    mean /= size;
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      d->buffer[d->bitReverse[i]] = std::complex<double>(
+          (segment[i] - mean) * d->windowValues[i], 0.0);
+    }
+    d->Transform();
+
+    for (std::size_t k = 0; k < bins; ++k)
+      _power[k] += std::norm(d->buffer[k]);
+    segments++;
+  }
+
+  // density scaling, with the power of the negative frequencies folded
+  // onto the positive ones
+  double scale = 1.0 / (_sampleRate * d->windowPower * segments);
+  _frequencies.resize(bins);
+  for (std::size_t k = 0; k < bins; ++k)
+  {
+    _power[k] *= (k > 0 && k < size / 2) ? 2 * scale : scale;
+    _frequencies[k] = k * _sampleRate / size;
+  }
+  return bins;
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "ignition/gui/SeriesSpectrum.hh"
+
+using namespace ignition;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(SeriesSpectrumTest, Settings)
+{
+  SeriesSpectrum spectrum;
+  EXPECT_EQ(spectrum.SegmentSize(), 1024u);
+  EXPECT_EQ(spectrum.Window(), SpectrumWindow::HANN);
+
+  spectrum.SetSegmentSize(1000);
+  EXPECT_EQ(spectrum.SegmentSize(), 1024u);
+  spectrum.SetSegmentSize(1);
+  EXPECT_EQ(spectrum.SegmentSize(), 8u);
+
+  spectrum.SetWindow(SpectrumWindow::RECTANGULAR);
+  EXPECT_EQ(spectrum.Window(), SpectrumWindow::RECTANGULAR);
+
+  // not enough values, invalid sample rate
+  std::vector<double> values(100, 1.0);
+  std::vector<double> frequencies;
+  std::vector<double> power;
+  EXPECT_EQ(spectrum.Compute(values.data(), 7, 100, frequencies, power), 0u);
+  EXPECT_EQ(spectrum.Compute(values.data(), 100, 0, frequencies, power), 0u);
+  EXPECT_TRUE(frequencies.empty());
+  EXPECT_TRUE(power.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(SeriesSpectrumTest, Sine)
+{
+  const double pi = std::acos(-1.0);
+  const double rate = 1000;
+  const double amplitude = 2;
+  const double frequency = 125;
+
+  std::vector<double> values;
+  for (int i = 0; i < 20000; ++i)
+    values.push_back(3 + amplitude * std::sin(2 * pi * frequency * i / rate));
+
+  for (auto window : {SpectrumWindow::HANN, SpectrumWindow::RECTANGULAR})
+  {
+    SeriesSpectrum spectrum(256);
+    spectrum.SetWindow(window);
+
+    std::vector<double> frequencies;
+    std::vector<double> power;
+    ASSERT_EQ(spectrum.Compute(values.data(), values.size(), rate,
+                               frequencies, power), 129u);
+    ASSERT_EQ(frequencies.size(), 129u);
+    EXPECT_DOUBLE_EQ(frequencies.front(), 0);
+    EXPECT_DOUBLE_EQ(frequencies.back(), rate / 2);
+
+    // the peak is at the sine frequency, the offset is removed
+    auto peak = std::max_element(power.begin(), power.end()) - power.begin();
+    EXPECT_DOUBLE_EQ(frequencies[peak], frequency);
+    EXPECT_NEAR(power[0], 0, 1e-9);
+
+    // the total power is the variance of the sine
+    double total = 0;
+    for (auto p : power)
+      total += p * rate / 256;
+    EXPECT_NEAR(total, amplitude * amplitude / 2, 1e-6);
+  }
+
+  // fewer values than a segment
+  SeriesSpectrum spectrum(1024);
+  std::vector<double> frequencies;
+  std::vector<double> power;
+  EXPECT_EQ(spectrum.Compute(values.data(), 300, rate, frequencies, power),
+            129u);
+}
@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <utility>
+
+#include "ignition/gui/SeriesStats.hh"
+
+namespace ignition
+{
+namespace gui
+{
+class SeriesStatsPrivate
+{
+  /// \brief Add a value to the mean and variance
+  /// \param[in] _value Value to add
+  public: void Add(double _value)
+  {
+    this->count++;
+    double delta = _value - this->mean;
+    this->mean += delta / this->count;
+    this->m2 += delta * (_value - this->mean);
+  }
+
+  /// \brief Remove a previously added value from the mean and variance
+  /// \param[in] _value Value to remove
+  public: void Remove(double _value)
+  {
+    if (this->count <= 1)
+    {
+      this->count = 0;
+      this->mean = 0;
+      this->m2 = 0;
+      return;
+    }
+
+    double oldMean = this->mean;
+    this->count--;
+    this->mean -= (_value - this->mean) / this->count;
+    // rounding errors can make it slightly negative
+    this->m2 = std::max(0.0,
+        this->m2 - (_value - oldMean) * (_value - this->mean));
+  }
+
+  /// \brief Window duration, zero for the full history
+  public: double window = 0;
+
+  /// \brief Number of samples
+  public: std::uint64_t count = 0;
+
+  /// \brief Mean value
+  public: double mean = 0;
+
+  /// \brief Sum of the squared differences from the mean
+  public: double m2 = 0;
+
+  /// \brief Min value of the full history
+  public: double min = std::numeric_limits<double>::max();
+
+  /// \brief Max value of the full history
+  public: double max = std::numeric_limits<double>::lowest();
+
+  /// \brief Samples in the window, oldest first
+  public: std::deque<std::pair<double, double>> samples;
+
+  /// \brief Window samples which may become the min, with increasing values
+  public: std::deque<std::pair<double, double>> minQueue;
+
+  /// \brief Window samples which may become the max, with decreasing values
+  public: std::deque<std::pair<double, double>> maxQueue;
+};
+}
+}
+
+using namespace ignition;
+using namespace gui;
+
+//////////////////////////////////////////////////
+SeriesStats::SeriesStats(double _window)
+  : dataPtr(std::make_unique<SeriesStatsPrivate>())
+{
+  this->SetWindow(_window);
+}
+
+//////////////////////////////////////////////////
+SeriesStats::~SeriesStats()
+{
+}
+
+//////////////////////////////////////////////////
+void SeriesStats::SetWindow(double _window)
+{
+  this->dataPtr->window = std::max(0.0, _window);
+  this->Reset();
+}
+
+//////////////////////////////////////////////////
+double SeriesStats::Window() const
+{
+  return this->dataPtr->window;
+}
+
+//////////////////////////////////////////////////
+void SeriesStats::Append(double _time, double _value)
+{
+  if (!std::isfinite(_value))
+    return;
+
+  auto d = this->dataPtr.get();
+  d->Add(_value);
+
+  if (d->window <= 0)
+  {
+    d->min = std::min(d->min, _value);
+    d->max = std::max(d->max, _value);
+    return;
+  }
+
+  // the new sample makes the greater (lower) ones never be the min (max)
+  while (!d->minQueue.empty() && d->minQueue.back().second >= _value)
+    d->minQueue.pop_back();
+  d->minQueue.emplace_back(_time, _value);
+
+  while (!d->maxQueue.empty() && d->maxQueue.back().second <= _value)
+    d->maxQueue.pop_back();
+  d->maxQueue.emplace_back(_time, _value);
+
+  d->samples.emplace_back(_time, _value);
+
+  // expire the samples which left the window
+  double start = _time - d->window;
+  while (d->samples.front().first < start)
+  {
+    d->Remove(d->samples.front().second);
+    d->samples.pop_front();
+  }
+  while (d->minQueue.front().first < start)
+    d->minQueue.pop_front();
+  while (d->maxQueue.front().first < start)
+    d->maxQueue.pop_front();
+}
+
+//////////////////////////////////////////////////
+void SeriesStats::Reset()
+{
+  auto d = this->dataPtr.get();
+  d->count = 0;
+  d->mean = 0;
+  d->m2 = 0;
+  d->min = std::numeric_limits<double>::max();
+  d->max = std::numeric_limits<double>::lowest();
+  d->samples.clear();
+  d->minQueue.clear();
+  d->maxQueue.clear();
+}
+
+//////////////////////////////////////////////////
+std::uint64_t SeriesStats::Count() const
+{
+  return this->dataPtr->count;
+}
+
+//////////////////////////////////////////////////
+double SeriesStats::Min() const
+{
+  if (this->dataPtr->count == 0)
+    return std::numeric_limits<double>::quiet_NaN();
+
+  if (this->dataPtr->window > 0)
+    return this->dataPtr->minQueue.front().second;
+
+  return this->dataPtr->min;
+}
+
+//////////////////////////////////////////////////
+double SeriesStats::Max() const
+{
+  if (this->dataPtr->count == 0)
+    return std::numeric_limits<double>::quiet_NaN();
+
+  if (this->dataPtr->window > 0)
+    return this->dataPtr->maxQueue.front().second;
+
+  return this->dataPtr->max;
+}
+
+//////////////////////////////////////////////////
+double SeriesStats::Mean() const
+{
+  if (this->dataPtr->count == 0)
+    return std::numeric_limits<double>::quiet_NaN();
+
+  return this->dataPtr->mean;
+}
+
+//////////////////////////////////////////////////
+double SeriesStats::Variance() const
+{
+  if (this->dataPtr->count == 0)
+    return std::numeric_limits<double>::quiet_NaN();
+
+  return this->dataPtr->m2 / this->dataPtr->count;
+}
+
+//////////////////////////////////////////////////
+double SeriesStats::StdDev() const
+{
+  return std::sqrt(this->Variance());
+}
+
+//////////////////////////////////////////////////
+double SeriesStats::Rms() const
+{
+  // mean of the squares = variance + squared mean
+  double mean = this->Mean();
+  return std::sqrt(this->Variance() + mean * mean);
+}
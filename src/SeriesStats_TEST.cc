@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <utility>
+
+#include "ignition/gui/SeriesStats.hh"
+
+using namespace ignition;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(SeriesStatsTest, FullHistory)
+{
+  SeriesStats stats;
+  EXPECT_DOUBLE_EQ(stats.Window(), 0.0);
+  EXPECT_EQ(stats.Count(), 0u);
+  EXPECT_TRUE(std::isnan(stats.Min()));
+  EXPECT_TRUE(std::isnan(stats.Max()));
+  EXPECT_TRUE(std::isnan(stats.Mean()));
+  EXPECT_TRUE(std::isnan(stats.StdDev()));
+  EXPECT_TRUE(std::isnan(stats.Rms()));
+
+  for (double value : {2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0})
+    stats.Append(0, value);
+
+  EXPECT_EQ(stats.Count(), 8u);
+  EXPECT_DOUBLE_EQ(stats.Min(), 2.0);
+  EXPECT_DOUBLE_EQ(stats.Max(), 9.0);
+  EXPECT_DOUBLE_EQ(stats.Mean(), 5.0);
+  EXPECT_DOUBLE_EQ(stats.Variance(), 4.0);
+  EXPECT_DOUBLE_EQ(stats.StdDev(), 2.0);
+  EXPECT_DOUBLE_EQ(stats.Rms(), std::sqrt(29.0));
+
+  // non-finite values are ignored
+  stats.Append(1, std::nan(""));
+  stats.Append(1, INFINITY);
+  EXPECT_EQ(stats.Count(), 8u);
+  EXPECT_DOUBLE_EQ(stats.Max(), 9.0);
+
+  stats.Reset();
+  EXPECT_EQ(stats.Count(), 0u);
+  EXPECT_TRUE(std::isnan(stats.Mean()));
+  stats.Append(0, -3);
+  EXPECT_DOUBLE_EQ(stats.Min(), -3.0);
+  EXPECT_DOUBLE_EQ(stats.Max(), -3.0);
+  EXPECT_DOUBLE_EQ(stats.Rms(), 3.0);
+}
+
+/////////////////////////////////////////////////
+TEST(SeriesStatsTest, Window)
+{
+  SeriesStats stats(1.0);
+  EXPECT_DOUBLE_EQ(stats.Window(), 1.0);
+
+  // compare with the statistics recomputed over the window samples
+  std::deque<std::pair<double, double>> window;
+  for (int i = 0; i < 1000; ++i)
+  {
+    double time = i * 0.1;
+    double value = std::sin(i * 0.7) * 10 + (i % 13);
+    stats.Append(time, value);
+
+    window.emplace_back(time, value);
+    while (window.front().first < time - 1.0)
+      window.pop_front();
+
+    double min = window.front().second;
+    double max = min;
+    double sum = 0;
+    double sumSq = 0;
+    for (auto const &sample : window)
+    {
+      min = std::min(min, sample.second);
+      max = std::max(max, sample.second);
+      sum += sample.second;
+      sumSq += sample.second * sample.second;
+    }
+    double n = static_cast<double>(window.size());
+    double mean = sum / n;
+
+    ASSERT_EQ(stats.Count(), window.size());
+    EXPECT_DOUBLE_EQ(stats.Min(), min);
+    EXPECT_DOUBLE_EQ(stats.Max(), max);
+    EXPECT_NEAR(stats.Mean(), mean, 1e-9);
+    EXPECT_NEAR(stats.Variance(), sumSq / n - mean * mean, 1e-6);
+    EXPECT_NEAR(stats.Rms(), std::sqrt(sumSq / n), 1e-9);
+  }
+
+  // a sample after a gap leaves only itself in the window
+  stats.Append(1000, 5);
+  EXPECT_EQ(stats.Count(), 1u);
+  EXPECT_DOUBLE_EQ(stats.Min(), 5.0);
+  EXPECT_DOUBLE_EQ(stats.Max(), 5.0);
+  EXPECT_DOUBLE_EQ(stats.StdDev(), 0.0);
+
+  // changing the window resets the statistics
+  stats.SetWindow(0);
+  EXPECT_EQ(stats.Count(), 0u);
+  stats.Append(2000, 1);
+  stats.Append(3000, 3);
+  EXPECT_EQ(stats.Count(), 2u);
+  EXPECT_DOUBLE_EQ(stats.Mean(), 2.0);
+}
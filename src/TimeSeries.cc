@@ -0,0 +1,244 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <vector>
+
+#include "ignition/gui/TimeSeries.hh"
+
+// Number of samples the buffers are first allocated for, they then double in
+// size up to the capacity
+#define INITIAL_BUFFER_SIZE (1024u)
+
+namespace ignition
+{
+namespace gui
+{
+class TimeSeriesPrivate
+{
+  /// \brief Get the buffer position of a sample
+  /// \param[in] _index Sample index, 0 is the oldest sample
+  /// \return Position in the buffers
+  public: std::size_t Position(std::size_t _index) const
+  {
+    std::size_t pos = this->head + _index;
+    return pos >= this->times.size() ? pos - this->times.size() : pos;
+  }
+
+  /// \brief Reallocate the buffers, keeping the most recent samples that
+  /// fit in chronological order
+  /// \param[in] _bufferSize New size of the buffers
+  public: void Reallocate(std::size_t _bufferSize)
+  {
+    std::size_t keep = std::min(this->size, _bufferSize);
+    std::size_t first = this->size - keep;
+
+    std::vector<double> newTimes(_bufferSize);
+    std::vector<double> newValues(_bufferSize);
+    for (std::size_t i = 0; i < keep; ++i)
+    {
+      std::size_t pos = this->Position(first + i);
+      newTimes[i] = this->times[pos];
+      newValues[i] = this->values[pos];
+    }
+
+    this->times.swap(newTimes);
+    this->values.swap(newValues);
+    this->head = 0;
+    this->size = keep;
+  }
+
+  /// \brief Max number of samples
+  public: std::size_t capacity = 0;
+
+  /// \brief Ring buffer of the sample times, which grows up to the capacity
+  public: std::vector<double> times;
+
+  /// \brief Ring buffer of the sample values
+  public: std::vector<double> values;
+
+  /// \brief Buffer position of the oldest sample
+  public: std::size_t head = 0;
+
+  /// \brief Number of samples
+  public: std::size_t size = 0;
+
+  /// \brief Number of appended samples
+  public: std::uint64_t totalCount = 0;
+};
+}
+}
+
+using namespace ignition;
+using namespace gui;
+
+//////////////////////////////////////////////////
+TimeSeries::TimeSeries(std::size_t _capacity)
+  : dataPtr(std::make_unique<TimeSeriesPrivate>())
+{
+  this->SetCapacity(_capacity);
+}
+
+//////////////////////////////////////////////////
+TimeSeries::~TimeSeries()
+{
+}
+
+//////////////////////////////////////////////////
+void TimeSeries::SetCapacity(std::size_t _capacity)
+{
+  this->dataPtr->capacity = _capacity;
+
+  // a bigger capacity is allocated as samples are appended
+  if (this->dataPtr->times.size() > _capacity)
+    this->dataPtr->Reallocate(_capacity);
+}
+
+//////////////////////////////////////////////////
+std::size_t TimeSeries::Capacity() const
+{
+  return this->dataPtr->capacity;
+}
+
+//////////////////////////////////////////////////
+std::size_t TimeSeries::Size() const
+{
+  return this->dataPtr->size;
+}
+
+//////////////////////////////////////////////////
+bool TimeSeries::Empty() const
+{
+  return this->dataPtr->size == 0;
+}
+
+//////////////////////////////////////////////////
+std::uint64_t TimeSeries::TotalCount() const
+{
+  return this->dataPtr->totalCount;
+}
+
+//////////////////////////////////////////////////
+void TimeSeries::Clear()
+{
+  this->dataPtr->head = 0;
+  this->dataPtr->size = 0;
+  this->dataPtr->totalCount = 0;
+}
+
+//////////////////////////////////////////////////
+void TimeSeries::Append(double _time, double _value)
+{
+  ++this->dataPtr->totalCount;
+
+  std::size_t capacity = this->dataPtr->capacity;
+  if (capacity == 0)
+    return;
+
+  std::size_t bufferSize = this->dataPtr->times.size();
+  if (this->dataPtr->size == bufferSize && bufferSize < capacity)
+  {
+    this->dataPtr->Reallocate(std::min(capacity,
+        std::max<std::size_t>(INITIAL_BUFFER_SIZE, 2 * bufferSize)));
+  }
+
+  std::size_t pos = this->dataPtr->Position(this->dataPtr->size);
+  if (this->dataPtr->size == this->dataPtr->times.size())
+  {
+    // full, overwrite the oldest sample
+    pos = this->dataPtr->head;
+    this->dataPtr->head = this->dataPtr->Position(1);
+  }
+  else
+  {
+    ++this->dataPtr->size;
+  }
+
+  this->dataPtr->times[pos] = _time;
+  this->dataPtr->values[pos] = _value;
+}
+
+//////////////////////////////////////////////////
+void TimeSeries::Append(const double *_times, const double *_values,
+                        std::size_t _count)
+{
+  // only the last samples fit if the batch is bigger than the capacity, the
+  // skipped ones are still counted
+  std::size_t capacity = this->dataPtr->capacity;
+  if (_count > capacity)
+  {
+    this->dataPtr->totalCount += _count - capacity;
+    _times += _count - capacity;
+    _values += _count - capacity;
+    _count = capacity;
+  }
+
+  for (std::size_t i = 0; i < _count; ++i)
+    this->Append(_times[i], _values[i]);
+}
+
+//////////////////////////////////////////////////
+double TimeSeries::Time(std::size_t _index) const
+{
+  return this->dataPtr->times[this->dataPtr->Position(_index)];
+}
+
+//////////////////////////////////////////////////
+double TimeSeries::Value(std::size_t _index) const
+{
+  return this->dataPtr->values[this->dataPtr->Position(_index)];
+}
+
+//////////////////////////////////////////////////
+std::size_t TimeSeries::LowerBound(double _time) const
+{
+  std::size_t low = 0;
+  std::size_t high = this->dataPtr->size;
+  while (low < high)
+  {
+    std::size_t mid = low + (high - low) / 2;
+    if (this->Time(mid) < _time)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  return low;
+}
+
+//////////////////////////////////////////////////
+void TimeSeries::Spans(TimeSeriesSpan &_first, TimeSeriesSpan &_second) const
+{
+  _first = TimeSeriesSpan();
+  _second = TimeSeriesSpan();
+
+  if (this->dataPtr->size == 0)
+    return;
+
+  std::size_t bufferSize = this->dataPtr->times.size();
+  std::size_t head = this->dataPtr->head;
+
+  _first.times = this->dataPtr->times.data() + head;
+  _first.values = this->dataPtr->values.data() + head;
+  _first.size = std::min(this->dataPtr->size, bufferSize - head);
+
+  if (_first.size < this->dataPtr->size)
+  {
+    _second.times = this->dataPtr->times.data();
+    _second.values = this->dataPtr->values.data();
+    _second.size = this->dataPtr->size - _first.size;
+  }
+}
@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "ignition/gui/TimeSeries.hh"
+
+using namespace ignition;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(TimeSeriesTest, Append)
+{
+  TimeSeries series(4);
+  EXPECT_EQ(series.Capacity(), 4u);
+  EXPECT_EQ(series.Size(), 0u);
+  EXPECT_TRUE(series.Empty());
+
+  series.Append(0.0, 10.0);
+  series.Append(1.0, 11.0);
+  series.Append(2.0, 12.0);
+  EXPECT_EQ(series.Size(), 3u);
+  EXPECT_FALSE(series.Empty());
+
+  for (std::size_t i = 0; i < 3; ++i)
+  {
+    EXPECT_DOUBLE_EQ(series.Time(i), i);
+    EXPECT_DOUBLE_EQ(series.Value(i), 10.0 + i);
+  }
+
+  // overwrite the oldest samples once full
+  series.Append(3.0, 13.0);
+  series.Append(4.0, 14.0);
+  series.Append(5.0, 15.0);
+  EXPECT_EQ(series.Size(), 4u);
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    EXPECT_DOUBLE_EQ(series.Time(i), 2.0 + i);
+    EXPECT_DOUBLE_EQ(series.Value(i), 12.0 + i);
+  }
+
+  EXPECT_EQ(series.TotalCount(), 6u);
+
+  series.Clear();
+  EXPECT_TRUE(series.Empty());
+  EXPECT_EQ(series.Capacity(), 4u);
+  EXPECT_EQ(series.TotalCount(), 0u);
+}
+
+/////////////////////////////////////////////////
+TEST(TimeSeriesTest, AppendBatch)
+{
+  TimeSeries series(5);
+
+  std::vector<double> times{0, 1, 2, 3, 4, 5, 6, 7};
+  std::vector<double> values{0, -1, -2, -3, -4, -5, -6, -7};
+
+  // only the last samples are kept if the batch is bigger than the capacity
+  series.Append(times.data(), values.data(), times.size());
+  ASSERT_EQ(series.Size(), 5u);
+  for (std::size_t i = 0; i < 5; ++i)
+  {
+    EXPECT_DOUBLE_EQ(series.Time(i), 3.0 + i);
+    EXPECT_DOUBLE_EQ(series.Value(i), -3.0 - i);
+  }
+
+  // the skipped samples are counted too
+  EXPECT_EQ(series.TotalCount(), 8u);
+}
+
+/////////////////////////////////////////////////
+TEST(TimeSeriesTest, Growth)
+{
+  // the buffers grow past their initial size as samples are appended
+  TimeSeries series(1 << 20);
+  for (int i = 0; i < 5000; ++i)
+    series.Append(i, -i);
+  EXPECT_EQ(series.Capacity(), 1u << 20);
+  ASSERT_EQ(series.Size(), 5000u);
+  for (std::size_t i = 0; i < 5000; i += 499)
+  {
+    EXPECT_DOUBLE_EQ(series.Time(i), i);
+    EXPECT_DOUBLE_EQ(series.Value(i), -1.0 * i);
+  }
+
+  // growing a full, wrapped around series keeps the samples in order
+  TimeSeries small(3000);
+  for (int i = 0; i < 4000; ++i)
+    small.Append(i, i);
+  small.SetCapacity(5000);
+  for (int i = 4000; i < 6000; ++i)
+    small.Append(i, i);
+  ASSERT_EQ(small.Size(), 5000u);
+  EXPECT_EQ(small.TotalCount(), 6000u);
+  for (std::size_t i = 0; i < 5000; ++i)
+    ASSERT_DOUBLE_EQ(small.Time(i), 1000.0 + i);
+}
+
+/////////////////////////////////////////////////
+TEST(TimeSeriesTest, Spans)
+{
+  TimeSeries series(4);
+
+  TimeSeriesSpan first;
+  TimeSeriesSpan second;
+  series.Spans(first, second);
+  EXPECT_EQ(first.size, 0u);
+  EXPECT_EQ(second.size, 0u);
+
+  series.Append(0.0, 0.0);
+  series.Append(1.0, 1.0);
+  series.Spans(first, second);
+  ASSERT_EQ(first.size, 2u);
+  EXPECT_EQ(second.size, 0u);
+  EXPECT_DOUBLE_EQ(first.times[1], 1.0);
+
+  // wrap around
+  for (int i = 2; i < 7; ++i)
+    series.Append(i, i);
+  series.Spans(first, second);
+  ASSERT_EQ(first.size + second.size, 4u);
+
+  std::vector<double> times(first.times, first.times + first.size);
+  times.insert(times.end(), second.times, second.times + second.size);
+  EXPECT_EQ(times, std::vector<double>({3, 4, 5, 6}));
+}
+
+/////////////////////////////////////////////////
+TEST(TimeSeriesTest, LowerBound)
+{
+  TimeSeries series(8);
+  EXPECT_EQ(series.LowerBound(1.0), 0u);
+
+  for (int i = 0; i < 12; ++i)
+    series.Append(i * 0.5, i);
+
+  // the series holds times 2.0 to 5.5
+  EXPECT_EQ(series.LowerBound(0.0), 0u);
+  EXPECT_EQ(series.LowerBound(2.0), 0u);
+  EXPECT_EQ(series.LowerBound(2.1), 1u);
+  EXPECT_EQ(series.LowerBound(5.5), 7u);
+  EXPECT_EQ(series.LowerBound(6.0), 8u);
+}
+
+/////////////////////////////////////////////////
+TEST(TimeSeriesTest, SetCapacity)
+{
+  TimeSeries series(4);
+  for (int i = 0; i < 6; ++i)
+    series.Append(i, i);
+
+  // growing keeps all the samples in order
+  series.SetCapacity(6);
+  EXPECT_EQ(series.Capacity(), 6u);
+  ASSERT_EQ(series.Size(), 4u);
+  EXPECT_DOUBLE_EQ(series.Time(0), 2.0);
+  EXPECT_DOUBLE_EQ(series.Time(3), 5.0);
+
+  // shrinking keeps the most recent samples
+  series.SetCapacity(2);
+  ASSERT_EQ(series.Size(), 2u);
+  EXPECT_DOUBLE_EQ(series.Time(0), 4.0);
+  EXPECT_DOUBLE_EQ(series.Time(1), 5.0);
+
+  // no capacity, nothing is stored
+  series.SetCapacity(0);
+  series.Append(6.0, 6.0);
+  EXPECT_TRUE(series.Empty());
+}
@@ -14,28 +14,393 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <QPointF>
+#include <QTimer>
+#include <QVector>
+#include <QtCharts/QXYSeries>
+
+#include <ignition/common/Console.hh>
+#include <ignition/common/Util.hh>
 #include <ignition/plugin/Register.hh>
+
+#include "ignition/gui/SeriesSpectrum.hh"
+#include "ignition/gui/TimeSeries.hh"
 #include "TransportPlotting.hh"
 
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+/// \brief Computes the spectrum of the samples handed over by the GUI
+/// thread on its own thread
+class SpectrumWorker
+{
+  /// \brief Thread computing the spectrum
+  public: std::thread thread;
+
+  /// \brief Protects the members shared with the thread
+  public: std::mutex mutex;
+
+  /// \brief Notifies the thread of a new job or of stopping
+  public: std::condition_variable condition;
+
+  /// \brief Set to stop the thread
+  public: bool stop = false;
+
+  /// \brief True from handing samples over until their spectrum is
+  /// computed. The thread owns the input while set.
+  public: bool busy = false;
+
+  /// \brief Samples to compute the spectrum of
+  public: std::vector<double> input;
+
+  /// \brief Sample rate of the input in Hz
+  public: double rate = 0;
+
+  /// \brief Number of samples per Welch segment of the input
+  public: std::size_t segment = 1024;
+
+  /// \brief Frequencies of the last computed spectrum
+  public: std::vector<double> frequencies;
+
+  /// \brief Power density of the last computed spectrum
+  public: std::vector<double> power;
+
+  /// \brief Triggers the spectrum requests at the max update rate
+  public: QTimer timer;
+
+  /// \brief Chart of the series of the spectrum
+  public: int chart = 0;
+
+  /// \brief Series of the spectrum, empty if none
+  public: QString fieldID;
+
+  /// \brief Number of most recent samples analyzed
+  public: std::size_t window = 1 << 16;
+
+  /// \brief Number of samples per Welch segment
+  public: std::size_t segmentSize = 1024;
+};
+}
+}
+}
+
 using namespace ignition;
 using namespace gui;
 using namespace plugins;
 
 TransportPlotting::~TransportPlotting()
 {
+  {
+    std::lock_guard<std::mutex> lock(this->spectrum->mutex);
+    this->spectrum->stop = true;
+  }
+  this->spectrum->condition.notify_all();
+  this->spectrum->thread.join();
 }
 
 //////////////////////////////////////////
-void TransportPlotting::LoadConfig(const tinyxml2::XMLElement *)
+void TransportPlotting::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 {
   if (this->title.empty())
     this->title = "Transport plotting";
+
+  if (_pluginElem)
+  {
+    // max number of samples stored per plotted series
+    if (auto capacityElem = _pluginElem->FirstChildElement("series_capacity"))
+    {
+      int capacity = 0;
+      if (capacityElem->QueryIntText(&capacity) == tinyxml2::XML_SUCCESS &&
+          capacity >= 0)
+      {
+        this->dataPtr->SetSeriesCapacity(capacity);
+      }
+    }
+
+    // rate of redrawing the charts, independent of the sampling
+    if (auto rateElem = _pluginElem->FirstChildElement("refresh_rate"))
+    {
+      double rate = 0;
+      if (rateElem->QueryDoubleText(&rate) == tinyxml2::XML_SUCCESS)
+        this->dataPtr->SetRefreshRate(rate);
+    }
+
+    // duration in seconds of the sliding window of the series statistics
+    if (auto windowElem = _pluginElem->FirstChildElement("stats_window"))
+    {
+      double window = 0;
+      if (windowElem->QueryDoubleText(&window) == tinyxml2::XML_SUCCESS)
+        this->dataPtr->SetStatsWindow(window);
+    }
+
+    // time base of the samples: wall, sim or header
+    if (auto sourceElem = _pluginElem->FirstChildElement("time_source"))
+    {
+      if (sourceElem->GetText())
+        this->dataPtr->setTimeSource(QString(sourceElem->GetText()));
+    }
+
+    // topic publishing the sim time, e.g. /world/default/stats
+    if (auto simTopicElem = _pluginElem->FirstChildElement("sim_time_topic"))
+    {
+      if (simTopicElem->GetText())
+        this->dataPtr->SetSimTimeTopic(simTopicElem->GetText());
+    }
+
+    // sampling policies of topics and fields, e.g.
+    // <sampling topic="/imu" field="linear_acceleration-x" mode="max"
+    //           rate="100"/>
+    for (auto samplingElem = _pluginElem->FirstChildElement("sampling");
+         samplingElem != nullptr;
+         samplingElem = samplingElem->NextSiblingElement("sampling"))
+    {
+      auto topic = samplingElem->Attribute("topic");
+      if (!topic)
+      {
+        ignwarn << "Missing topic attribute of <sampling>" << std::endl;
+        continue;
+      }
+      auto field = samplingElem->Attribute("field");
+
+      std::string modeStr = "all";
+      if (auto modeAttr = samplingElem->Attribute("mode"))
+        modeStr = common::lowercase(modeAttr);
+
+      SamplingMode mode;
+      if (modeStr == "all")
+        mode = SamplingMode::ALL;
+      else if (modeStr == "decimate")
+        mode = SamplingMode::DECIMATE;
+      else if (modeStr == "min")
+        mode = SamplingMode::MIN;
+      else if (modeStr == "max")
+        mode = SamplingMode::MAX;
+      else if (modeStr == "mean")
+        mode = SamplingMode::MEAN;
+      else
+      {
+        ignwarn << "Invalid sampling mode [" << modeStr << "]" << std::endl;
+        continue;
+      }
+
+      this->dataPtr->setSamplingPolicy(topic, field ? field : "",
+          static_cast<int>(mode), samplingElem->DoubleAttribute("rate", 0));
+    }
+
+    // spectrum panel settings
+    if (auto rateElem = _pluginElem->FirstChildElement("spectrum_rate"))
+    {
+      double rate = 0;
+      if (rateElem->QueryDoubleText(&rate) == tinyxml2::XML_SUCCESS)
+        this->setSpectrumRate(rate);
+    }
+    if (auto windowElem = _pluginElem->FirstChildElement("spectrum_window"))
+    {
+      int samples = 0;
+      if (windowElem->QueryIntText(&samples) == tinyxml2::XML_SUCCESS)
+        this->setSpectrumWindow(samples);
+    }
+    if (auto segmentElem = _pluginElem->FirstChildElement("spectrum_segment"))
+    {
+      int samples = 0;
+      if (segmentElem->QueryIntText(&samples) == tinyxml2::XML_SUCCESS)
+        this->setSpectrumSegment(samples);
+    }
+
+    // triggered capture mode, e.g.
+    // <trigger field="/imu-linear_acceleration-x" condition="rising"
+    //          threshold="9.8" pre="0.5" post="1" single="false"/>
+    if (auto triggerElem = _pluginElem->FirstChildElement("trigger"))
+    {
+      auto field = triggerElem->Attribute("field");
+      auto condition = triggerElem->Attribute("condition");
+      if (!field)
+      {
+        ignwarn << "Missing field attribute of <trigger>" << std::endl;
+      }
+      else
+      {
+        this->dataPtr->setTrigger(field, condition ? condition : "rising",
+            triggerElem->DoubleAttribute("threshold", 0),
+            triggerElem->DoubleAttribute("pre", 1),
+            triggerElem->DoubleAttribute("post", 1),
+            triggerElem->BoolAttribute("single", false));
+      }
+    }
+  }
 }
 
 //////////////////////////////////////////
 TransportPlotting::TransportPlotting() : Plugin(),
-    dataPtr(new PlottingInterface)
+    dataPtr(new PlottingInterface), spectrum(new SpectrumWorker)
 {
+  this->spectrum->timer.setInterval(500);
+  this->connect(&this->spectrum->timer, SIGNAL(timeout()), this,
+                SLOT(RequestSpectrum()));
+
+  auto worker = this->spectrum.get();
+  worker->thread = std::thread([this, worker]()
+  {
+    SeriesSpectrum spectrum;
+    std::vector<double> frequencies;
+    std::vector<double> power;
+
+    std::unique_lock<std::mutex> lock(worker->mutex);
+    while (true)
+    {
+      worker->condition.wait(lock, [worker]()
+          {
+            return worker->stop || worker->busy;
+          });
+      if (worker->stop)
+        break;
+
+      // the input isn't touched by the GUI thread while busy
+      lock.unlock();
+      spectrum.SetSegmentSize(worker->segment);
+      spectrum.Compute(worker->input.data(), worker->input.size(),
+                       worker->rate, frequencies, power);
+      lock.lock();
+
+      worker->frequencies.swap(frequencies);
+      worker->power.swap(power);
+      worker->busy = false;
+      QMetaObject::invokeMethod(this, "OnSpectrum", Qt::QueuedConnection);
+    }
+  });
+}
+
+//////////////////////////////////////////
+void TransportPlotting::setSpectrumSeries(int _chart, QString _fieldID)
+{
+  this->spectrum->chart = _chart;
+  this->spectrum->fieldID = _fieldID;
+  if (_fieldID.isEmpty())
+    this->spectrum->timer.stop();
+  else
+    this->spectrum->timer.start();
+}
+
+//////////////////////////////////////////
+void TransportPlotting::setSpectrumWindow(int _samples)
+{
+  if (_samples < 8)
+  {
+    ignwarn << "Invalid spectrum window [" << _samples << "]" << std::endl;
+    return;
+  }
+  this->spectrum->window = static_cast<std::size_t>(_samples);
+}
+
+//////////////////////////////////////////
+void TransportPlotting::setSpectrumSegment(int _samples)
+{
+  if (_samples < 8)
+  {
+    ignwarn << "Invalid spectrum segment [" << _samples << "]" << std::endl;
+    return;
+  }
+  this->spectrum->segmentSize = static_cast<std::size_t>(_samples);
+}
+
+//////////////////////////////////////////
+void TransportPlotting::setSpectrumRate(double _rate)
+{
+  if (!(_rate > 0))
+  {
+    ignwarn << "Invalid spectrum rate [" << _rate << "]" << std::endl;
+    return;
+  }
+  this->spectrum->timer.setInterval(
+      std::max(1, static_cast<int>(std::round(1000.0 / _rate))));
+}
+
+//////////////////////////////////////////
+void TransportPlotting::RequestSpectrum()
+{
+  auto worker = this->spectrum.get();
+  auto series = this->dataPtr->Series(worker->chart, worker->fieldID);
+  if (!series || series->Size() < 8)
+    return;
+
+  std::size_t count = std::min(worker->window, series->Size());
+  std::size_t first = series->Size() - count;
+  double duration = series->Time(series->Size() - 1) - series->Time(first);
+  if (!(duration > 0))
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(worker->mutex);
+    // skip this update rather than queue up behind a slow computation
+    if (worker->busy)
+      return;
+
+    // the samples are assumed to be evenly spaced
+    worker->input.resize(count);
+    for (std::size_t i = 0; i < count; ++i)
+      worker->input[i] = series->Value(first + i);
+    worker->rate = (count - 1) / duration;
+    worker->segment = worker->segmentSize;
+    worker->busy = true;
+  }
+  worker->condition.notify_one();
+}
+
+//////////////////////////////////////////
+void TransportPlotting::OnSpectrum()
+{
+  double maxFrequency = 0;
+  double minPower = std::numeric_limits<double>::max();
+  double maxPower = std::numeric_limits<double>::lowest();
+  {
+    std::lock_guard<std::mutex> lock(this->spectrum->mutex);
+    auto const &power = this->spectrum->power;
+    if (power.size() < 2)
+      return;
+
+    maxFrequency = this->spectrum->frequencies.back();
+    for (std::size_t k = 1; k < power.size(); ++k)
+    {
+      double decibels = 10 * std::log10(std::max(power[k], 1e-30));
+      minPower = std::min(minPower, decibels);
+      maxPower = std::max(maxPower, decibels);
+    }
+  }
+
+  emit this->spectrumUpdated(maxFrequency, minPower, maxPower);
+}
+
+//////////////////////////////////////////
+int TransportPlotting::updateSpectrum(QObject *_series)
+{
+  auto xySeries = qobject_cast<QtCharts::QXYSeries *>(_series);
+  if (!xySeries)
+    return 0;
+
+  QVector<QPointF> points;
+  {
+    std::lock_guard<std::mutex> lock(this->spectrum->mutex);
+    auto const &power = this->spectrum->power;
+    for (std::size_t k = 1; k < power.size(); ++k)
+    {
+      points.append(QPointF(this->spectrum->frequencies[k],
+          10 * std::log10(std::max(power[k], 1e-30))));
+    }
+  }
+
+  xySeries->replace(points);
+  return points.size();
 }
 
 // Register this plugin
@@ -29,9 +29,24 @@ namespace gui
 {
 namespace plugins
 {
+class SpectrumWorker;
 
 /// \brief Plots fields from Ignition Transport topics.
 /// Fields can be dragged from the Topic Viewer or the Component Inspector.
+///
+/// The optional spectrum panel shows the power spectral density of the
+/// most recent samples of a plotted series. It is computed by a worker
+/// thread at a bounded rate, so large windows don't block the UI.
+///
+/// ## Configuration
+///
+/// * \<spectrum_rate\> : Max rate of the spectrum updates in Hz, defaults
+///                        to 2.
+/// * \<spectrum_window\> : Number of most recent samples analyzed,
+///                          defaults to 65536.
+/// * \<spectrum_segment\> : Number of samples per Welch segment, which
+///                           sets the frequency resolution, defaults to
+///                           1024.
 class TransportPlotting : public ignition::gui::Plugin
 {
   Q_OBJECT
@@ -45,9 +60,50 @@ class TransportPlotting : public ignition::gui::Plugin
   // Documentation inherited
   public: void LoadConfig(const tinyxml2::XMLElement *) override;
 
+  /// \brief Set the series of the spectrum panel
+  /// \param[in] _chart ID of a chart plotting the series
+  /// \param[in] _fieldID Series ID, empty to stop computing the spectrum
+  public slots: void setSpectrumSeries(int _chart, QString _fieldID);
+
+  /// \brief Set the number of most recent samples analyzed
+  /// \param[in] _samples Number of samples
+  public slots: void setSpectrumWindow(int _samples);
+
+  /// \brief Set the number of samples per Welch segment
+  /// \param[in] _samples Number of samples, rounded up to a power of two
+  public slots: void setSpectrumSegment(int _samples);
+
+  /// \brief Set the max rate of the spectrum updates
+  /// \param[in] _rate Rate in Hz
+  public slots: void setSpectrumRate(double _rate);
+
+  /// \brief Fill a chart series with the last computed spectrum, in dB
+  /// against the frequency in Hz, without the DC bin
+  /// \param[in] _series QXYSeries to fill
+  /// \return Number of points set in the series
+  public slots: int updateSpectrum(QObject *_series);
+
+  /// \brief Notify that a spectrum has been computed
+  /// \param[in] _maxFrequency Nyquist frequency in Hz
+  /// \param[in] _minPower Min power density in dB, without the DC bin
+  /// \param[in] _maxPower Max power density in dB, without the DC bin
+  signals: void spectrumUpdated(double _maxFrequency, double _minPower,
+                                double _maxPower);
+
+  /// \brief Hand the most recent samples of the spectrum series over to
+  /// the worker thread, unless it is still busy. Called by the spectrum
+  /// timer.
+  private slots: void RequestSpectrum();
+
+  /// \brief Called from the worker thread when a spectrum is computed
+  private slots: void OnSpectrum();
+
   /// \brief Interface with the UI to Handle Transport Plotting
   IGN_UTILS_WARN_IGNORE__DLL_INTERFACE_MISSING
   private: std::unique_ptr<PlottingInterface> dataPtr;
+
+  /// \brief Computes the spectrum on its own thread
+  private: std::unique_ptr<SpectrumWorker> spectrum;
   IGN_UTILS_WARN_RESUME__DLL_INTERFACE_MISSING
 };
 
@@ -15,12 +15,87 @@
  *
 */
 import QtQuick 2.0
-import QtQuick.Controls 1.4
+import QtQuick.Controls 2.2
 import QtQuick.Layouts 1.3
+import QtCharts 2.2
 
 import "qrc:/qml"
 
-PlottingInterface {
+ColumnLayout {
   Layout.minimumWidth: 600
   Layout.minimumHeight: 600
+  anchors.fill: parent
+  spacing: 0
+
+  PlottingInterface {
+    id: plotting
+    Layout.fillWidth: true
+    Layout.fillHeight: true
+    anchors.fill: undefined
+  }
+
+  // ================== Spectrum ============================
+  RowLayout {
+    Layout.fillWidth: true
+    Layout.leftMargin: 10
+    Layout.rightMargin: 10
+
+    CheckBox {
+      id: spectrumCheckBox
+      text: "spectrum"
+      onCheckedChanged: {
+        TransportPlotting.setSpectrumSeries(plotting.mainChartID,
+            checked ? spectrumField.text.trim() : "");
+      }
+    }
+
+    TextField {
+      id: spectrumField
+      Layout.fillWidth: true
+      selectByMouse: true
+      enabled: spectrumCheckBox.checked
+      placeholderText: "series of the main chart, e.g. /imu-linear_acceleration-x"
+      onAccepted: TransportPlotting.setSpectrumSeries(plotting.mainChartID, text.trim())
+    }
+  }
+
+  ChartView {
+    id: spectrumChart
+    visible: spectrumCheckBox.checked
+    Layout.fillWidth: true
+    Layout.preferredHeight: 200
+    antialiasing: true
+    legend.visible: false
+
+    ValueAxis {
+      id: frequencyAxis
+      titleText: "Hz"
+      min: 0
+      max: 1
+    }
+
+    ValueAxis {
+      id: powerAxis
+      titleText: "dB"
+      min: -100
+      max: 0
+    }
+
+    LineSeries {
+      id: spectrumSeries
+      axisX: frequencyAxis
+      axisY: powerAxis
+      useOpenGL: true
+    }
+
+    Connections {
+      target: TransportPlotting
+      onSpectrumUpdated: {
+        frequencyAxis.max = _maxFrequency;
+        powerAxis.min = Math.floor(_minPower / 10) * 10;
+        powerAxis.max = Math.ceil(_maxPower / 10) * 10;
+        TransportPlotting.updateSpectrum(spectrumSeries);
+      }
+    }
+  }
 }
@@ -18,15 +18,30 @@
 #include "Scene3D.hh"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <limits>
 #include <map>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include <ignition/common/ColladaLoader.hh>
 #include <ignition/common/Console.hh>
 #include <ignition/common/KeyEvent.hh>
+#include <ignition/common/Mesh.hh>
 #include <ignition/common/MouseEvent.hh>
+#include <ignition/common/OBJLoader.hh>
+#include <ignition/common/STLLoader.hh>
+#include <ignition/common/Util.hh>
 #include <ignition/plugin/Register.hh>
 #include <ignition/common/MeshManager.hh>
 
@@ -60,12 +75,331 @@
 #include "ignition/gui/GuiEvents.hh"
 #include "ignition/gui/MainWindow.hh"
 
+// Max number of threads loading mesh files
+#define MAX_MESH_THREADS (4u)
+// Time in milliseconds spent per frame swapping loaded meshes in
+#define MESH_FRAME_BUDGET_MS (4)
+// First delay in milliseconds between polls of the scene service discovery,
+// doubled on each failed poll
+#define SCENE_POLL_MIN_MS (250)
+// Max delay in milliseconds between polls of the scene service discovery
+#define SCENE_POLL_MAX_MS (5000)
+// Delay in milliseconds between checks of the scene server once synced
+#define SCENE_WATCH_MS (2000)
+// Time in milliseconds to wait for the scene service response
+#define SCENE_REQUEST_TIMEOUT_MS (10000)
+// Number of frames the render loop statistics are computed over
+#define STATS_WINDOW (256u)
+// Milliseconds between publications of the render loop statistics
+#define STATS_PUBLISH_MS (1000)
+// Slot of no entity
+#define NO_SLOT (std::numeric_limits<std::size_t>::max())
+
 namespace ignition
 {
 namespace gui
 {
 namespace plugins
 {
+  /// \brief Poses received from the pose topic, in flat arrays. The
+  /// transport thread fills a back buffer which the render thread swaps with
+  /// its front buffer, so the threads only contend for the swap.
+  class PoseBuffer
+  {
+    /// \brief Set the pose of an entity, replacing the pose set since the
+    /// last clear if any
+    /// \param[in] _id Entity id
+    /// \param[in] _pose Entity pose
+    public: void Set(unsigned int _id, const math::Pose3d &_pose)
+    {
+      auto inserted = this->index.emplace(_id, this->ids.size());
+      if (!inserted.second)
+      {
+        this->poses[inserted.first->second] = _pose;
+        return;
+      }
+      this->ids.push_back(_id);
+      this->poses.push_back(_pose);
+    }
+
+    /// \brief Remove all the poses, keeping the allocated memory
+    public: void Clear()
+    {
+      this->ids.clear();
+      this->poses.clear();
+      this->index.clear();
+    }
+
+    /// \brief Time the first pose since the last clear was received
+    public: std::chrono::steady_clock::time_point received;
+
+    /// \brief Entity ids
+    public: std::vector<unsigned int> ids;
+
+    /// \brief Entity poses, matching ids
+    public: std::vector<math::Pose3d> poses;
+
+    /// \brief Position of each entity id in the arrays
+    public: std::unordered_map<unsigned int, std::size_t> index;
+  };
+
+  /// \brief Last samples of a measurement, over which percentiles are
+  /// computed on request
+  class RollingSamples
+  {
+    /// \brief Add a sample, replacing the oldest one once the window is full
+    /// \param[in] _value Sample value
+    public: void Add(double _value)
+    {
+      if (this->samples.size() < STATS_WINDOW)
+        this->samples.push_back(_value);
+      else
+        this->samples[this->next] = _value;
+      this->next = (this->next + 1) % STATS_WINDOW;
+    }
+
+    /// \brief Compute the percentiles of the samples
+    /// \return Percentiles of the samples
+    public: RenderStat Stat() const
+    {
+      RenderStat stat;
+      stat.count = this->samples.size();
+      if (this->samples.empty())
+        return stat;
+
+      std::vector<double> sorted(this->samples);
+      std::sort(sorted.begin(), sorted.end());
+      auto rank = [&sorted](double _q)
+      {
+        return sorted[static_cast<std::size_t>(
+            std::lround(_q * (sorted.size() - 1)))];
+      };
+      stat.p50 = rank(0.5);
+      stat.p90 = rank(0.9);
+      stat.p99 = rank(0.99);
+      stat.max = sorted.back();
+      return stat;
+    }
+
+    /// \brief Samples, in a ring buffer once the window is full
+    private: std::vector<double> samples;
+
+    /// \brief Position of the next sample in the ring buffer
+    private: std::size_t next = 0;
+  };
+
+  /// \brief What a scene manager update did, for the render loop statistics
+  class SceneUpdateStats
+  {
+    /// \brief Number of entity poses applied
+    public: std::size_t posesApplied = 0;
+
+    /// \brief Number of scene msgs pending at the start of the update
+    public: std::size_t sceneMsgs = 0;
+
+    /// \brief Milliseconds from receiving the oldest applied pose msg to
+    /// applying it, negative if no pose was applied
+    public: double poseLatency = -1;
+  };
+
+  /// \brief Render loop statistics recorded by the render thread and read
+  /// from any thread. Only the percentile queries sort the samples, recording
+  /// a frame is a few writes under a lock.
+  class RenderStatsRecorder
+  {
+    /// \brief Record a frame
+    /// \param[in] _sceneUpdate Scene update duration in milliseconds
+    /// \param[in] _input Mouse handling duration in milliseconds
+    /// \param[in] _cameraUpdate Camera update duration in milliseconds
+    /// \param[in] _scene What the scene update did
+    public: void AddFrame(double _sceneUpdate, double _input,
+                          double _cameraUpdate,
+                          const SceneUpdateStats &_scene)
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->sceneUpdate.Add(_sceneUpdate);
+      this->input.Add(_input);
+      this->cameraUpdate.Add(_cameraUpdate);
+      this->frame.Add(_sceneUpdate + _input + _cameraUpdate);
+      this->posesApplied.Add(static_cast<double>(_scene.posesApplied));
+      this->sceneMsgs.Add(static_cast<double>(_scene.sceneMsgs));
+      if (_scene.poseLatency >= 0)
+        this->poseLatency.Add(_scene.poseLatency);
+      this->frames++;
+    }
+
+    /// \brief Record a texture handoff
+    /// \param[in] _ms Handoff time in milliseconds
+    public: void AddTextureHandoff(double _ms)
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->textureHandoff.Add(_ms);
+    }
+
+    /// \brief Compute the statistics over the recorded frames
+    /// \return Render loop statistics
+    public: RenderStats Stats() const
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      RenderStats stats;
+      stats.frame = this->frame.Stat();
+      stats.sceneUpdate = this->sceneUpdate.Stat();
+      stats.input = this->input.Stat();
+      stats.cameraUpdate = this->cameraUpdate.Stat();
+      stats.textureHandoff = this->textureHandoff.Stat();
+      stats.posesApplied = this->posesApplied.Stat();
+      stats.sceneMsgs = this->sceneMsgs.Stat();
+      stats.poseLatency = this->poseLatency.Stat();
+      stats.frames = this->frames;
+      return stats;
+    }
+
+    /// \brief Protects the samples, recorded from the render thread and the
+    /// Qt scene graph thread
+    private: mutable std::mutex mutex;
+
+    /// \brief Frame durations
+    private: RollingSamples frame;
+
+    /// \brief Scene update durations
+    private: RollingSamples sceneUpdate;
+
+    /// \brief Mouse handling durations
+    private: RollingSamples input;
+
+    /// \brief Camera update durations
+    private: RollingSamples cameraUpdate;
+
+    /// \brief Texture handoff times
+    private: RollingSamples textureHandoff;
+
+    /// \brief Poses applied per frame
+    private: RollingSamples posesApplied;
+
+    /// \brief Scene msgs pending per frame
+    private: RollingSamples sceneMsgs;
+
+    /// \brief Pose latencies
+    private: RollingSamples poseLatency;
+
+    /// \brief Number of frames recorded
+    private: std::uint64_t frames = 0;
+  };
+
+  /// \brief Pool of threads loading mesh files in the background. Each
+  /// thread has its own mesh loaders, the loaded meshes are handed over to
+  /// the render thread which adds them to the mesh manager.
+  class MeshLoaderPool
+  {
+    /// \brief Loaded mesh
+    public: class Result
+    {
+      /// \brief Mesh name, as given in the geometry msg
+      public: std::string name;
+
+      /// \brief Loaded mesh, null if loading failed. Owned by the receiver.
+      public: common::Mesh *mesh = nullptr;
+    };
+
+    /// \brief Destructor, stops the threads and deletes the meshes which
+    /// haven't been taken
+    public: ~MeshLoaderPool();
+
+    /// \brief Check if a mesh file can be loaded by the pool
+    /// \param[in] _path Mesh file path
+    /// \return True for Collada, STL and OBJ files
+    public: static bool Supported(const std::string &_path);
+
+    /// \brief Queue a mesh file to load, starting the threads on the first
+    /// request
+    /// \param[in] _name Mesh name
+    /// \param[in] _path Full path of the mesh file
+    public: void Request(const std::string &_name, const std::string &_path);
+
+    /// \brief Take a loaded mesh
+    /// \param[out] _result Loaded mesh
+    /// \return False if no mesh is loaded since the last call
+    public: bool Pop(Result &_result);
+
+    /// \brief Check if loaded meshes are waiting to be taken
+    /// \return True if a mesh can be taken
+    public: bool Ready();
+
+    /// \brief Called by the loading threads after loading a mesh. Should be
+    /// set before the first request.
+    public: std::function<void()> onLoaded;
+
+    /// \brief Thread function, loading queued mesh files until stopped
+    private: void Run();
+
+    /// \brief Protects the queues and the stop flag
+    private: std::mutex mutex;
+
+    /// \brief Notifies the threads of new requests or of stopping
+    private: std::condition_variable condition;
+
+    /// \brief Queued requests, pairs of mesh name and file path
+    private: std::deque<std::pair<std::string, std::string>> requests;
+
+    /// \brief Loaded meshes waiting to be taken
+    private: std::deque<Result> results;
+
+    /// \brief Loading threads
+    private: std::vector<std::thread> threads;
+
+    /// \brief True to stop the threads
+    private: bool stop = false;
+  };
+
+  /// \brief Properties of a visual material, which identify the visuals that
+  /// can share a material
+  class MaterialKey
+  {
+    /// \brief Equality operator
+    /// \param[in] _other Key to compare with
+    /// \return True if the keys are equal
+    public: bool operator==(const MaterialKey &_other) const
+    {
+      return this->values == _other.values;
+    }
+
+    /// \brief Ambient, diffuse, specular and emissive colors, transparency,
+    /// cast shadows flag, and mask of the colors set by the msg, with -1
+    /// for the default material
+    public: std::array<double, 19> values{};
+  };
+
+  /// \brief Hash of a material key
+  class MaterialKeyHash
+  {
+    /// \brief Hash a material key
+    /// \param[in] _key Material key
+    /// \return Hash value
+    public: std::size_t operator()(const MaterialKey &_key) const
+    {
+      std::size_t seed = 0;
+      for (auto value : _key.values)
+      {
+        seed ^= std::hash<double>()(value) + 0x9e3779b9 + (seed << 6) +
+            (seed >> 2);
+      }
+      return seed;
+    }
+  };
+
+  /// \brief Visual waiting for its mesh to be loaded, showing a placeholder
+  class PendingMesh
+  {
+    /// \brief Visual to add the mesh to
+    public: rendering::VisualPtr::weak_type visual;
+
+    /// \brief Placeholder geometry to replace
+    public: rendering::GeometryPtr::weak_type placeholder;
+
+    /// \brief Visual msg, for the mesh material
+    public: msgs::Visual msg;
+  };
+
   /// \brief Scene manager class for loading and managing objects in the scene
   class SceneManager
   {
@@ -96,12 +430,47 @@ namespace plugins
                       const std::string &_sceneTopic,
                       rendering::ScenePtr _scene);
 
-    /// \brief Make the scene service request and populate the scene
+    /// \brief Start acquiring the scene. Doesn't block: the scene service
+    /// is discovered and requested by the following updates, and requested
+    /// again whenever the server restarts.
     public: void Request();
 
     /// \brief Update the scene based on pose msgs received
     public: void Update();
 
+    /// \brief Set the function called when the scene changes and needs an
+    /// update, from the transport or mesh loading threads. Should be set
+    /// before requesting the scene.
+    /// \param[in] _callback Function to call
+    public: void SetChangeCallback(const std::function<void()> &_callback);
+
+    /// \brief Get the time at which the scene needs an update even if no
+    /// change is notified
+    /// \return Time of the next update, time_point::max() if none
+    public: std::chrono::steady_clock::time_point NextUpdate();
+
+    /// \brief Get what the last update did
+    /// \return Statistics of the last update
+    public: const SceneUpdateStats &LastUpdateStats() const;
+
+    /// \brief Notify the change callback
+    private: void NotifyChange();
+
+    /// \brief Poll the scene service discovery and request the scene once
+    /// the service is available, without blocking the render thread
+    private: void UpdateSceneRequest();
+
+    /// \brief Delay the next discovery poll, increasing the delay
+    /// \param[in] _now Current time
+    private: void BackOff(const std::chrono::steady_clock::time_point &_now);
+
+    /// \brief Delete all the entities loaded from the scene server
+    private: void ClearScene();
+
+    /// \brief Replace the placeholders of the meshes loaded in the
+    /// background with the meshes, for a bounded time per frame
+    private: void UpdateMeshes();
+
     /// \brief Callback function for the pose topic
     /// \param[in] _msg Pose vector msg
     private: void OnPoseVMsg(const msgs::Pose_V &_msg);
@@ -142,9 +511,41 @@ namespace plugins
     /// \param[out] _scale Geometry scale that will be set based on msg param
     /// \param[out] _localPose Additional local pose to be applied after the
     /// visual's pose
+    /// \param[out] _loading Set to true if the mesh of the geometry is
+    /// loaded in the background, a placeholder box is then returned
     /// \return Geometry object created from the msg
     private: rendering::GeometryPtr LoadGeometry(const msgs::Geometry &_msg,
-        math::Vector3d &_scale, math::Pose3d &_localPose);
+        math::Vector3d &_scale, math::Pose3d &_localPose,
+        bool &_loading);
+
+    /// \brief Set the material of a visual geometry from a visual msg
+    /// \param[in] _geom Geometry of the visual
+    /// \param[in] _msg Visual msg
+    private: void ApplyMaterial(rendering::GeometryPtr _geom,
+                                const msgs::Visual &_msg);
+
+    /// \brief Get the material of a visual msg from the material cache,
+    /// creating it on a miss. The material is shared by all the visuals with
+    /// the same material properties, so it mustn't be modified.
+    /// \param[in] _msg Visual msg
+    /// \return Shared material
+    private: rendering::MaterialPtr CachedMaterial(const msgs::Visual &_msg);
+
+    /// \brief Get the mesh descriptor shared by the geometries of a mesh
+    /// asset, a mesh file plus submesh config. The mesh is resolved once per
+    /// asset, and the rendering engine shares its vertex data between the
+    /// geometries created from the descriptor.
+    /// \param[in] _msg Mesh geometry msg
+    /// \param[in] _load True to load the mesh file if it isn't loaded yet
+    /// \return Shared descriptor, null if the mesh isn't loaded
+    private: const rendering::MeshDescriptor *SharedMeshDescriptor(
+        const msgs::MeshGeom &_msg, bool _load);
+
+    /// \brief Request a mesh to be loaded in the background
+    /// \param[in] _name Mesh name
+    /// \return False if the mesh isn't supported by the background loaders,
+    /// it should then be loaded synchronously
+    private: bool RequestMesh(const std::string &_name);
 
     /// \brief Load a material from a material msg
     /// \param[in] _msg Material msg
@@ -160,6 +561,60 @@ namespace plugins
     /// \param[in] _entity Entity to delete
     private: void DeleteEntity(const unsigned int _entity);
 
+    /// \brief Delete the entity held by a slot, of the slot's kind
+    /// \param[in] _slot Slot of the entity to delete
+    private: void DeleteSlot(std::size_t _slot);
+
+    /// \brief Kind of the entity held by a slot
+    private: enum class EntityKind
+    {
+      /// \brief Free slot
+      NONE,
+
+      /// \brief Visual of a model, link or visual msg
+      VISUAL,
+
+      /// \brief Light
+      LIGHT
+    };
+
+    /// \brief Get the slot of an entity, giving it a free slot if it isn't
+    /// indexed yet
+    /// \param[in] _entity Entity id
+    /// \param[in] _kind Entity kind
+    /// \return Slot of the entity
+    private: std::size_t IndexEntity(const unsigned int _entity,
+                                     EntityKind _kind);
+
+    /// \brief Check if an entity is indexed
+    /// \param[in] _entity Entity id
+    /// \param[in] _kind Entity kind
+    /// \return True if the entity is indexed with that kind
+    private: bool Indexed(const unsigned int _entity, EntityKind _kind) const;
+
+    /// \brief Get the slot of an entity
+    /// \param[in] _entity Entity id
+    /// \param[in] _kind Entity kind
+    /// \return Slot of the entity, NO_SLOT if it isn't indexed
+    private: std::size_t Slot(const unsigned int _entity,
+                              EntityKind _kind) const;
+
+    /// \brief Get the slot of an entity of any kind, preferring visuals
+    /// \param[in] _entity Entity id
+    /// \return Slot of the entity, NO_SLOT if it isn't indexed
+    private: std::size_t Slot(const unsigned int _entity) const;
+
+    /// \brief Get the key of an entity in the slot index
+    /// \param[in] _entity Entity id
+    /// \param[in] _kind Entity kind
+    /// \return Key combining the kind and the id
+    private: static std::uint64_t SlotKey(const unsigned int _entity,
+                                          EntityKind _kind);
+
+    /// \brief Remove an entity from the index, freeing its slot
+    /// \param[in] _slot Slot of the entity
+    private: void UnindexEntity(std::size_t _slot);
+
     //// \brief Ign-transport scene service name
     private: std::string service;
 
@@ -175,23 +630,46 @@ namespace plugins
     //// \brief Pointer to the rendering scene
     private: rendering::ScenePtr scene;
 
-    //// \brief Mutex to protect the pose msgs
+    //// \brief Mutex to protect the scene and deletion msgs
     private: std::mutex mutex;
 
-    /// \brief Map of entity id to pose
-    private: std::map<unsigned int, math::Pose3d> poses;
+    //// \brief Mutex to protect the pose back buffer
+    private: std::mutex poseMutex;
+
+    /// \brief Poses written by the transport thread
+    private: PoseBuffer backPoses;
+
+    /// \brief Poses applied by the render thread
+    private: PoseBuffer frontPoses;
 
-    /// \brief Map of entity id to initial local poses
-    /// This is currently used to handle the normal vector in plane visuals. In
-    /// general, this can be used to store any local transforms between the
-    /// parent Visual and geometry.
-    private: std::map<unsigned int, math::Pose3d> localPoses;
+    /// \brief Dense index of entity kind & id, see SlotKey, to slot in the
+    /// entity arrays. A visual and a light may have the same id.
+    /// The entity arrays are only accessed by the render thread.
+    private: std::unordered_map<std::uint64_t, std::size_t> entitySlots;
 
-    /// \brief Map of visual id to visual pointers.
-    private: std::map<unsigned int, rendering::VisualPtr::weak_type> visuals;
+    /// \brief Entity id of each slot
+    private: std::vector<unsigned int> slotIds;
 
-    /// \brief Map of light id to light pointers.
-    private: std::map<unsigned int, rendering::LightPtr::weak_type> lights;
+    /// \brief Entity kind of each slot
+    private: std::vector<EntityKind> slotKinds;
+
+    /// \brief Visual of each visual slot
+    private: std::vector<rendering::VisualPtr::weak_type> slotVisuals;
+
+    /// \brief Light of each light slot
+    private: std::vector<rendering::LightPtr::weak_type> slotLights;
+
+    /// \brief Initial local pose of each slot, applied after the received
+    /// pose. This is currently used to handle the normal vector in plane
+    /// visuals. In general, this can be used to store any local transforms
+    /// between the parent Visual and geometry.
+    private: std::vector<math::Pose3d> slotLocalPoses;
+
+    /// \brief True for the slots with an initial local pose
+    private: std::vector<bool> slotHasLocalPose;
+
+    /// \brief Free slots, reused by the next indexed entities
+    private: std::vector<std::size_t> freeSlots;
 
     /// Entities to be deleted
     private: std::vector<unsigned int> toDeleteEntities;
@@ -199,6 +677,83 @@ namespace plugins
     /// \brief Keeps the a list of unprocessed scene messages
     private: std::vector<msgs::Scene> sceneMsgs;
 
+    /// \brief What the last update did
+    private: SceneUpdateStats updateStats;
+
+    /// \brief State of the scene acquisition
+    private: enum class SceneState
+    {
+      /// \brief Not requested
+      IDLE,
+
+      /// \brief Waiting for the scene service to be advertised
+      DISCOVERING,
+
+      /// \brief Waiting for the scene service response
+      REQUESTING,
+
+      /// \brief Scene received, watching for the server to restart
+      SYNCED
+    };
+
+    /// \brief State of the scene acquisition, render thread only
+    private: SceneState sceneState = SceneState::IDLE;
+
+    /// \brief Time of the next discovery poll
+    private: std::chrono::steady_clock::time_point nextPoll;
+
+    /// \brief Delay between failed discovery polls
+    private: std::chrono::milliseconds pollInterval{SCENE_POLL_MIN_MS};
+
+    /// \brief Time after which the pending request is given up
+    private: std::chrono::steady_clock::time_point requestDeadline;
+
+    /// \brief Process UUID of the server the pending request is sent to
+    private: std::string requestUuid;
+
+    /// \brief Process UUID of the server the scene is received from
+    private: std::string serverUuid;
+
+    /// \brief True once the pending request is responded, protected by
+    /// the mutex
+    private: bool sceneResponded = false;
+
+    /// \brief True if the response is successful, protected by the mutex
+    private: bool sceneSucceeded = false;
+
+    /// \brief True once the pose, deletion and scene topics are subscribed
+    private: std::atomic<bool> subscribed{false};
+
+    /// \brief Called when the scene changes
+    private: std::function<void()> changeCallback;
+
+    /// \brief Materials shared by the visuals, keyed by their properties
+    private: std::unordered_map<MaterialKey, rendering::MaterialPtr,
+        MaterialKeyHash> materialCache;
+
+    /// \brief Number of material cache lookups which found a material
+    private: std::size_t materialHits = 0;
+
+    /// \brief Number of material cache lookups which created a material
+    private: std::size_t materialMisses = 0;
+
+    /// \brief Mesh descriptors shared by the geometries of each mesh asset,
+    /// keyed by mesh file and submesh config
+    private: std::unordered_map<std::string, rendering::MeshDescriptor>
+        meshDescriptors;
+
+    /// \brief Number of mesh geometries created from a shared descriptor
+    private: std::size_t meshHits = 0;
+
+    /// \brief Number of mesh assets resolved
+    private: std::size_t meshMisses = 0;
+
+    /// \brief Loads mesh files in the background
+    private: MeshLoaderPool meshLoader;
+
+    /// \brief Visuals waiting for their mesh, keyed by mesh name
+    private: std::map<std::string, std::vector<PendingMesh>> pendingMeshes;
+
     /// \brief Transport node for making service request and subscribing to
     /// pose topic
     private: ignition::transport::Node node;
@@ -242,6 +797,22 @@ namespace plugins
 
     /// \brief View control focus target
     public: math::Vector3d target;
+
+    /// \brief Called to request a new frame
+    public: std::function<void()> renderRequest;
+
+    /// \brief Render loop statistics
+    public: RenderStatsRecorder stats;
+
+    /// \brief Node to publish the render loop statistics
+    public: transport::Node node;
+
+    /// \brief Render loop statistics publisher, invalid if there's no stats
+    /// topic
+    public: transport::Node::Publisher statsPub;
+
+    /// \brief Time of the next statistics publication
+    public: std::chrono::steady_clock::time_point nextStatsPublish;
   };
 
   /// \brief Private data class for RenderWindowItem
@@ -260,6 +831,10 @@ namespace plugins
   /// \brief Private data class for Scene3D
   class Scene3DPrivate
   {
+    /// \brief Render window, found once when loading the config, so input
+    /// events and render requests don't search the item tree, and it can be
+    /// used from threads other than the GUI thread
+    public: std::atomic<RenderWindowItem *> renderWindow{nullptr};
   };
 }
 }
@@ -303,122 +878,369 @@ void SceneManager::Load(const std::string &_service,
 /////////////////////////////////////////////////
 void SceneManager::Request()
 {
-  // wait for the service to be advertized
+  this->sceneState = SceneState::DISCOVERING;
+  this->pollInterval = std::chrono::milliseconds(SCENE_POLL_MIN_MS);
+  this->nextPoll = std::chrono::steady_clock::now();
+}
+
+/////////////////////////////////////////////////
+void SceneManager::UpdateSceneRequest()
+{
+  if (this->sceneState == SceneState::IDLE)
+    return;
+
+  auto now = std::chrono::steady_clock::now();
+
+  if (this->sceneState == SceneState::REQUESTING)
+  {
+    bool responded;
+    bool succeeded;
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      responded = this->sceneResponded;
+      succeeded = this->sceneSucceeded;
+    }
+
+    if (responded && succeeded)
+    {
+      this->serverUuid = this->requestUuid;
+      this->sceneState = SceneState::SYNCED;
+      this->nextPoll = now + std::chrono::milliseconds(SCENE_WATCH_MS);
+    }
+    else if (responded || now >= this->requestDeadline)
+    {
+      if (!responded)
+      {
+        ignwarn << "No response from service " << this->service
+                << ", retrying" << std::endl;
+      }
+      this->sceneState = SceneState::DISCOVERING;
+      this->BackOff(now);
+    }
+    return;
+  }
+
+  if (now < this->nextPoll)
+    return;
+
   std::vector<transport::ServicePublisher> publishers;
-  const std::chrono::duration<double> sleepDuration{1.0};
-  const std::size_t tries = 30;
-  for (std::size_t i = 0; i < tries; ++i)
+  this->node.ServiceInfo(this->service, publishers);
+  std::string uuid = publishers.empty() ? "" : publishers.front().PUuid();
+
+  if (this->sceneState == SceneState::SYNCED)
+  {
+    if (uuid == this->serverUuid)
+    {
+      this->nextPoll = now + std::chrono::milliseconds(SCENE_WATCH_MS);
+      return;
+    }
+
+    // the server is gone or restarted, the scene is kept until a server
+    // is found again
+    this->sceneState = SceneState::DISCOVERING;
+    this->pollInterval = std::chrono::milliseconds(SCENE_POLL_MIN_MS);
+  }
+
+  if (uuid.empty())
   {
-    this->node.ServiceInfo(this->service, publishers);
-    if (publishers.size() > 0)
-      break;
-    std::this_thread::sleep_for(sleepDuration);
     igndbg << "Waiting for service " << this->service << "\n";
+    this->BackOff(now);
+    return;
+  }
+
+  // the same server reappeared, e.g. after a discovery hiccup
+  if (uuid == this->serverUuid)
+  {
+    this->sceneState = SceneState::SYNCED;
+    this->nextPoll = now + std::chrono::milliseconds(SCENE_WATCH_MS);
+    return;
+  }
+
+  // a new server, its entity ids may clash with the previous server's ones
+  if (!this->serverUuid.empty())
+  {
+    ignmsg << "Service " << this->service << " restarted, reloading the "
+           << "scene" << std::endl;
+    this->ClearScene();
+    this->serverUuid.clear();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->sceneResponded = false;
+    this->sceneSucceeded = false;
   }
 
-  if (publishers.empty() ||
-      !this->node.Request(this->service, &SceneManager::OnSceneSrvMsg, this))
+  if (!this->node.Request(this->service, &SceneManager::OnSceneSrvMsg, this))
   {
     ignerr << "Error making service request to " << this->service << std::endl;
+    this->BackOff(now);
+    return;
   }
+
+  this->requestUuid = uuid;
+  this->sceneState = SceneState::REQUESTING;
+  this->requestDeadline =
+      now + std::chrono::milliseconds(SCENE_REQUEST_TIMEOUT_MS);
+  this->pollInterval = std::chrono::milliseconds(SCENE_POLL_MIN_MS);
 }
 
 /////////////////////////////////////////////////
-void SceneManager::OnPoseVMsg(const msgs::Pose_V &_msg)
+void SceneManager::SetChangeCallback(const std::function<void()> &_callback)
 {
-  std::lock_guard<std::mutex> lock(this->mutex);
-  for (int i = 0; i < _msg.pose_size(); ++i)
+  this->changeCallback = _callback;
+  this->meshLoader.onLoaded = _callback;
+}
+
+/////////////////////////////////////////////////
+void SceneManager::NotifyChange()
+{
+  if (this->changeCallback)
+    this->changeCallback();
+}
+
+/////////////////////////////////////////////////
+std::chrono::steady_clock::time_point SceneManager::NextUpdate()
+{
+  // meshes left over by the frame budget
+  if (this->meshLoader.Ready())
+    return std::chrono::steady_clock::now();
+
+  switch (this->sceneState)
   {
-    math::Pose3d pose = msgs::Convert(_msg.pose(i));
+    case SceneState::DISCOVERING:
+    case SceneState::SYNCED:
+      return this->nextPoll;
+    case SceneState::REQUESTING:
+      return this->requestDeadline;
+    default:
+      return std::chrono::steady_clock::time_point::max();
+  }
+}
 
-    // apply additional local poses if available
-    const auto it = this->localPoses.find(_msg.pose(i).id());
-    if (it != this->localPoses.end())
-    {
-      pose = pose * it->second;
-    }
+/////////////////////////////////////////////////
+void SceneManager::BackOff(const std::chrono::steady_clock::time_point &_now)
+{
+  this->nextPoll = _now + this->pollInterval;
+  this->pollInterval = std::min(this->pollInterval * 2,
+      std::chrono::milliseconds(SCENE_POLL_MAX_MS));
+}
 
-    this->poses[_msg.pose(i).id()] = pose;
+/////////////////////////////////////////////////
+void SceneManager::ClearScene()
+{
+  for (std::size_t slot = 0; slot < this->slotIds.size(); ++slot)
+  {
+    // deleted by slot, as a light and a visual may share an id
+    if (this->slotKinds[slot] != EntityKind::NONE)
+      this->DeleteSlot(slot);
   }
+
+  // the cached materials were only used by the deleted visuals
+  for (auto const &material : this->materialCache)
+    this->scene->DestroyMaterial(material.second);
+  this->materialCache.clear();
+  this->materialHits = 0;
+  this->materialMisses = 0;
+}
+
+/////////////////////////////////////////////////
+void SceneManager::OnPoseVMsg(const msgs::Pose_V &_msg)
+{
+  auto now = std::chrono::steady_clock::now();
+  {
+    std::lock_guard<std::mutex> lock(this->poseMutex);
+    if (this->backPoses.ids.empty())
+      this->backPoses.received = now;
+    for (int i = 0; i < _msg.pose_size(); ++i)
+      this->backPoses.Set(_msg.pose(i).id(), msgs::Convert(_msg.pose(i)));
+  }
+  this->NotifyChange();
 }
 
 /////////////////////////////////////////////////
 void SceneManager::OnDeletionMsg(const msgs::UInt32_V &_msg)
 {
-  std::lock_guard<std::mutex> lock(this->mutex);
-  std::copy(_msg.data().begin(), _msg.data().end(),
-            std::back_inserter(this->toDeleteEntities));
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    std::copy(_msg.data().begin(), _msg.data().end(),
+              std::back_inserter(this->toDeleteEntities));
+  }
+  this->NotifyChange();
 }
 
 /////////////////////////////////////////////////
 void SceneManager::Update()
 {
-  // process msgs
-  std::lock_guard<std::mutex> lock(this->mutex);
+  this->UpdateSceneRequest();
 
-  for (const auto &msg : this->sceneMsgs)
+  this->updateStats = SceneUpdateStats();
+
+  // process msgs
   {
-    this->LoadScene(msg);
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    this->updateStats.sceneMsgs = this->sceneMsgs.size();
+    for (const auto &msg : this->sceneMsgs)
+    {
+      this->LoadScene(msg);
+    }
+    this->sceneMsgs.clear();
+
+    for (const auto &entity : this->toDeleteEntities)
+    {
+      this->DeleteEntity(entity);
+    }
+    this->toDeleteEntities.clear();
   }
-  this->sceneMsgs.clear();
 
-  for (const auto &entity : this->toDeleteEntities)
+  this->UpdateMeshes();
+
+  // take the poses received since the last update, the transport thread
+  // then writes to the buffer emptied by the previous update
   {
-    this->DeleteEntity(entity);
+    std::lock_guard<std::mutex> lock(this->poseMutex);
+    std::swap(this->backPoses, this->frontPoses);
   }
-  this->toDeleteEntities.clear();
 
-
-  for (auto pIt = this->poses.begin(); pIt != this->poses.end();)
+  for (std::size_t i = 0; i < this->frontPoses.ids.size(); ++i)
   {
-    auto vIt = this->visuals.find(pIt->first);
-    if (vIt != this->visuals.end())
+    auto slot = this->Slot(this->frontPoses.ids[i]);
+    if (slot == NO_SLOT)
+      continue;
+
+    math::Pose3d pose = this->frontPoses.poses[i];
+
+    // apply additional local poses if available
+    if (this->slotHasLocalPose[slot])
+      pose = pose * this->slotLocalPoses[slot];
+
+    if (this->slotKinds[slot] == EntityKind::VISUAL)
     {
-      auto visual = vIt->second.lock();
-      if (visual)
-      {
-        visual->SetLocalPose(pIt->second);
-      }
-      else
+      auto visual = this->slotVisuals[slot].lock();
+      if (!visual)
       {
-        this->visuals.erase(vIt);
+        this->UnindexEntity(slot);
+        continue;
       }
-      this->poses.erase(pIt++);
+      visual->SetLocalPose(pose);
     }
     else
     {
-      auto lIt = this->lights.find(pIt->first);
-      if (lIt != this->lights.end())
-      {
-        auto light = lIt->second.lock();
-        if (light)
-        {
-          light->SetLocalPose(pIt->second);
-        }
-        else
-        {
-          this->lights.erase(lIt);
-        }
-        this->poses.erase(pIt++);
-      }
-      else
+      auto light = this->slotLights[slot].lock();
+      if (!light)
       {
-        ++pIt;
+        this->UnindexEntity(slot);
+        continue;
       }
+      light->SetLocalPose(pose);
     }
+    this->updateStats.posesApplied++;
+  }
+
+  if (this->updateStats.posesApplied > 0)
+  {
+    this->updateStats.poseLatency =
+        std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - this->frontPoses.received).count();
   }
 
   // Note we are clearing the pose msgs here but later on we may need to
   // consider the case where pose msgs arrive before scene/visual msgs
-  this->poses.clear();
+  this->frontPoses.Clear();
+}
+
+/////////////////////////////////////////////////
+const SceneUpdateStats &SceneManager::LastUpdateStats() const
+{
+  return this->updateStats;
+}
+
+/////////////////////////////////////////////////
+std::size_t SceneManager::IndexEntity(const unsigned int _entity,
+                                      EntityKind _kind)
+{
+  auto key = SlotKey(_entity, _kind);
+  std::size_t slot;
+  auto slotIt = this->entitySlots.find(key);
+  if (slotIt != this->entitySlots.end())
+  {
+    slot = slotIt->second;
+  }
+  else if (!this->freeSlots.empty())
+  {
+    slot = this->freeSlots.back();
+    this->freeSlots.pop_back();
+    this->entitySlots[key] = slot;
+  }
+  else
+  {
+    slot = this->slotIds.size();
+    this->slotIds.emplace_back();
+    this->slotKinds.emplace_back();
+    this->slotVisuals.emplace_back();
+    this->slotLights.emplace_back();
+    this->slotLocalPoses.emplace_back();
+    this->slotHasLocalPose.emplace_back();
+    this->entitySlots[key] = slot;
+  }
+
+  this->slotIds[slot] = _entity;
+  this->slotKinds[slot] = _kind;
+  this->slotVisuals[slot].reset();
+  this->slotLights[slot].reset();
+  this->slotHasLocalPose[slot] = false;
+  return slot;
+}
+
+/////////////////////////////////////////////////
+bool SceneManager::Indexed(const unsigned int _entity, EntityKind _kind) const
+{
+  return this->Slot(_entity, _kind) != NO_SLOT;
 }
 
+/////////////////////////////////////////////////
+std::size_t SceneManager::Slot(const unsigned int _entity,
+                               EntityKind _kind) const
+{
+  auto slotIt = this->entitySlots.find(SlotKey(_entity, _kind));
+  return slotIt == this->entitySlots.end() ? NO_SLOT : slotIt->second;
+}
+
+/////////////////////////////////////////////////
+std::size_t SceneManager::Slot(const unsigned int _entity) const
+{
+  auto slot = this->Slot(_entity, EntityKind::VISUAL);
+  return slot != NO_SLOT ? slot : this->Slot(_entity, EntityKind::LIGHT);
+}
+
+/////////////////////////////////////////////////
+std::uint64_t SceneManager::SlotKey(const unsigned int _entity,
+                                    EntityKind _kind)
+{
+  return (static_cast<std::uint64_t>(_kind) << 32) | _entity;
+}
+
+/////////////////////////////////////////////////
+void SceneManager::UnindexEntity(std::size_t _slot)
+{
+  this->entitySlots.erase(SlotKey(this->slotIds[_slot],
+                                  this->slotKinds[_slot]));
+  this->slotKinds[_slot] = EntityKind::NONE;
+  this->slotVisuals[_slot].reset();
+  this->slotLights[_slot].reset();
+  this->slotHasLocalPose[_slot] = false;
+  this->freeSlots.push_back(_slot);
+}
 
 /////////////////////////////////////////////////
 void SceneManager::OnSceneMsg(const msgs::Scene &_msg)
 {
-  std::lock_guard<std::mutex> lock(this->mutex);
-  this->sceneMsgs.push_back(_msg);
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->sceneMsgs.push_back(_msg);
+  }
+  this->NotifyChange();
 }
 
 /////////////////////////////////////////////////
@@ -428,13 +1250,26 @@ void SceneManager::OnSceneSrvMsg(const msgs::Scene &_msg, const bool result)
   {
     ignerr << "Error making service request to " << this->service
            << std::endl;
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->sceneResponded = true;
+      this->sceneSucceeded = false;
+    }
+    this->NotifyChange();
     return;
   }
 
   {
     std::lock_guard<std::mutex> lock(this->mutex);
     this->sceneMsgs.push_back(_msg);
+    this->sceneResponded = true;
+    this->sceneSucceeded = true;
   }
+  this->NotifyChange();
+
+  // the topics stay subscribed when the server restarts
+  if (this->subscribed.exchange(true))
+    return;
 
   if (!this->poseTopic.empty())
   {
@@ -487,12 +1322,14 @@ void SceneManager::OnSceneSrvMsg(const msgs::Scene &_msg, const bool result)
 void SceneManager::LoadScene(const msgs::Scene &_msg)
 {
   rendering::VisualPtr rootVis = this->scene->RootVisual();
+  std::size_t lookups = this->materialHits + this->materialMisses;
+  std::size_t meshLookups = this->meshHits + this->meshMisses;
 
   // load models
   for (int i = 0; i < _msg.model_size(); ++i)
   {
     // Only add if it's not already loaded
-    if (this->visuals.find(_msg.model(i).id()) == this->visuals.end())
+    if (!this->Indexed(_msg.model(i).id(), EntityKind::VISUAL))
     {
       rendering::VisualPtr modelVis = this->LoadModel(_msg.model(i));
       if (modelVis)
@@ -505,7 +1342,7 @@ void SceneManager::LoadScene(const msgs::Scene &_msg)
   // load lights
   for (int i = 0; i < _msg.light_size(); ++i)
   {
-    if (this->lights.find(_msg.light(i).id()) == this->lights.end())
+    if (!this->Indexed(_msg.light(i).id(), EntityKind::LIGHT))
     {
       rendering::LightPtr light = this->LoadLight(_msg.light(i));
       if (light)
@@ -514,6 +1351,24 @@ void SceneManager::LoadScene(const msgs::Scene &_msg)
         ignerr << "Failed to load light: " << _msg.light(i).name() << std::endl;
     }
   }
+
+  // report the material sharing of the loaded visuals
+  std::size_t total = this->materialHits + this->materialMisses;
+  if (total > lookups)
+  {
+    igndbg << "Material cache: " << this->materialHits << " hits, "
+           << this->materialMisses << " misses ("
+           << 100.0 * this->materialHits / total << "% hit rate), "
+           << this->materialCache.size() << " materials" << std::endl;
+  }
+
+  // report the mesh asset sharing of the loaded visuals
+  if (this->meshHits + this->meshMisses > meshLookups)
+  {
+    igndbg << "Mesh assets: " << this->meshDescriptors.size()
+           << " unique assets for " << this->meshHits + this->meshMisses
+           << " mesh geometries" << std::endl;
+  }
 }
 
 /////////////////////////////////////////////////
@@ -522,7 +1377,8 @@ rendering::VisualPtr SceneManager::LoadModel(const msgs::Model &_msg)
   rendering::VisualPtr modelVis = this->scene->CreateVisual();
   if (_msg.has_pose())
     modelVis->SetLocalPose(msgs::Convert(_msg.pose()));
-  this->visuals[_msg.id()] = modelVis;
+  this->slotVisuals[this->IndexEntity(_msg.id(), EntityKind::VISUAL)] =
+      modelVis;
 
   // load links
   for (int i = 0; i < _msg.link_size(); ++i)
@@ -554,7 +1410,8 @@ rendering::VisualPtr SceneManager::LoadLink(const msgs::Link &_msg)
   rendering::VisualPtr linkVis = this->scene->CreateVisual();
   if (_msg.has_pose())
     linkVis->SetLocalPose(msgs::Convert(_msg.pose()));
-  this->visuals[_msg.id()] = linkVis;
+  this->slotVisuals[this->IndexEntity(_msg.id(), EntityKind::VISUAL)] =
+      linkVis;
 
   // load visuals
   for (int i = 0; i < _msg.visual_size(); ++i)
@@ -586,12 +1443,14 @@ rendering::VisualPtr SceneManager::LoadVisual(const msgs::Visual &_msg)
     return rendering::VisualPtr();
 
   rendering::VisualPtr visualVis = this->scene->CreateVisual();
-  this->visuals[_msg.id()] = visualVis;
+  auto slot = this->IndexEntity(_msg.id(), EntityKind::VISUAL);
+  this->slotVisuals[slot] = visualVis;
 
   math::Vector3d scale = math::Vector3d::One;
   math::Pose3d localPose;
+  bool loading = false;
   rendering::GeometryPtr geom =
-      this->LoadGeometry(_msg.geometry(), scale, localPose);
+      this->LoadGeometry(_msg.geometry(), scale, localPose, loading);
 
   if (_msg.has_pose())
     visualVis->SetLocalPose(msgs::Convert(_msg.pose()) * localPose);
@@ -601,85 +1460,142 @@ rendering::VisualPtr SceneManager::LoadVisual(const msgs::Visual &_msg)
   if (geom)
   {
     // store the local pose
-    this->localPoses[_msg.id()] = localPose;
+    this->slotLocalPoses[slot] = localPose;
+    this->slotHasLocalPose[slot] = localPose != math::Pose3d::Zero;
 
     visualVis->AddGeometry(geom);
     visualVis->SetLocalScale(scale);
 
-    // set material
-    rendering::MaterialPtr material{nullptr};
-    if (_msg.has_material())
+    if (loading)
     {
-      material = this->LoadMaterial(_msg.material());
+      // the mesh replaces the placeholder once loaded
+      this->pendingMeshes[_msg.geometry().mesh().filename()].push_back(
+          {visualVis, geom, _msg});
     }
-    // Don't set a default material for meshes because they
-    // may have their own
-    // TODO(anyone) support overriding mesh material
-    else if (!_msg.geometry().has_mesh())
+    else
     {
-      // create default material
-      material = this->scene->Material("ign-grey");
-      if (!material)
-      {
-        material = this->scene->CreateMaterial("ign-grey");
-        material->SetAmbient(0.3, 0.3, 0.3);
-        material->SetDiffuse(0.7, 0.7, 0.7);
-        material->SetSpecular(1.0, 1.0, 1.0);
-        material->SetRoughness(0.2f);
-        material->SetMetalness(1.0f);
-      }
+      this->ApplyMaterial(geom, _msg);
     }
-    else
+  }
+  else
+  {
+    ignerr << "Failed to load geometry for visual: " << _msg.name()
+           << std::endl;
+  }
+
+  return visualVis;
+}
+
+/////////////////////////////////////////////////
+void SceneManager::ApplyMaterial(rendering::GeometryPtr _geom,
+                                 const msgs::Visual &_msg)
+{
+  // Don't set a default material for meshes because they
+  // may have their own
+  // TODO(anyone) support overriding mesh material
+  if (!_msg.has_material() && _msg.geometry().has_mesh())
+  {
+    // meshes created by mesh loader may have their own materials
+    // update/override their properties based on input sdf element values
+    auto mesh = std::dynamic_pointer_cast<rendering::Mesh>(_geom);
+    for (unsigned int i = 0; i < mesh->SubMeshCount(); ++i)
     {
-      // meshes created by mesh loader may have their own materials
-      // update/override their properties based on input sdf element values
-      auto mesh = std::dynamic_pointer_cast<rendering::Mesh>(geom);
-      for (unsigned int i = 0; i < mesh->SubMeshCount(); ++i)
+      auto submesh = mesh->SubMeshByIndex(i);
+      auto submeshMat = submesh->Material();
+      if (submeshMat)
       {
-        auto submesh = mesh->SubMeshByIndex(i);
-        auto submeshMat = submesh->Material();
-        if (submeshMat)
-        {
-          double productAlpha = (1.0-_msg.transparency()) *
-              (1.0 - submeshMat->Transparency());
-          submeshMat->SetTransparency(1 - productAlpha);
-          submeshMat->SetCastShadows(_msg.cast_shadows());
-        }
+        double productAlpha = (1.0-_msg.transparency()) *
+            (1.0 - submeshMat->Transparency());
+        submeshMat->SetTransparency(1 - productAlpha);
+        submeshMat->SetCastShadows(_msg.cast_shadows());
       }
     }
+    return;
+  }
+
+  // the cached material is shared instead of cloned per visual
+  _geom->SetMaterial(this->CachedMaterial(_msg), false);
+}
 
-    if (material)
+/////////////////////////////////////////////////
+rendering::MaterialPtr SceneManager::CachedMaterial(const msgs::Visual &_msg)
+{
+  MaterialKey key;
+  auto &values = key.values;
+  if (_msg.has_material())
+  {
+    auto const &materialMsg = _msg.material();
+    const msgs::Color *colors[] = {
+        materialMsg.has_ambient() ? &materialMsg.ambient() : nullptr,
+        materialMsg.has_diffuse() ? &materialMsg.diffuse() : nullptr,
+        materialMsg.has_specular() ? &materialMsg.specular() : nullptr,
+        materialMsg.has_emissive() ? &materialMsg.emissive() : nullptr};
+    for (int i = 0; i < 4; ++i)
     {
-      // set transparency
-      material->SetTransparency(_msg.transparency());
+      if (!colors[i])
+        continue;
+
+      values[i * 4] = colors[i]->r();
+      values[i * 4 + 1] = colors[i]->g();
+      values[i * 4 + 2] = colors[i]->b();
+      values[i * 4 + 3] = colors[i]->a();
+      values[18] += 1 << i;
+    }
+  }
+  else
+  {
+    values[18] = -1;
+  }
+  values[16] = _msg.transparency();
+  values[17] = _msg.cast_shadows();
 
-      // cast shadows
-      material->SetCastShadows(_msg.cast_shadows());
+  auto materialIt = this->materialCache.find(key);
+  if (materialIt != this->materialCache.end())
+  {
+    this->materialHits++;
+    return materialIt->second;
+  }
+  this->materialMisses++;
 
-      geom->SetMaterial(material);
-      // todo(anyone) SetMaterial function clones the input material.
-      // but does not take ownership of it so we need to destroy it here.
-      // This is not ideal. We should let ign-rendering handle the lifetime
-      // of this material
-      this->scene->DestroyMaterial(material);
-    }
+  rendering::MaterialPtr material;
+  if (_msg.has_material())
+  {
+    material = this->LoadMaterial(_msg.material());
   }
   else
   {
-    ignerr << "Failed to load geometry for visual: " << _msg.name()
-           << std::endl;
+    // create default material
+    material = this->scene->CreateMaterial();
+    material->SetAmbient(0.3, 0.3, 0.3);
+    material->SetDiffuse(0.7, 0.7, 0.7);
+    material->SetSpecular(1.0, 1.0, 1.0);
+    material->SetRoughness(0.2f);
+    material->SetMetalness(1.0f);
   }
 
-  return visualVis;
+  // set transparency
+  material->SetTransparency(_msg.transparency());
+
+  // cast shadows
+  material->SetCastShadows(_msg.cast_shadows());
+
+  this->materialCache[key] = material;
+  return material;
 }
 
 /////////////////////////////////////////////////
 rendering::GeometryPtr SceneManager::LoadGeometry(const msgs::Geometry &_msg,
-    math::Vector3d &_scale, math::Pose3d &_localPose)
+    math::Vector3d &_scale, math::Pose3d &_localPose, bool &_loading)
 {
+  _loading = false;
   math::Vector3d scale = math::Vector3d::One;
   math::Pose3d localPose = math::Pose3d::Zero;
   rendering::GeometryPtr geom{nullptr};
+  // Boxes, cylinders, spheres and planes are unit shapes scaled by their
+  // visual. The render engine creates each of them from its single unit mesh
+  // of that type, so the vertex data is already shared. Unlike mesh
+  // descriptors, the geometries themselves can't be shared, because a
+  // geometry only has one parent visual.
   if (_msg.has_box())
   {
     geom = this->scene->CreateBox();
@@ -744,15 +1660,31 @@ rendering::GeometryPtr SceneManager::LoadGeometry(const msgs::Geometry &_msg,
       ignerr << "Mesh geometry missing filename" << std::endl;
       return geom;
     }
-    rendering::MeshDescriptor descriptor;
-
     // Assume absolute path to mesh file
-    descriptor.meshName = _msg.mesh().filename();
-
-    ignition::common::MeshManager* meshManager =
-        ignition::common::MeshManager::Instance();
-    descriptor.mesh = meshManager->Load(descriptor.meshName);
-    geom = this->scene->CreateMesh(descriptor);
+    auto descriptor = this->SharedMeshDescriptor(_msg.mesh(), false);
+    if (!descriptor && this->RequestMesh(_msg.mesh().filename()))
+    {
+      // show a box until the mesh is loaded in the background
+      geom = this->scene->CreateBox();
+      rendering::MaterialPtr material =
+          this->scene->Material("ign-placeholder");
+      if (!material)
+      {
+        material = this->scene->CreateMaterial("ign-placeholder");
+        material->SetAmbient(0.3, 0.3, 0.3);
+        material->SetDiffuse(0.7, 0.7, 0.7);
+        material->SetTransparency(0.7);
+      }
+      geom->SetMaterial(material, false);
+      _loading = true;
+    }
+    else
+    {
+      if (!descriptor)
+        descriptor = this->SharedMeshDescriptor(_msg.mesh(), true);
+      if (descriptor)
+        geom = this->scene->CreateMesh(*descriptor);
+    }
 
     scale = msgs::Convert(_msg.mesh().scale());
   }
@@ -840,30 +1772,270 @@ rendering::LightPtr SceneManager::LoadLight(const msgs::Light &_msg)
 
   light->SetCastShadows(_msg.cast_shadows());
 
-  this->lights[_msg.id()] = light;
+  this->slotLights[this->IndexEntity(_msg.id(), EntityKind::LIGHT)] = light;
   return light;
 }
 
 /////////////////////////////////////////////////
 void SceneManager::DeleteEntity(const unsigned int _entity)
 {
-  if (this->visuals.find(_entity) != this->visuals.end())
+  auto slot = this->Slot(_entity);
+  if (slot != NO_SLOT)
+    this->DeleteSlot(slot);
+}
+
+/////////////////////////////////////////////////
+void SceneManager::DeleteSlot(std::size_t _slot)
+{
+  if (this->slotKinds[_slot] == EntityKind::VISUAL)
   {
-    auto visual = this->visuals[_entity].lock();
+    auto visual = this->slotVisuals[_slot].lock();
     if (visual)
     {
       this->scene->DestroyVisual(visual, true);
     }
-    this->visuals.erase(_entity);
   }
-  else if (this->lights.find(_entity) != this->lights.end())
+  else if (this->slotKinds[_slot] == EntityKind::LIGHT)
   {
-    auto light = this->lights[_entity].lock();
+    auto light = this->slotLights[_slot].lock();
     if (light)
     {
       this->scene->DestroyLight(light, true);
     }
-    this->lights.erase(_entity);
+  }
+  this->UnindexEntity(_slot);
+}
+
+/////////////////////////////////////////////////
+const rendering::MeshDescriptor *SceneManager::SharedMeshDescriptor(
+    const msgs::MeshGeom &_msg, bool _load)
+{
+  std::string key = _msg.filename() + "::" + _msg.submesh() +
+      (_msg.center_submesh() ? "::centered" : "");
+  auto descriptorIt = this->meshDescriptors.find(key);
+  if (descriptorIt != this->meshDescriptors.end())
+  {
+    this->meshHits++;
+    return &descriptorIt->second;
+  }
+
+  ignition::common::MeshManager* meshManager =
+      ignition::common::MeshManager::Instance();
+  if (!_load && !meshManager->HasMesh(_msg.filename()))
+    return nullptr;
+
+  rendering::MeshDescriptor descriptor;
+  descriptor.meshName = _msg.filename();
+  descriptor.mesh = meshManager->Load(descriptor.meshName);
+  if (!descriptor.mesh)
+    return nullptr;
+
+  descriptor.subMeshName = _msg.submesh();
+  descriptor.centerSubMesh = _msg.center_submesh();
+
+  this->meshMisses++;
+  return &(this->meshDescriptors[key] = descriptor);
+}
+
+/////////////////////////////////////////////////
+bool SceneManager::RequestMesh(const std::string &_name)
+{
+  // already requested by another visual
+  if (this->pendingMeshes.find(_name) != this->pendingMeshes.end())
+    return true;
+
+  if (!MeshLoaderPool::Supported(_name))
+    return false;
+
+  // the system paths are searched on the render thread, as the mesh
+  // manager does
+  std::string path = common::findFile(_name);
+  if (path.empty())
+    return false;
+
+  this->meshLoader.Request(_name, path);
+  this->pendingMeshes[_name];
+  return true;
+}
+
+/////////////////////////////////////////////////
+void SceneManager::UpdateMeshes()
+{
+  auto start = std::chrono::steady_clock::now();
+  const std::chrono::milliseconds budget(MESH_FRAME_BUDGET_MS);
+
+  // at least one mesh is swapped in per frame
+  MeshLoaderPool::Result result;
+  while (this->meshLoader.Pop(result))
+  {
+    auto pendingIt = this->pendingMeshes.find(result.name);
+    std::vector<PendingMesh> pending;
+    if (pendingIt != this->pendingMeshes.end())
+    {
+      pending = std::move(pendingIt->second);
+      this->pendingMeshes.erase(pendingIt);
+    }
+
+    ignition::common::MeshManager* meshManager =
+        ignition::common::MeshManager::Instance();
+
+    if (!result.mesh)
+    {
+      ignerr << "Failed to load mesh [" << result.name << "]" << std::endl;
+    }
+    else if (meshManager->HasMesh(result.name))
+    {
+      delete result.mesh;
+    }
+    else
+    {
+      // the mesh manager takes ownership
+      result.mesh->SetName(result.name);
+      meshManager->AddMesh(result.mesh);
+    }
+
+    for (auto const &visualMesh : pending)
+    {
+      auto visual = visualMesh.visual.lock();
+      if (!visual)
+        continue;
+
+      auto placeholder = visualMesh.placeholder.lock();
+      if (placeholder)
+      {
+        visual->RemoveGeometry(placeholder);
+        placeholder->Destroy();
+      }
+
+      auto descriptor = this->SharedMeshDescriptor(
+          visualMesh.msg.geometry().mesh(), false);
+      if (!descriptor)
+        continue;
+
+      rendering::GeometryPtr geom = this->scene->CreateMesh(*descriptor);
+      if (!geom)
+      {
+        ignerr << "Failed to load geometry for visual: "
+               << visualMesh.msg.name() << std::endl;
+        continue;
+      }
+      visual->AddGeometry(geom);
+      this->ApplyMaterial(geom, visualMesh.msg);
+    }
+
+    if (std::chrono::steady_clock::now() - start >= budget)
+      break;
+  }
+}
+
+/////////////////////////////////////////////////
+MeshLoaderPool::~MeshLoaderPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->stop = true;
+  }
+  this->condition.notify_all();
+
+  for (auto &thread : this->threads)
+    thread.join();
+
+  for (auto &result : this->results)
+    delete result.mesh;
+}
+
+/////////////////////////////////////////////////
+bool MeshLoaderPool::Supported(const std::string &_path)
+{
+  auto dot = _path.rfind('.');
+  if (dot == std::string::npos)
+    return false;
+
+  std::string extension = common::lowercase(_path.substr(dot + 1));
+  return extension == "dae" || extension == "stl" || extension == "obj";
+}
+
+/////////////////////////////////////////////////
+void MeshLoaderPool::Request(const std::string &_name,
+                             const std::string &_path)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->requests.emplace_back(_name, _path);
+
+    if (this->threads.empty())
+    {
+      unsigned int count = std::max(1u, std::min(MAX_MESH_THREADS,
+          std::thread::hardware_concurrency() / 2));
+      for (unsigned int i = 0; i < count; ++i)
+        this->threads.emplace_back(&MeshLoaderPool::Run, this);
+    }
+  }
+  this->condition.notify_one();
+}
+
+/////////////////////////////////////////////////
+bool MeshLoaderPool::Pop(Result &_result)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (this->results.empty())
+    return false;
+
+  _result = this->results.front();
+  this->results.pop_front();
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool MeshLoaderPool::Ready()
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return !this->results.empty();
+}
+
+/////////////////////////////////////////////////
+void MeshLoaderPool::Run()
+{
+  // loaders aren't shared between threads
+  common::ColladaLoader colladaLoader;
+  common::STLLoader stlLoader;
+  common::OBJLoader objLoader;
+
+  while (true)
+  {
+    std::pair<std::string, std::string> request;
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      this->condition.wait(lock, [this]
+          {
+            return this->stop || !this->requests.empty();
+          });
+      if (this->stop)
+        return;
+
+      request = std::move(this->requests.front());
+      this->requests.pop_front();
+    }
+
+    std::string extension = common::lowercase(
+        request.second.substr(request.second.rfind('.') + 1));
+    common::MeshLoader *loader = &colladaLoader;
+    if (extension == "stl")
+      loader = &stlLoader;
+    else if (extension == "obj")
+      loader = &objLoader;
+
+    Result result;
+    result.name = request.first;
+    result.mesh = loader->Load(request.second);
+
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->results.push_back(std::move(result));
+    }
+
+    if (this->onLoaded)
+      this->onLoaded();
   }
 }
 
@@ -894,14 +2066,27 @@ void IgnRenderer::Render()
     this->textureDirty = false;
   }
 
+  auto start = std::chrono::steady_clock::now();
+
   // update the scene
   this->dataPtr->sceneManager.Update();
+  auto sceneUpdated = std::chrono::steady_clock::now();
 
   // view control
   this->HandleMouseEvent();
+  auto inputHandled = std::chrono::steady_clock::now();
 
   // update and render to texture
   this->dataPtr->camera->Update();
+  auto end = std::chrono::steady_clock::now();
+
+  using Milliseconds = std::chrono::duration<double, std::milli>;
+  this->dataPtr->stats.AddFrame(
+      Milliseconds(sceneUpdated - start).count(),
+      Milliseconds(inputHandled - sceneUpdated).count(),
+      Milliseconds(end - inputHandled).count(),
+      this->dataPtr->sceneManager.LastUpdateStats());
+  this->PublishStats();
 
   if (ignition::gui::App())
   {
@@ -984,22 +2169,25 @@ void IgnRenderer::HandleKeyPress(QKeyEvent *_e)
   if (_e->isAutoRepeat())
     return;
 
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-
-  this->dataPtr->keyEvent.SetKey(_e->key());
-  this->dataPtr->keyEvent.SetText(_e->text().toStdString());
-
-  this->dataPtr->keyEvent.SetControl(
-    (_e->modifiers() & Qt::ControlModifier));
-  this->dataPtr->keyEvent.SetShift(
-    (_e->modifiers() & Qt::ShiftModifier));
-  this->dataPtr->keyEvent.SetAlt(
-    (_e->modifiers() & Qt::AltModifier));
-
-  this->dataPtr->mouseEvent.SetControl(this->dataPtr->keyEvent.Control());
-  this->dataPtr->mouseEvent.SetShift(this->dataPtr->keyEvent.Shift());
-  this->dataPtr->mouseEvent.SetAlt(this->dataPtr->keyEvent.Alt());
-  this->dataPtr->keyEvent.SetType(common::KeyEvent::PRESS);
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+    this->dataPtr->keyEvent.SetKey(_e->key());
+    this->dataPtr->keyEvent.SetText(_e->text().toStdString());
+
+    this->dataPtr->keyEvent.SetControl(
+      (_e->modifiers() & Qt::ControlModifier));
+    this->dataPtr->keyEvent.SetShift(
+      (_e->modifiers() & Qt::ShiftModifier));
+    this->dataPtr->keyEvent.SetAlt(
+      (_e->modifiers() & Qt::AltModifier));
+
+    this->dataPtr->mouseEvent.SetControl(this->dataPtr->keyEvent.Control());
+    this->dataPtr->mouseEvent.SetShift(this->dataPtr->keyEvent.Shift());
+    this->dataPtr->mouseEvent.SetAlt(this->dataPtr->keyEvent.Alt());
+    this->dataPtr->keyEvent.SetType(common::KeyEvent::PRESS);
+  }
+  this->RequestRender();
 }
 
 ////////////////////////////////////////////////
@@ -1008,24 +2196,27 @@ void IgnRenderer::HandleKeyRelease(QKeyEvent *_e)
   if (_e->isAutoRepeat())
     return;
 
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-
-  this->dataPtr->keyEvent.SetKey(0);
-
-  this->dataPtr->keyEvent.SetControl(
-    (_e->modifiers() & Qt::ControlModifier)
-    && (_e->key() != Qt::Key_Control));
-  this->dataPtr->keyEvent.SetShift(
-    (_e->modifiers() & Qt::ShiftModifier)
-    && (_e->key() != Qt::Key_Shift));
-  this->dataPtr->keyEvent.SetAlt(
-    (_e->modifiers() & Qt::AltModifier)
-    && (_e->key() != Qt::Key_Alt));
-
-  this->dataPtr->mouseEvent.SetControl(this->dataPtr->keyEvent.Control());
-  this->dataPtr->mouseEvent.SetShift(this->dataPtr->keyEvent.Shift());
-  this->dataPtr->mouseEvent.SetAlt(this->dataPtr->keyEvent.Alt());
-  this->dataPtr->keyEvent.SetType(common::KeyEvent::RELEASE);
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+    this->dataPtr->keyEvent.SetKey(0);
+
+    this->dataPtr->keyEvent.SetControl(
+      (_e->modifiers() & Qt::ControlModifier)
+      && (_e->key() != Qt::Key_Control));
+    this->dataPtr->keyEvent.SetShift(
+      (_e->modifiers() & Qt::ShiftModifier)
+      && (_e->key() != Qt::Key_Shift));
+    this->dataPtr->keyEvent.SetAlt(
+      (_e->modifiers() & Qt::AltModifier)
+      && (_e->key() != Qt::Key_Alt));
+
+    this->dataPtr->mouseEvent.SetControl(this->dataPtr->keyEvent.Control());
+    this->dataPtr->mouseEvent.SetShift(this->dataPtr->keyEvent.Shift());
+    this->dataPtr->mouseEvent.SetAlt(this->dataPtr->keyEvent.Alt());
+    this->dataPtr->keyEvent.SetType(common::KeyEvent::RELEASE);
+  }
+  this->RequestRender();
 }
 
 /////////////////////////////////////////////////
@@ -1034,6 +2225,10 @@ void IgnRenderer::BroadcastHoverPos()
   if (!this->dataPtr->hoverDirty)
     return;
 
+  // the hover events received since the last frame are coalesced into a
+  // single query for the latest position
+  this->dataPtr->hoverDirty = false;
+
   auto pos = this->ScreenToScene(this->dataPtr->mouseHoverPos);
 
   events::HoverToScene hoverToSceneEvent(pos);
@@ -1119,7 +2314,8 @@ void IgnRenderer::Initialize()
   this->dataPtr->camera->PreRender();
   this->textureId = this->dataPtr->camera->RenderTextureGLId();
 
-  // Make service call to populate scene
+  // Start acquiring the scene, which is populated by the following updates
+  // once the service is available
   if (!this->sceneService.empty())
   {
     this->dataPtr->sceneManager.Load(this->sceneService, this->poseTopic,
@@ -1131,6 +2327,17 @@ void IgnRenderer::Initialize()
   // Ray Query
   this->dataPtr->rayQuery = this->dataPtr->camera->Scene()->CreateRayQuery();
 
+  if (!this->statsTopic.empty())
+  {
+    this->dataPtr->statsPub =
+        this->dataPtr->node.Advertise<msgs::Param>(this->statsTopic);
+    if (!this->dataPtr->statsPub)
+    {
+      ignerr << "Error advertising stats topic [" << this->statsTopic << "]"
+             << std::endl;
+    }
+  }
+
   this->initialized = true;
 }
 
@@ -1158,19 +2365,105 @@ void IgnRenderer::Destroy()
 /////////////////////////////////////////////////
 void IgnRenderer::NewHoverEvent(const math::Vector2i &_hoverPos)
 {
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-  this->dataPtr->mouseHoverPos = _hoverPos;
-  this->dataPtr->hoverDirty = true;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (_hoverPos == this->dataPtr->mouseHoverPos)
+      return;
+    this->dataPtr->mouseHoverPos = _hoverPos;
+    this->dataPtr->hoverDirty = true;
+  }
+  this->RequestRender();
 }
 
 /////////////////////////////////////////////////
 void IgnRenderer::NewMouseEvent(const common::MouseEvent &_e,
     const math::Vector2d &_drag)
 {
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-  this->dataPtr->mouseEvent = _e;
-  this->dataPtr->drag += _drag;
-  this->dataPtr->mouseDirty = true;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->mouseEvent = _e;
+    this->dataPtr->drag += _drag;
+    this->dataPtr->mouseDirty = true;
+  }
+  this->RequestRender();
+}
+
+/////////////////////////////////////////////////
+void IgnRenderer::SetRenderRequestCallback(
+    const std::function<void()> &_callback)
+{
+  this->dataPtr->renderRequest = _callback;
+  this->dataPtr->sceneManager.SetChangeCallback(_callback);
+}
+
+/////////////////////////////////////////////////
+void IgnRenderer::RequestRender()
+{
+  if (this->dataPtr->renderRequest)
+    this->dataPtr->renderRequest();
+}
+
+/////////////////////////////////////////////////
+std::chrono::steady_clock::time_point IgnRenderer::NextUpdate()
+{
+  return this->dataPtr->sceneManager.NextUpdate();
+}
+
+/////////////////////////////////////////////////
+RenderStats IgnRenderer::Stats() const
+{
+  return this->dataPtr->stats.Stats();
+}
+
+/////////////////////////////////////////////////
+void IgnRenderer::RecordTextureHandoff(double _ms)
+{
+  this->dataPtr->stats.AddTextureHandoff(_ms);
+}
+
+/////////////////////////////////////////////////
+void IgnRenderer::PublishStats()
+{
+  if (!this->dataPtr->statsPub)
+    return;
+
+  auto now = std::chrono::steady_clock::now();
+  if (now < this->dataPtr->nextStatsPublish)
+    return;
+  this->dataPtr->nextStatsPublish =
+      now + std::chrono::milliseconds(STATS_PUBLISH_MS);
+
+  auto stats = this->Stats();
+  msgs::Param msg;
+  auto params = msg.mutable_params();
+  auto addStat = [params](const std::string &_name, const RenderStat &_stat)
+  {
+    const std::pair<const char *, double> values[] = {
+        {"p50", _stat.p50}, {"p90", _stat.p90}, {"p99", _stat.p99},
+        {"max", _stat.max}};
+    for (const auto &value : values)
+    {
+      msgs::Any any;
+      any.set_type(msgs::Any::DOUBLE);
+      any.set_double_value(value.second);
+      (*params)[_name + "/" + value.first] = any;
+    }
+  };
+  addStat("frame_ms", stats.frame);
+  addStat("scene_update_ms", stats.sceneUpdate);
+  addStat("input_ms", stats.input);
+  addStat("camera_update_ms", stats.cameraUpdate);
+  addStat("texture_handoff_ms", stats.textureHandoff);
+  addStat("poses_applied", stats.posesApplied);
+  addStat("scene_msgs", stats.sceneMsgs);
+  addStat("pose_latency_ms", stats.poseLatency);
+
+  msgs::Any frames;
+  frames.set_type(msgs::Any::DOUBLE);
+  frames.set_double_value(static_cast<double>(stats.frames));
+  (*params)["frames"] = frames;
+
+  this->dataPtr->statsPub.Publish(msg);
 }
 
 /////////////////////////////////////////////////
@@ -1201,6 +2494,11 @@ math::Vector3d IgnRenderer::ScreenToScene(
 RenderThread::RenderThread()
 {
   RenderWindowItemPrivate::threads << this;
+
+  this->ignRenderer.SetRenderRequestCallback([this]
+      {
+        this->RequestRender();
+      });
 }
 
 /////////////////////////////////////////////////
@@ -1221,6 +2519,22 @@ void RenderThread::RenderNext()
     return;
   }
 
+  // wait until the scene changes or a frame is requested
+  if (this->renderOnDemand)
+  {
+    std::lock_guard<std::mutex> lock(this->renderMutex);
+    if (!this->renderDirty)
+    {
+      this->renderWaiting = true;
+      this->ScheduleHeartbeat();
+      return;
+    }
+    this->renderDirty = false;
+
+    if (this->heartbeat)
+      this->heartbeat->stop();
+  }
+
   this->ignRenderer.Render();
 
   emit TextureReady(this->ignRenderer.textureId, this->ignRenderer.textureSize);
@@ -1259,6 +2573,57 @@ void RenderThread::SizeChanged()
 
   this->ignRenderer.textureSize = QSize(item->width(), item->height());
   this->ignRenderer.textureDirty = true;
+  this->RequestRender();
+}
+
+/////////////////////////////////////////////////
+void RenderThread::RequestRender()
+{
+  std::lock_guard<std::mutex> lock(this->renderMutex);
+  this->renderDirty = true;
+
+  // the next frame is already scheduled unless waiting
+  if (!this->renderWaiting)
+    return;
+
+  this->renderWaiting = false;
+  QMetaObject::invokeMethod(this, "RenderNext", Qt::QueuedConnection);
+}
+
+/////////////////////////////////////////////////
+void RenderThread::ScheduleHeartbeat()
+{
+  auto now = std::chrono::steady_clock::now();
+  auto next = this->ignRenderer.NextUpdate();
+  double minFrameRate = this->minFrameRate;
+  if (minFrameRate > 0)
+  {
+    next = std::min(next, now +
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / minFrameRate)));
+  }
+
+  if (!this->heartbeat)
+  {
+    // created on the render thread, which the timer runs on
+    this->heartbeat = new QTimer(this);
+    this->heartbeat->setSingleShot(true);
+    this->connect(this->heartbeat, &QTimer::timeout, this, [this]
+        {
+          this->RequestRender();
+        });
+  }
+
+  if (next == std::chrono::steady_clock::time_point::max())
+  {
+    this->heartbeat->stop();
+    return;
+  }
+
+  auto delay = std::chrono::duration_cast<std::chrono::milliseconds>(
+      next - now).count();
+  this->heartbeat->start(static_cast<int>(std::max<decltype(delay)>(0,
+      std::min<decltype(delay)>(delay, std::numeric_limits<int>::max()))));
 }
 
 /////////////////////////////////////////////////
@@ -1289,6 +2654,7 @@ void TextureNode::NewTexture(int _id, const QSize &_size)
   this->mutex.lock();
   this->id = _id;
   this->size = _size;
+  this->readyTime = std::chrono::steady_clock::now();
   this->mutex.unlock();
 
   // We cannot call QQuickWindow::update directly here, as this is only allowed
@@ -1302,10 +2668,18 @@ void TextureNode::PrepareNode()
   this->mutex.lock();
   int newId = this->id;
   QSize sz = this->size;
+  auto ready = this->readyTime;
   this->id = 0;
   this->mutex.unlock();
   if (newId)
   {
+    if (this->renderer)
+    {
+      this->renderer->RecordTextureHandoff(
+          std::chrono::duration<double, std::milli>(
+          std::chrono::steady_clock::now() - ready).count());
+    }
+
     delete this->texture;
     // note: include QQuickWindow::TextureHasAlphaChannel if the rendered
     // content has alpha.
@@ -1406,6 +2780,7 @@ QSGNode *RenderWindowItem::updatePaintNode(QSGNode *_node,
   if (!node)
   {
     node = new TextureNode(this->window());
+    node->renderer = &this->dataPtr->renderThread->ignRenderer;
 
     // Set up connections to get the production of render texture in sync with
     // vsync on the rendering thread.
@@ -1497,6 +2872,36 @@ void RenderWindowItem::SetSceneTopic(const std::string &_topic)
   this->dataPtr->renderThread->ignRenderer.sceneTopic = _topic;
 }
 
+/////////////////////////////////////////////////
+void RenderWindowItem::SetRenderOnDemand(bool _onDemand)
+{
+  this->dataPtr->renderThread->renderOnDemand = _onDemand;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetMinFrameRate(double _rate)
+{
+  this->dataPtr->renderThread->minFrameRate = _rate;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::RequestRender()
+{
+  this->dataPtr->renderThread->RequestRender();
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetStatsTopic(const std::string &_topic)
+{
+  this->dataPtr->renderThread->ignRenderer.statsTopic = _topic;
+}
+
+/////////////////////////////////////////////////
+RenderStats RenderWindowItem::Stats() const
+{
+  return this->dataPtr->renderThread->ignRenderer.Stats();
+}
+
 /////////////////////////////////////////////////
 Scene3D::Scene3D()
   : Plugin(), dataPtr(new Scene3DPrivate)
@@ -1521,6 +2926,7 @@ void Scene3D::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
            << "Render window will not be created" << std::endl;
     return;
   }
+  this->dataPtr->renderWindow = renderWindow;
 
   if (this->title.empty())
     this->title = "3D Scene";
@@ -1600,6 +3006,29 @@ void Scene3D::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
       std::string topic = elem->GetText();
       renderWindow->SetSceneTopic(topic);
     }
+
+    elem = _pluginElem->FirstChildElement("render_on_demand");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      bool onDemand = false;
+      elem->QueryBoolText(&onDemand);
+      renderWindow->SetRenderOnDemand(onDemand);
+    }
+
+    elem = _pluginElem->FirstChildElement("min_frame_rate");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      double rate = 0;
+      elem->QueryDoubleText(&rate);
+      renderWindow->SetMinFrameRate(rate);
+    }
+
+    elem = _pluginElem->FirstChildElement("stats_topic");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      std::string topic = elem->GetText();
+      renderWindow->SetStatsTopic(topic);
+    }
   }
 }
 
@@ -1674,21 +3103,20 @@ void RenderWindowItem::HandleKeyRelease(QKeyEvent *_e)
 /////////////////////////////////////////////////
 bool Scene3D::eventFilter(QObject *_obj, QEvent *_event)
 {
+  RenderWindowItem *renderWindow = this->dataPtr->renderWindow;
   if (_event->type() == QEvent::KeyPress)
   {
     QKeyEvent *keyEvent = static_cast<QKeyEvent*>(_event);
-    if (keyEvent)
+    if (keyEvent && renderWindow)
     {
-      auto renderWindow = this->PluginItem()->findChild<RenderWindowItem *>();
       renderWindow->HandleKeyPress(keyEvent);
     }
   }
   else if (_event->type() == QEvent::KeyRelease)
   {
     QKeyEvent *keyEvent = static_cast<QKeyEvent*>(_event);
-    if (keyEvent)
+    if (keyEvent && renderWindow)
     {
-      auto renderWindow = this->PluginItem()->findChild<RenderWindowItem *>();
       renderWindow->HandleKeyRelease(keyEvent);
     }
   }
@@ -1700,15 +3128,34 @@ bool Scene3D::eventFilter(QObject *_obj, QEvent *_event)
 /////////////////////////////////////////////////
 void Scene3D::OnHovered(int _mouseX, int _mouseY)
 {
-  auto renderWindow = this->PluginItem()->findChild<RenderWindowItem *>();
-  renderWindow->OnHovered({_mouseX, _mouseY});
+  RenderWindowItem *renderWindow = this->dataPtr->renderWindow;
+  if (renderWindow)
+    renderWindow->OnHovered({_mouseX, _mouseY});
 }
 
 /////////////////////////////////////////////////
 void Scene3D::OnFocusWindow()
 {
-  auto renderWindow = this->PluginItem()->findChild<RenderWindowItem *>();
-  renderWindow->forceActiveFocus();
+  RenderWindowItem *renderWindow = this->dataPtr->renderWindow;
+  if (renderWindow)
+    renderWindow->forceActiveFocus();
+}
+
+/////////////////////////////////////////////////
+void Scene3D::RequestRender()
+{
+  RenderWindowItem *renderWindow = this->dataPtr->renderWindow;
+  if (renderWindow)
+    renderWindow->RequestRender();
+}
+
+/////////////////////////////////////////////////
+RenderStats Scene3D::Stats() const
+{
+  RenderWindowItem *renderWindow = this->dataPtr->renderWindow;
+  if (!renderWindow)
+    return RenderStats();
+  return renderWindow->Stats();
 }
 
 // Register this plugin
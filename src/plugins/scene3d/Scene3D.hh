@@ -18,6 +18,11 @@
 #ifndef IGNITION_GUI_PLUGINS_SCENE3D_HH_
 #define IGNITION_GUI_PLUGINS_SCENE3D_HH_
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <memory>
 #include <mutex>
@@ -42,6 +47,61 @@ namespace plugins
   class RenderWindowItemPrivate;
   class Scene3DPrivate;
 
+  /// \brief Rolling percentiles of a render loop measurement over the last
+  /// frames
+  class RenderStat
+  {
+    /// \brief Number of samples the percentiles are computed from
+    public: std::size_t count = 0;
+
+    /// \brief Median
+    public: double p50 = 0;
+
+    /// \brief 90th percentile
+    public: double p90 = 0;
+
+    /// \brief 99th percentile
+    public: double p99 = 0;
+
+    /// \brief Maximum
+    public: double max = 0;
+  };
+
+  /// \brief Render loop statistics over the last frames. Durations are in
+  /// milliseconds.
+  class RenderStats
+  {
+    /// \brief Duration of a whole frame update, from the scene update to
+    /// the camera update
+    public: RenderStat frame;
+
+    /// \brief Duration of the scene manager update
+    public: RenderStat sceneUpdate;
+
+    /// \brief Duration of the mouse event handling
+    public: RenderStat input;
+
+    /// \brief Duration of the camera update, which renders to the texture
+    public: RenderStat cameraUpdate;
+
+    /// \brief Time from a texture being ready to it being used by the Qt
+    /// scene graph
+    public: RenderStat textureHandoff;
+
+    /// \brief Number of entity poses applied per frame
+    public: RenderStat posesApplied;
+
+    /// \brief Number of scene msgs pending at each frame
+    public: RenderStat sceneMsgs;
+
+    /// \brief Time from receiving the oldest pose msg applied in a frame to
+    /// applying it, for the frames applying poses
+    public: RenderStat poseLatency;
+
+    /// \brief Number of frames rendered
+    public: std::uint64_t frames = 0;
+  };
+
   /// \brief Creates a new ignition rendering scene or adds a user-camera to an
   /// existing scene. It is possible to orbit the camera around the scene with
   /// the mouse. Use other plugins to manage objects in the scene.
@@ -58,6 +118,16 @@ namespace plugins
   ///                          (0.3, 0.3, 0.3, 1.0)
   /// * \<camera_pose\> : Optional starting pose for the camera, defaults to
   ///                     (0, 0, 5, 0, 0, 0)
+  /// * \<render_on_demand\> : Optional, true to render a frame only when the
+  ///                          scene changes, on user input, on resize or on
+  ///                          request, instead of continuously. Defaults to
+  ///                          false.
+  /// * \<min_frame_rate\> : Optional minimum frame rate in Hz when rendering
+  ///                        on demand, for plugins relying on the render
+  ///                        events. Defaults to 0, no minimum.
+  /// * \<stats_topic\> : Optional topic to publish render loop statistics
+  ///                     to once per second, as percentiles over the last
+  ///                     frames. Not published by default.
   class Scene3D : public Plugin
   {
     Q_OBJECT
@@ -77,6 +147,15 @@ namespace plugins
     /// focus the window for mouse/key events
     public slots: void OnFocusWindow();
 
+    /// \brief Get the render loop statistics over the last frames.
+    /// Can be called from any thread.
+    /// \return Render loop statistics
+    public: RenderStats Stats() const;
+
+    /// \brief Request a new frame when rendering on demand, e.g. after
+    /// changing the scene from another plugin
+    public slots: void RequestRender();
+
     // Documentation inherited
     protected: bool eventFilter(QObject *_obj, QEvent *_event) override;
 
@@ -130,6 +209,34 @@ namespace plugins
     /// \param[in] _e The key event to process.
     public: void HandleKeyRelease(QKeyEvent *_e);
 
+    /// \brief Set the function called when the renderer needs a new frame,
+    /// from any thread. Should be set before initializing the renderer.
+    /// \param[in] _callback Function requesting a frame
+    public: void SetRenderRequestCallback(
+        const std::function<void()> &_callback);
+
+    /// \brief Request a new frame through the render request callback
+    public: void RequestRender();
+
+    /// \brief Get the time at which the scene needs an update even if
+    /// nothing changes, e.g. to poll the scene service
+    /// \return Time of the next update, time_point::max() if none
+    public: std::chrono::steady_clock::time_point NextUpdate();
+
+    /// \brief Get the render loop statistics over the last frames.
+    /// Can be called from any thread.
+    /// \return Render loop statistics
+    public: RenderStats Stats() const;
+
+    /// \brief Record the time a texture took to be used by the Qt scene
+    /// graph. Can be called from any thread.
+    /// \param[in] _ms Handoff time in milliseconds
+    public: void RecordTextureHandoff(double _ms);
+
+    /// \brief Publish the statistics on the stats topic, at most once per
+    /// second
+    private: void PublishStats();
+
     /// \brief Handle mouse event for view control
     private: void HandleMouseEvent();
 
@@ -196,6 +303,10 @@ namespace plugins
     /// added
     public: std::string sceneTopic;
 
+    /// \brief Ign-transport topic to publish the render loop statistics
+    /// to, none if empty
+    public: std::string statsTopic;
+
     /// \internal
     /// \brief Pointer to private data.
     private: std::unique_ptr<IgnRendererPrivate> dataPtr;
@@ -218,6 +329,14 @@ namespace plugins
     /// \brief Slot called to update render texture size
     public slots: void SizeChanged();
 
+    /// \brief Request a new frame when rendering on demand. Can be called
+    /// from any thread.
+    public: void RequestRender();
+
+    /// \brief Wait for the next frame request, waking up in time for the
+    /// next scene update or the minimum frame rate
+    private: void ScheduleHeartbeat();
+
     /// \brief Signal to indicate that a frame has been rendered and ready
     /// to be displayed
     /// \param[in] _id GLuid of the opengl texture
@@ -232,6 +351,26 @@ namespace plugins
 
     /// \brief Ign-rendering renderer
     public: IgnRenderer ignRenderer;
+
+    /// \brief True to render only the frames requested, instead of a frame
+    /// each time the previous one is displayed. Set by the GUI thread.
+    public: std::atomic<bool> renderOnDemand{false};
+
+    /// \brief Minimum frame rate in Hz when rendering on demand, 0 for none.
+    /// Set by the GUI thread.
+    public: std::atomic<double> minFrameRate{0};
+
+    /// \brief Protects the frame request flags
+    private: std::mutex renderMutex;
+
+    /// \brief True if a frame is requested
+    private: bool renderDirty = true;
+
+    /// \brief True while waiting for a frame request
+    private: bool renderWaiting = false;
+
+    /// \brief Timer waking up the render thread without frame requests
+    private: QTimer *heartbeat = nullptr;
   };
 
 
@@ -290,6 +429,26 @@ namespace plugins
     /// \param[in] _topic Scene topic
     public: void SetSceneTopic(const std::string &_topic);
 
+    /// \brief Set whether to render only when needed
+    /// \param[in] _onDemand True to render on demand, false to render
+    /// continuously
+    public: void SetRenderOnDemand(bool _onDemand);
+
+    /// \brief Set the minimum frame rate when rendering on demand
+    /// \param[in] _rate Frame rate in Hz, 0 for none
+    public: void SetMinFrameRate(double _rate);
+
+    /// \brief Request a new frame when rendering on demand
+    public: void RequestRender();
+
+    /// \brief Set the topic to publish the render loop statistics to
+    /// \param[in] _topic Stats topic, empty for none
+    public: void SetStatsTopic(const std::string &_topic);
+
+    /// \brief Get the render loop statistics over the last frames
+    /// \return Render loop statistics
+    public: RenderStats Stats() const;
+
     /// \brief Called when the mouse hovers to a new position.
     /// \param[in] _hoverPos 2D coordinates of the hovered mouse position on
     /// the render window.
@@ -376,6 +535,13 @@ namespace plugins
 
     /// \brief Qt quick window
     public: QQuickWindow *window = nullptr;
+
+    /// \brief Renderer producing the textures, to record the texture
+    /// handoff time
+    public: IgnRenderer *renderer = nullptr;
+
+    /// \brief Time the pending texture became ready, protected by the mutex
+    public: std::chrono::steady_clock::time_point readyTime;
   };
 }
 }
@@ -259,17 +259,37 @@ void TopicViewerPrivate::AddField(QStandardItem *_parentItem,
   {
     auto msgField = msgDescriptor->field(i);
 
+    // repeated fields are plotted per element, with a series for each
+    auto fieldName = msgField->name();
     if (msgField->is_repeated())
-      continue;
+    {
+      if (msgField->is_map())
+        continue;
+      fieldName += "[*]";
+    }
 
     auto messageType = msgField->message_type();
 
     if (messageType)
-      this->AddField(msgItem, msgField->name(), messageType->name());
+    {
+      // skip recursive messages, which would expand forever
+      bool recursive = false;
+      for (auto item = msgItem; item; item = item->parent())
+      {
+        if (item->data(TYPE_ROLE).toString().toStdString() ==
+            messageType->name())
+        {
+          recursive = true;
+          break;
+        }
+      }
 
+      if (!recursive)
+        this->AddField(msgItem, fieldName, messageType->name());
+    }
     else
     {
-      auto msgFieldItem = this->FactoryItem(msgField->name(),
+      auto msgFieldItem = this->FactoryItem(fieldName,
                                             msgField->type_name());
       msgItem->appendRow(msgFieldItem);
 
@@ -143,7 +143,7 @@ TEST(TopicViewerTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Model))
             foundCollision = true;
 
             EXPECT_EQ(child->data(TYPE_ROLE), "ignition.msgs.Collision");
-            EXPECT_EQ(child->rowCount(), 8);
+            EXPECT_EQ(child->rowCount(), 9);
 
             auto pose = child->child(5);
             auto position = pose->child(3);
@@ -154,6 +154,20 @@ TEST(TopicViewerTest, IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Model))
             EXPECT_EQ(x->data(PATH_ROLE), "pose-position-x");
             EXPECT_EQ(x->data(TOPIC_ROLE), "/collision_topic");
             EXPECT_TRUE(x->data(PLOT_ROLE).toBool());
+
+            // repeated fields are listed with a wildcard
+            auto visual = child->child(8);
+            EXPECT_EQ(visual->data(NAME_ROLE), "visual[*]");
+
+            auto visualPose = visual->child(0);
+            for (int j = 0; j < visual->rowCount(); ++j)
+            {
+              if (visual->child(j)->data(NAME_ROLE) == "pose")
+                visualPose = visual->child(j);
+            }
+            auto visualX = visualPose->child(3)->child(1);
+            EXPECT_EQ(visualX->data(PATH_ROLE), "visual[*]-pose-position-x");
+            EXPECT_TRUE(visualX->data(PLOT_ROLE).toBool());
         }
         else if (child->data(NAME_ROLE) == "/int_topic")
         {
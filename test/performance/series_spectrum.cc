@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "ignition/gui/SeriesSpectrum.hh"
+
+using namespace ignition;
+using namespace gui;
+
+/////////////////////////////////////////////////
+/// \brief Throughput of the spectrum of windows of 4k to 1M samples, as
+/// computed by the spectrum panel of the plotting plugin
+TEST(SeriesSpectrumPerformance, Throughput)
+{
+  const double pi = std::acos(-1.0);
+  const double rate = 1000;
+
+  std::vector<double> values(1 << 20);
+  for (std::size_t i = 0; i < values.size(); ++i)
+  {
+    values[i] = std::sin(2 * pi * 50 * i / rate) +
+                0.5 * std::sin(2 * pi * 120 * i / rate);
+  }
+
+  for (std::size_t segment : {1024u, 8192u})
+  {
+    SeriesSpectrum spectrum(segment);
+    std::vector<double> frequencies;
+    std::vector<double> power;
+
+    for (std::size_t window = 1 << 12; window <= values.size(); window <<= 2)
+    {
+      // the tables are computed on the first run
+      std::size_t bins = std::min(segment, window) / 2 + 1;
+      ASSERT_EQ(spectrum.Compute(values.data(), window, rate, frequencies,
+                                 power), bins);
+
+      int runs = 0;
+      auto start = std::chrono::steady_clock::now();
+      std::chrono::duration<double> elapsed{0};
+      while (runs < 3 || elapsed.count() < 0.2)
+      {
+        spectrum.Compute(values.data(), window, rate, frequencies, power);
+        runs++;
+        elapsed = std::chrono::steady_clock::now() - start;
+      }
+
+      double seconds = elapsed.count() / runs;
+      std::cout << "segment " << segment << ", window " << window
+                << ": " << seconds * 1e3 << " ms, "
+                << window / seconds / 1e6 << " Msamples/s" << std::endl;
+    }
+  }
+}